@@ -28,6 +28,7 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 #include <unordered_set>
 #include <vector>
 #include <cstring>
@@ -49,10 +50,20 @@ namespace Diligent
 #endif
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+
+/// \remarks By default, all operations are serialized by a mutex. When thread caching is enabled, 
+///          every thread keeps a small cache (magazine) of free blocks and exchanges blocks with
+///          the lock-free global free list in batches, so that the mutex is only taken when a new page
+///          is created. Pages are then aligned by their size, and the page a block belongs to is found 
+///          by address arithmetic rather than by a hash map lookup.
 class FixedBlockMemoryAllocator : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    /// \param RawMemoryAllocator - allocator that is used to allocate memory pages
+    /// \param BlockSize          - size of one block, in bytes
+    /// \param NumBlocksInPage    - number of blocks in one memory page
+    /// \param ThreadCaching      - whether to use per-thread block caches and the lock-free global free list
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, bool ThreadCaching = false);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -69,6 +80,29 @@ private:
 
     void CreateNewPage();
 
+    // Per-thread cache of free blocks linked through pointers. Caches are owned by the 
+    // allocator and every cache slot is used by at most one thread at a time.
+    static constexpr size_t CacheLineSize = 64;
+    struct ThreadCache
+    {
+        void*  pHead     = nullptr;
+        Uint32 NumBlocks = 0;
+        // Keep caches of different threads in different cache lines. The cache array 
+        // itself is aligned by the cache line size.
+        Uint8  Padding[CacheLineSize - sizeof(void*) - sizeof(Uint32)];
+    };
+    static_assert(sizeof(ThreadCache) == CacheLineSize, "Thread cache must occupy exactly one cache line");
+
+    void* AllocateThreadCached();
+    void  FreeThreadCached(void* Ptr);
+    void  CreateAlignedPage();
+    void  RefillThreadCache(ThreadCache& Cache);
+    void  FlushThreadCache (ThreadCache& Cache, Uint32 NumBlocksToFlush);
+    void* PopGlobalBlock();
+    void  PushGlobalBlocks(Uint32 FirstBlockIndex, void* pLastBlock);
+    void* GetBlockAddress(Uint32 BlockIndex)const;
+    Uint32 GetBlockIndex(const void* pBlock)const;
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -221,6 +255,48 @@ private:
     IMemoryAllocator &m_RawMemoryAllocator;
     size_t m_BlockSize;
     Uint32 m_NumBlocksInPage;
+
+    // Thread-cached mode
+
+    static constexpr Uint32 InvalidBlockIndex   = 0xFFFFFFFF;
+    static constexpr Uint32 MaxThreadCaches     = 64;
+    static constexpr Uint32 ThreadCacheCapacity = 32;
+    static constexpr Uint32 PageTableChunkSize  = 256;
+    static constexpr Uint32 MaxPageTableChunks  = 256;
+    // Raw allocator does not support alignment, so aligned pages are carved out of larger raw 
+    // allocations. One page worth of memory per raw allocation is lost to the alignment.
+    static constexpr Uint32 AlignedPagesPerRawAllocation = 16;
+
+    // Header that is located at the beginning of every aligned page
+    struct AlignedPageHeader
+    {
+        void*  pRawMemory; // Pointer returned by the raw allocator if this is the first page carved out of it, null otherwise
+        Uint32 PageIndex;
+    };
+
+    const bool m_ThreadCaching;
+    size_t m_AlignedPageSize      = 0; // Power of two
+    size_t m_AlignedPageHeaderSize = 0;
+    Uint32 m_NumAlignedPages      = 0; // Protected by m_Mutex
+    // Unused aligned pages of the last raw allocation, protected by m_Mutex
+    Uint8* m_pNextAlignedPage     = nullptr;
+    Uint32 m_NumReservedAlignedPages = 0;
+    
+    // Aligned pages are addressed by a two-level table that never relocates, so 
+    // that block index to address translation does not require any synchronization
+    Uint8** m_PageTable[MaxPageTableChunks] = {};
+
+    ThreadCache* m_ThreadCaches = nullptr; // Aligned by the cache line size
+    void* m_pThreadCachesRawMemory = nullptr;
+
+    // Global free list of blocks. The head packs index of the first block (low 32 bits)
+    // and a tag that is incremented on every update to avoid the ABA problem (high 32 bits).
+    // Free blocks in the global list are linked through block indices.
+    std::atomic<Uint64> m_GlobalFreeListHead;
+
+#ifdef _DEBUG
+    std::atomic<Int32> m_dbgNumAllocatedBlocks;
+#endif
 };
 
 IMemoryAllocator& GetRawAllocator();
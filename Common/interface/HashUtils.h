@@ -27,10 +27,21 @@
 #include <memory>
 #include <cstring>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/Errors.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.h"
 
-#define LOG_HASH_CONFLICTS 1
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include <intrin.h>
+#endif
+
+#ifndef LOG_HASH_CONFLICTS
+#   ifdef _DEBUG
+#       define LOG_HASH_CONFLICTS 1
+#   else
+#       define LOG_HASH_CONFLICTS 0
+#   endif
+#endif
 
 namespace Diligent
 {
@@ -56,16 +67,124 @@ namespace Diligent
         return Seed;
     }
 
+    namespace HashUtilsInternal
+    {
+        // Reads of unaligned data that compile to single load instructions
+        inline Uint64 Read8(const Uint8* p){ Uint64 v; memcpy(&v, p, 8); return v; }
+        inline Uint64 Read4(const Uint8* p){ Uint32 v; memcpy(&v, p, 4); return v; }
+        inline Uint64 Read3(const Uint8* p, size_t Len)
+        {
+            return (Uint64{p[0]} << 16) | (Uint64{p[Len >> 1]} << 8) | p[Len - 1];
+        }
+
+        // Computes 128-bit product of A and B and returns low and high halves in A and B
+        inline void Multiply128(Uint64& A, Uint64& B)
+        {
+#if defined(__SIZEOF_INT128__)
+            auto r = static_cast<unsigned __int128>(A) * B;
+            A = static_cast<Uint64>(r);
+            B = static_cast<Uint64>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            A = _umul128(A, B, &B);
+#else
+            Uint64 ha = A >> 32, hb = B >> 32, la = static_cast<Uint32>(A), lb = static_cast<Uint32>(B);
+            Uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            Uint64 t  = rl + (rm0 << 32);
+            Uint64 c  = t < rl ? 1 : 0;
+            Uint64 lo = t + (rm1 << 32);
+            c += lo < t ? 1 : 0;
+            A = lo;
+            B = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+        }
+
+        inline Uint64 Mix(Uint64 A, Uint64 B)
+        {
+            Multiply128(A, B);
+            return A ^ B;
+        }
+    }
+
+    /// Computes 64-bit hash of a block of memory
+
+    /// The function is based on wyhash (https://github.com/wangyi-fudan/wyhash). The data is consumed
+    /// 8 bytes at a time by three independent multiply-xor lanes, so that the processor can overlap 
+    /// the multiplications. Short keys, which are the most common in practice, are handled with
+    /// at most four loads and no loop.
+    inline Uint64 ComputeHash64(const void* pData, size_t Len, Uint64 Seed = 0)
+    {
+        using namespace HashUtilsInternal;
+        static constexpr Uint64 P0 = 0xa0761d6478bd642full;
+        static constexpr Uint64 P1 = 0xe7037ed1a0b428dbull;
+        static constexpr Uint64 P2 = 0x8ebc6af09c88c6e3ull;
+        static constexpr Uint64 P3 = 0x589965cc75374cc3ull;
+
+        const auto* p = reinterpret_cast<const Uint8*>(pData);
+        Seed ^= Mix(Seed ^ P0, P1);
+        Uint64 a = 0, b = 0;
+        if (Len <= 16)
+        {
+            if (Len >= 4)
+            {
+                auto Shift = (Len >> 3) << 2;
+                a = (Read4(p) << 32) | Read4(p + Shift);
+                b = (Read4(p + Len - 4) << 32) | Read4(p + Len - 4 - Shift);
+            }
+            else if (Len > 0)
+            {
+                a = Read3(p, Len);
+            }
+        }
+        else
+        {
+            auto i = Len;
+            if (i > 48)
+            {
+                auto Seed1 = Seed;
+                auto Seed2 = Seed;
+                do
+                {
+                    Seed  = Mix(Read8(p)      ^ P1, Read8(p +  8) ^ Seed);
+                    Seed1 = Mix(Read8(p + 16) ^ P2, Read8(p + 24) ^ Seed1);
+                    Seed2 = Mix(Read8(p + 32) ^ P3, Read8(p + 40) ^ Seed2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                Seed ^= Seed1 ^ Seed2;
+            }
+            while (i > 16)
+            {
+                Seed = Mix(Read8(p) ^ P1, Read8(p + 8) ^ Seed);
+                p += 16;
+                i -= 16;
+            }
+            a = Read8(p + i - 16);
+            b = Read8(p + i - 8);
+        }
+        a ^= P1;
+        b ^= Seed;
+        Multiply128(a, b);
+        return Mix(a ^ P0 ^ Len, b ^ P1);
+    }
+
     template<typename CharType>
     struct CStringHash
     {
         size_t operator()( const CharType *str ) const
         {
-            // http://www.cse.yorku.ca/~oz/hash.html
-            std::size_t Seed = 0;
-            while( size_t Ch = *(str++) )
-                Seed = Seed * 65599 + Ch;
-            return Seed;
+            size_t Len = 0;
+            while( str[Len] != 0 )
+                ++Len;
+            return static_cast<size_t>( ComputeHash64( str, Len * sizeof(CharType) ) );
+        }
+    };
+
+    template<>
+    struct CStringHash<Char>
+    {
+        size_t operator()( const Char *str ) const
+        {
+            return static_cast<size_t>( ComputeHash64( str, strlen(str) ) );
         }
     };
 
@@ -88,10 +207,40 @@ namespace Diligent
         }
     };
     
+    /// Interned string (atom) returned by StringInterner
+
+    /// Strings interned by the same interner are pointer-equal if and only if 
+    /// they are equal, so atoms are compared in constant time. The hash of the
+    /// string is computed once, when the string is interned.
+    class InternedString
+    {
+    public:
+        InternedString() = default;
+
+        const Char* GetStr() const{ return m_Str; }
+        size_t     GetHash()const{ return m_Hash; }
+
+        bool operator == (const InternedString& RHS)const{ return m_Str == RHS.m_Str; }
+        bool operator != (const InternedString& RHS)const{ return m_Str != RHS.m_Str; }
+
+        explicit operator bool()const{ return m_Str != nullptr; }
+
+    private:
+        friend class StringInterner;
+        InternedString(const Char* Str, size_t Hash) :
+            m_Str (Str),
+            m_Hash(Hash)
+        {}
+
+        const Char* m_Str  = nullptr;
+        size_t      m_Hash = 0;
+    };
+
     /// This helper structure is intended to facilitate using strings as a 
     /// hash table key. It provides constructors that can make a copy of the
     /// source string or just keep pointer to it, which enables searching in 
-    /// the hash using raw const Char* pointers.
+    /// the hash using raw const Char* pointers. Keys created from interned 
+    /// strings are compared by pointer when both keys are interned.
     struct HashMapStringKey
     {
     public:
@@ -120,13 +269,24 @@ namespace Diligent
             MakeCopy( Str.c_str() );
         }
 
+        // Interned strings are never released, so the key does not need to make a copy
+        HashMapStringKey(const InternedString& Str) :
+            StrPtr( Str.GetStr() ),
+            Hash( Str.GetHash() ),
+            IsInterned( true )
+        {
+            VERIFY( StrPtr, "Interned string is null" );
+        }
+
         HashMapStringKey(HashMapStringKey &&Key) :
             StringBuff( std::move(Key.StringBuff) ),
             StrPtr( std::move(Key.StrPtr) ),
-            Hash(0)
+            Hash( Key.Hash ),
+            IsInterned( Key.IsInterned )
         {
             Key.StrPtr = nullptr;
             Key.Hash = 0;
+            Key.IsInterned = false;
         }
 
         // Disable copy constuctor and assignments. The struct is designed
@@ -140,6 +300,10 @@ namespace Diligent
         {
             if( StrPtr == RHS.StrPtr )
                 return true;
+
+            // Equal interned strings always share the same pointer
+            if( IsInterned && RHS.IsInterned )
+                return false;
             
             // Hash member might not have been initialized
             if( (Hash != 0 && RHS.Hash !=0 && Hash != RHS.Hash) || StrPtr == nullptr || RHS.StrPtr == nullptr )
@@ -167,6 +331,8 @@ namespace Diligent
 
         const Char* GetStr()const{ return StrPtr; }
 
+        bool IsInternedString()const{ return IsInterned; }
+
     private:
         void MakeCopy( const Char* Str )
         {
@@ -183,11 +349,21 @@ namespace Diligent
         std::unique_ptr< Char[] > StringBuff; // Must be declared first
         const Char* StrPtr;// Must be declared after StringBuff
         mutable size_t Hash;
+        bool IsInterned = false;
     };
 }
 
 namespace std
 {
+    template<>
+    struct hash<Diligent::InternedString>
+    {
+        size_t operator()( const Diligent::InternedString &Str ) const
+        {
+            return Str.GetHash();
+        }
+    };
+
     template<>
     struct hash<Diligent::HashMapStringKey>
     {
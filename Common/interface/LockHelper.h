@@ -28,27 +28,43 @@
 #include <condition_variable>
 #include <atomic>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Platforms/interface/Atomics.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.h"
 
 namespace ThreadingTools
 {
 
+/// Returns the slot index of the calling thread
+
+/// Every thread is assigned a process-wide index that is not used by any other running thread.
+/// The index is returned to the pool when the thread exits and is reused by the next thread,
+/// so indices stay small. Shared objects use the index to give every thread exclusive access 
+/// to its own element of a per-thread data array without locks.
+Diligent::Uint32 GetThreadSlot();
+
+/// Lock flag used by LockHelper
+
+/// The flag is a three-state word: unlocked, locked, and locked with parked waiters. 
+/// Uncontended lock and unlock are single atomic operations. A thread that fails to acquire the flag 
+/// spins for a bounded number of iterations with exponential backoff, and then parks until the 
+/// flag is released. On Linux and Android, threads are parked on a futex; on other platforms, on a 
+/// condition variable selected by the flag address.
 class LockFlag
 {
 public:
-    enum {LOCK_FLAG_UNLOCKED = 0, LOCK_FLAG_LOCKED = 1};
+    enum {LOCK_FLAG_UNLOCKED = 0, LOCK_FLAG_LOCKED = 1, LOCK_FLAG_LOCKED_WITH_WAITERS = 2};
     LockFlag(Atomics::Long InitFlag = LOCK_FLAG_UNLOCKED)
     {
-        //m_Flag.store(InitFlag);
-        m_Flag = InitFlag;
+        m_Flag.store(static_cast<int>(InitFlag));
     }
 
-    operator Atomics::Long()const{return m_Flag;}
+    operator Atomics::Long()const{return m_Flag.load() != LOCK_FLAG_UNLOCKED ? LOCK_FLAG_LOCKED : LOCK_FLAG_UNLOCKED;}
 
 private:
     friend class LockHelper;
-    Atomics::AtomicLong m_Flag;
+    // 32-bit flag is required by futex
+    std::atomic<int> m_Flag;
 };
    
 class LockHelper
@@ -85,9 +101,8 @@ public:
 
     static bool UnsafeTryLock(LockFlag &LockFlag)
     {
-        return Atomics::AtomicCompareExchange( LockFlag.m_Flag, 
-                                               static_cast<Atomics::Long>( LockFlag::LOCK_FLAG_LOCKED ), 
-                                               static_cast<Atomics::Long>( LockFlag::LOCK_FLAG_UNLOCKED) ) == LockFlag::LOCK_FLAG_UNLOCKED;
+        int Expected = LockFlag::LOCK_FLAG_UNLOCKED;
+        return LockFlag.m_Flag.compare_exchange_strong(Expected, LockFlag::LOCK_FLAG_LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
     }
 
     bool TryLock(LockFlag &LockFlag)
@@ -103,21 +118,22 @@ public:
     
     static void UnsafeLock(LockFlag &LockFlag)
     {
-        while( !UnsafeTryLock( LockFlag ) )
-            std::this_thread::yield();
+        if( !UnsafeTryLock( LockFlag ) )
+            LockContended( LockFlag );
     }
 
     void Lock(LockFlag &LockFlag)
     {
         VERIFY( m_pLockFlag == NULL, "Object already locked" );
-        // Wait for the flag to become unlocked and lock it
-        while( !TryLock( LockFlag ) )
-            std::this_thread::yield();
+        UnsafeLock( LockFlag );
+        m_pLockFlag = &LockFlag;
     }
 
     static void UnsafeUnlock(LockFlag &LockFlag)
     {
-        LockFlag.m_Flag = LockFlag::LOCK_FLAG_UNLOCKED;
+        // Only wake up a waiter if there is one
+        if( LockFlag.m_Flag.exchange(LockFlag::LOCK_FLAG_UNLOCKED, std::memory_order_release) == LockFlag::LOCK_FLAG_LOCKED_WITH_WAITERS )
+            WakeWaiter( LockFlag );
     }
 
     void Unlock()
@@ -128,6 +144,10 @@ public:
     }
 
 private:
+    // Slow paths are not inlined to keep lock and unlock small
+    static void LockContended(LockFlag &LockFlag);
+    static void WakeWaiter   (LockFlag &LockFlag);
+
     LockFlag *m_pLockFlag;
     LockHelper( const LockHelper &LockHelper );
     const LockHelper& operator = ( const LockHelper &LockHelper );
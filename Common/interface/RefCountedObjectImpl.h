@@ -26,6 +26,8 @@
 /// \file
 /// Implementation of the template base class for reference counting objects
 
+#include <atomic>
+
 #include "../../Primitives/interface/Object.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "../../Platforms/interface/Atomics.h"
@@ -42,24 +44,34 @@ class RefCountersImpl final : public IReferenceCounters
 public:
     inline virtual CounterValueType AddStrongRef()override final
     {
-        VERIFY( m_ObjectState == ObjectState::Alive, "Attempting to increment strong reference counter for a destroyed or not itialized object!" );
+        VERIFY( IsAlive(m_State.load(std::memory_order_relaxed)), "Attempting to increment strong reference counter for a destroyed or not itialized object!" );
         VERIFY( m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-        return Atomics::AtomicIncrement(m_lNumStrongReferences);
+        // The caller already owns a reference, so the object cannot be destroyed 
+        // concurrently and no ordering is required.
+        auto PrevState = m_State.fetch_add(StrongRefIncrement, std::memory_order_relaxed);
+        VERIFY( UnpackNumStrongRefs(PrevState) < StrongRefMask, "Strong reference counter overflow" );
+        return static_cast<CounterValueType>( UnpackNumStrongRefs(PrevState) + 1 );
     }
 
     template<class TPreObjectDestroy>
     inline CounterValueType ReleaseStrongRef(TPreObjectDestroy PreObjectDestroy)
     {
-        VERIFY( m_ObjectState == ObjectState::Alive, "Attempting to decrement strong reference counter for an object that is not alive" );
+        VERIFY( IsAlive(m_State.load(std::memory_order_relaxed)), "Attempting to decrement strong reference counter for an object that is not alive" );
         VERIFY( m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
 
-        // Decrement strong reference counter without acquiring the lock. 
-        auto RefCount = Atomics::AtomicDecrement(m_lNumStrongReferences);
-        VERIFY( RefCount >= 0, "Inconsistent call to ReleaseStrongRef()" );
+        // Release semantics make all writes to the object by this thread visible to the
+        // thread that destroys it, acquire semantics make writes by all other threads
+        // visible to this thread should it be the one to destroy the object.
+        auto PrevState = m_State.fetch_sub(StrongRefIncrement, std::memory_order_acq_rel);
+        VERIFY( UnpackNumStrongRefs(PrevState) > 0, "Inconsistent call to ReleaseStrongRef()" );
+        auto RefCount = static_cast<CounterValueType>( UnpackNumStrongRefs(PrevState) - 1 );
         if( RefCount == 0 )
         {
+            // GetObject() never increments a zero strong counter, so once it has dropped 
+            // to zero it stays there, and the thread that brought it to zero is the only 
+            // one that ever gets here.
             PreObjectDestroy();
-            TryDestroyObject();
+            DestroyObject();
         }
 
         return RefCount;
@@ -72,39 +84,46 @@ public:
 
     inline virtual CounterValueType AddWeakRef()override final
     {
-        return Atomics::AtomicIncrement(m_lNumWeakReferences);
+        auto PrevState = m_State.fetch_add(WeakRefIncrement, std::memory_order_relaxed);
+        VERIFY( UnpackNumWeakRefs(PrevState) < (WeakRefMask >> WeakRefShift), "Weak reference counter overflow" );
+        return static_cast<CounterValueType>( UnpackNumWeakRefs(PrevState) + 1 );
     }
 
     inline virtual CounterValueType ReleaseWeakRef()override final
     {
-        // The method must be serialized!
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-        // It is essentially important to check the number of weak references
-        // while holding the lock. Otherwise reference counters object
-        // may be destroyed twice if ReleaseStrongRef() is executed by other 
-        // thread.
-        auto NumWeakReferences = Atomics::AtomicDecrement(m_lNumWeakReferences);
-        VERIFY( NumWeakReferences >= 0, "Inconsistent call to ReleaseWeakRef()" );
-
-        // There are two special case when we must not destroy the ref counters object even
-        // when NumWeakReferences == 0 && m_lNumStrongReferences == 0 :
+        // Decrementing the weak counter and reading the destroyed flag is a single atomic 
+        // operation. DestroyObject() sets the flag and reads the weak counter in another 
+        // single atomic operation. As both operations modify the same word, they are totally
+        // ordered, and exactly one of them observes both zero weak references and the destroyed
+        // object. That thread is the one that destroys the reference counters:
         //
-        //             This thread             |    Another thread - ReleaseStrongRef()
+        //             This thread             |    Another thread - DestroyObject()
         //                                     |
-        // 1. Lock the object                  |
-        //                                     |           
-        // 2. Decrement m_lNumWeakReferences,  |   1. Decrement m_lNumStrongReferences,
-        //    m_lNumWeakReferences==0          |      RefCount == 0
+        //                       NumStrongRefs == 0, NumWeakRefs == 1
         //                                     |
-        //                                     |   2. Start waiting for the lock to destroy
-        //                                     |      the object, m_ObjectState != ObjectState::Destroyed
-        // 3. Do not destroy reference         |
-        //    counters, unlock                 |
-        //                                     |   3. Acquire the lock, 
-        //                                     |      destroy the object, 
-        //                                     |      read m_lNumWeakReferences==0 
-        //                                     |      destroy the reference counters
+        // 1. Decrement NumWeakRefs and read   |
+        //    the state: NumWeakRefs == 0,     |
+        //    DestroyedFlag is not set         |
+        // 2. Do not destroy reference         |
+        //    counters                         |   1. Set DestroyedFlag and read the state:
+        //                                     |      NumWeakRefs == 0
+        //                                     |   2. Destroy the object
+        //                                     |   3. Destroy the reference counters
+        //
+        // or, if the operations are ordered the other way round:
         //
+        //                                     |   1. Set DestroyedFlag and read the state:
+        //                                     |      NumWeakRefs == 1
+        // 1. Decrement NumWeakRefs and read   |   2. Destroy the object
+        //    the state: NumWeakRefs == 0,     |   3. Do not destroy the reference counters
+        //    DestroyedFlag is set             |
+        // 2. Destroy the reference counters   |
+        //
+        // In the second case the reference counters may be destroyed while the object's
+        // destructor is still running, see comments in ~RefCountedObject().
+        auto PrevState = m_State.fetch_sub(WeakRefIncrement, std::memory_order_acq_rel);
+        VERIFY( UnpackNumWeakRefs(PrevState) > 0, "Inconsistent call to ReleaseWeakRef()" );
+        auto NumWeakReferences = static_cast<CounterValueType>( UnpackNumWeakRefs(PrevState) - 1 );
 
         // If an exception is thrown during the object construction and there is a weak pointer to the object itself,
         // we may get to this point, but should not destroy the reference counters, because it will be destroyed by MakeNewRCObj
@@ -117,31 +136,23 @@ public:
         //    {
         //     A.ctor()
         //       B.ctor()
-        //        wp.ctor m_lNumWeakReferences==1
+        //        wp.ctor NumWeakRefs==1
         //        throw
-        //        wp.dtor m_lNumWeakReferences==0, destroy this
+        //        wp.dtor NumWeakRefs==0, destroy this
         //    }
         //    catch(...)
         //    {
         //       Destory ref counters second time
         //    }
         // 
-        if( NumWeakReferences == 0 && /*m_lNumStrongReferences == 0 &&*/ m_ObjectState == ObjectState::Destroyed )
+        // DestroyedFlag is never set for an object that has not been attached, so this case is handled
+        // by the same check.
+        if( NumWeakReferences == 0 && (PrevState & DestroyedFlag) != 0 )
         {
-            VERIFY_EXPR(m_lNumStrongReferences == 0);
+            VERIFY_EXPR(UnpackNumStrongRefs(PrevState) == 0);
             VERIFY( m_ObjectWrapperBuffer[0] == 0 && m_ObjectWrapperBuffer[1] == 0, "Object wrapper must be null");
-            // m_ObjectState is set to ObjectState::Destroyed under the lock. If the state is not Destroyed, 
-            // ReleaseStrongRef() will take care of it. 
-            // Access to Object wrapper and decrementing m_lNumWeakReferences is atomic. Since we acquired the lock, 
-            // no other thread can access either of them. 
-            // Access to m_lNumStrongReferences is NOT PROTECTED by lock.
-
             // There are no more references to the ref counters object and the object itself
             // is already destroyed.
-            // We can safely unlock it and destroy.
-            // If we do not unlock it, this->m_LockFlag will expire, 
-            // which will cause Lock.~LockHelper() to crash.
-            Lock.Unlock();
             SelfDestroy();
         }
         return NumWeakReferences;
@@ -149,63 +160,45 @@ public:
 
     inline virtual void GetObject( class IObject **ppObject )override final
     {
-        if( m_ObjectState != ObjectState::Alive)
-            return; // Early exit
-
-        // It is essential to INCREMENT REF COUNTER while HOLDING THE LOCK to make sure that 
-        // StrongRefCnt > 1 guarantees that the object is alive.
-
-        // If other thread started deleting the object in ReleaseStrongRef(), then m_lNumStrongReferences==0
-        // We must make sure only one thread is allowed to increment the counter to guarantee that if StrongRefCnt > 1,
-        // there is at least one real strong reference left. Otherwise the following scenario may occur:
+        // Only increment the strong counter if it is not zero. Testing the counter and incrementing it 
+        // must be a single atomic operation. Otherwise the following scenario may occur:
         //
-        //                                      m_lNumStrongReferences == 1
+        //                           NumStrongRefs == 1
         //                                                                              
-        //    Thread 1 - ReleaseStrongRef()    |     Thread 2 - GetObject()        |     Thread 3 - GetObject()
-        //                                     |                                   |
-        //  - Decrement m_lNumStrongReferences | -Increment m_lNumStrongReferences | -Increment m_lNumStrongReferences
-        //  - Read RefCount == 0               | -Read StrongRefCnt==1             | -Read StrongRefCnt==2 
-        //    Destroy the object               |                                   | -Return reference to the soon
-        //                                     |                                   |  to expire object
-        //     
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-
-        auto StrongRefCnt = Atomics::AtomicIncrement(m_lNumStrongReferences);
-            
-        // Checking if m_ObjectState == ObjectState::Alive only is not reliable:
+        //    Thread 1 - ReleaseStrongRef()  |     Thread 2 - GetObject()        |     Thread 3 - GetObject()
+        //                                   |                                   |
+        //  - Decrement NumStrongRefs        | -Increment NumStrongRefs          | -Increment NumStrongRefs
+        //  - Read RefCount == 0             | -Read StrongRefCnt==1             | -Read StrongRefCnt==2 
+        //    Destroy the object             |                                   | -Return reference to the soon
+        //                                   |                                   |  to expire object
         //
-        //           This thread                    |          Another thread
-        //                                          |                                         
-        //   1. Acquire the lock                    |                                         
-        //                                          |    1. Decrement m_lNumStrongReferences  
-        //   2. Increment m_lNumStrongReferences    |    2. Test RefCount==0                  
-        //   3. Read StrongRefCnt == 1              |    3. Start destroying the object       
-        //      m_ObjectState == ObjectState::Alive |
-        //   4. DO NOT return the reference to      |    4. Wait for the lock, m_ObjectState == ObjectState::Alive
-        //      the object                          |
-        //   5. Decrement m_lNumStrongReferences    |
-        //                                          |    5. Destroy the object
-
-        if( m_ObjectState == ObjectState::Alive && StrongRefCnt > 1 )
+        // With compare-exchange, the increment fails if another thread has brought the counter to zero 
+        // in the meantime, so StrongRefCnt > 0 guarantees that there is at least one real strong reference 
+        // left. A failed attempt is only caused by another thread making progress, so the loop is lock-free.
+        auto State = m_State.load(std::memory_order_relaxed);
+        do
         {
-            VERIFY( m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // QueryInterface() must not lock the object, or a deadlock happens.
-            // The only other two methods that lock the object are ReleaseStrongRef()
-            // and ReleaseWeakRef(), which are never called by QueryInterface()
-            auto *pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
-            pWrapper->QueryInterface(Diligent::IID_Unknown, ppObject);
-        }
-        Atomics::AtomicDecrement(m_lNumStrongReferences);
+            if( !IsAlive(State) || UnpackNumStrongRefs(State) == 0 )
+                return;
+        }while( !m_State.compare_exchange_weak(State, State + StrongRefIncrement, std::memory_order_acquire, std::memory_order_relaxed) );
+
+        // We now own a strong reference to the object
+        VERIFY( m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
+        auto *pWrapper = reinterpret_cast<ObjectWrapperBase*>(m_ObjectWrapperBuffer);
+        pWrapper->QueryInterface(Diligent::IID_Unknown, ppObject);
+
+        // QueryInterface() has added its own strong reference, so this normally does not destroy the object
+        ReleaseStrongRef();
     }
 
     inline virtual CounterValueType GetNumStrongRefs()const override final
     {
-        return m_lNumStrongReferences;
+        return static_cast<CounterValueType>( UnpackNumStrongRefs(m_State.load(std::memory_order_relaxed)) );
     }
 
     inline virtual CounterValueType GetNumWeakRefs()const override final
     {
-        return m_lNumWeakReferences;
+        return static_cast<CounterValueType>( UnpackNumWeakRefs(m_State.load(std::memory_order_relaxed)) );
     }
 
 private:
@@ -214,8 +207,6 @@ private:
 
     RefCountersImpl()noexcept
     {
-        m_lNumStrongReferences = 0;
-        m_lNumWeakReferences = 0;
 #ifdef _DEBUG
         memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
 #endif
@@ -263,186 +254,47 @@ private:
     template<typename ObjectType, typename AllocatorType>
     void Attach(ObjectType *pObject, AllocatorType *pAllocator)
     {
-        VERIFY(m_ObjectState == ObjectState::NotInitialized, "Object has already been attached");
+        VERIFY((m_State.load(std::memory_order_relaxed) & (AliveFlag | DestroyedFlag)) == 0, "Object has already been attached");
         static_assert(sizeof(ObjectWrapper<ObjectType, AllocatorType>) == sizeof(m_ObjectWrapperBuffer), "Unexpected object wrapper size");
         new(m_ObjectWrapperBuffer) ObjectWrapper<ObjectType, AllocatorType>(pObject, pAllocator);
-        m_ObjectState = ObjectState::Alive;
+        // Release semantics publish the object wrapper to threads that acquire the object through GetObject()
+        m_State.fetch_or(AliveFlag, std::memory_order_release);
     }
 
-    void TryDestroyObject()
+    void DestroyObject()
     {
-        // Since RefCount==0, there are no more strong references and the only place 
-        // where strong ref counter can be incremented is from GetObject().
-
-        // If several threads were allowed to get to this point, there would 
-        // be serious risk that <this> had already been destroyed and m_LockFlag expired. 
-        // Consider the following scenario:
-        //                                      |
-        //             This thread              |             Another thread
-        //                                      |
-        //                      m_lNumStrongReferences == 1
-        //                      m_lNumWeakReferences == 1
-        //                                      |  
-        // 1. Decrement m_lNumStrongReferences  |   
-        //    Read RefCount==0, no lock acquired|      
-        //                                      |   1. Run GetObject()
-        //                                      |      - acquire the lock
-        //                                      |      - increment m_lNumStrongReferences
-        //                                      |      - release the lock
-        //                                      |   
-        //                                      |   2. Run ReleaseWeakRef()
-        //                                      |      - decrement m_lNumWeakReferences
-        //                                      |  
-        //                                      |   3. Run ReleaseStrongRef()
-        //                                      |      - decrement m_lNumStrongReferences
-        //                                      |      - read RefCount==0
-        //
-        //         Both threads will get to this point. The first one will destroy <this>
-        //         The second one will read expired m_LockFlag
-
-        //  IT IS CRUCIALLY IMPORTANT TO ASSURE THAT ONLY ONE THREAD WILL EVER
-        //  EXECUTE THIS CODE
-
-        // The sloution is to atomically increment strong ref counter in GetObject().
-        // There are two possible scenarios depending on who first increments the counter:
-
-
-        //                                                     Scenario I
-        //
-        //             This thread              |      Another thread - GetObject()         |   One more thread - GetObject()
-        //                                      |                                           |
-        //                       m_lNumStrongReferences == 1                                |
-        //                                      |                                           |
-        //                                      |   1. Acquire the lock                     |
-        // 1. Decrement m_lNumStrongReferences  |                                           |   1. Wait for the lock
-        // 2. Read RefCount==0                  |   2. Increment m_lNumStrongReferences     |
-        // 3. Start destroying the object       |   3. Read StrongRefCnt == 1               |
-        // 4. Wait for the lock                 |   4. DO NOT return the reference          |
-        //                                      |      to the object                        |
-        //                                      |   5. Decrement m_lNumStrongReferences     |
-        // _  _  _  _  _  _  _  _  _  _  _  _  _|   6. Release the lock _  _  _  _  _  _  _ |_  _  _  _  _  _  _  _  _  _  _  _  _  _
-        //                                      |                                           |   2. Acquire the lock  
-        //                                      |                                           |   3. Increment m_lNumStrongReferences
-        //                                      |                                           |   4. Read StrongRefCnt == 1
-        //                                      |                                           |   5. DO NOT return the reference 
-        //                                      |                                           |      to the object
-        //                                      |                                           |   6. Decrement m_lNumStrongReferences         
-        //  _  _  _  _  _  _  _  _  _  _  _  _  | _  _  _  _  _  _  _  _  _  _  _  _  _  _  | _ 7. Release the lock _  _  _  _  _  _
-        // 5. Acquire the lock                  |                                           |
-        //   - m_lNumStrongReferences==0        |                                           |
-        // 6. DESTROY the object                |                                           |
-        //                                      |                                           |
-
-        //  GetObject() MUST BE SERIALIZED for this to work properly!
-
-
-        //                                   Scenario II
-        //
-        //             This thread              |      Another thread - GetObject()
-        //                                      |
-        //                       m_lNumStrongReferences == 1
-        //                                      |
-        //                                      |   1. Acquire the lock  
-        //                                      |   2. Increment m_lNumStrongReferences
-        // 1. Decrement m_lNumStrongReferences  |
-        // 2. Read RefCount>0                   |   
-        // 3. DO NOT destroy the object         |   3. Read StrongRefCnt > 1 (while m_lNumStrongReferences == 1)
-        //                                      |   4. Return the reference to the object
-        //                                      |       - Increment m_lNumStrongReferences
-        //                                      |   5. Decrement m_lNumStrongReferences
-
-#ifdef _DEBUG
-        Atomics::Long NumStrongRefs = m_lNumStrongReferences;
-        VERIFY( NumStrongRefs == 0 || NumStrongRefs == 1, "Num strong references (", NumStrongRefs, ") is expected to be 0 or 1" );
-#endif
-
-        // Acquire the lock.
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-
-        // GetObject() first acquires the lock, and only then increments and 
-        // decrements the ref counter. If it reads 1 after incremeting the counter,
-        // it does not return the reference to the object and decrements the counter.
-        // If we acquired the lock, GetObject() will not start until we are done
-        VERIFY_EXPR( m_lNumStrongReferences == 0 && m_ObjectState == ObjectState::Alive );
-                
-        // Extra caution
-        if(m_lNumStrongReferences == 0 && m_ObjectState == ObjectState::Alive)
-        {
-            VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
-            // We cannot destroy the object while reference counters are locked as this will  
-            // cause a deadlock in cases like this:
-            //
-            //    A ==sp==> B ---wp---> A
-            //    
-            //    RefCounters_A.Lock();
-            //    delete A{
-            //      A.~dtor(){
-            //          B.~dtor(){
-            //              wpA.ReleaseWeakRef(){
-            //                  RefCounters_A.Lock(); // Deadlock
-            //
-
-            // So we copy the object wrapper and destroy the object after unlocking the
-            // reference counters
-            size_t ObjectWrapperBufferCopy[ObjectWrapperBufferSize];
-            for(size_t i=0; i < ObjectWrapperBufferSize; ++i)
-                ObjectWrapperBufferCopy[i] = m_ObjectWrapperBuffer[i];
+        // Since the strong counter is zero, no other thread can access the object wrapper.
+        VERIFY_EXPR( UnpackNumStrongRefs(m_State.load(std::memory_order_relaxed)) == 0 );
+        VERIFY(m_ObjectWrapperBuffer[0] != 0 && m_ObjectWrapperBuffer[1] != 0, "Object wrapper is not initialized");
+
+        // Copy the object wrapper as <this> may be destroyed by ReleaseWeakRef() running in 
+        // another thread as soon as DestroyedFlag is set
+        size_t ObjectWrapperBufferCopy[ObjectWrapperBufferSize];
+        for(size_t i=0; i < ObjectWrapperBufferSize; ++i)
+            ObjectWrapperBufferCopy[i] = m_ObjectWrapperBuffer[i];
 #ifdef _DEBUG
-            memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
+        memset(m_ObjectWrapperBuffer, 0, sizeof(m_ObjectWrapperBuffer));
 #endif
-            auto *pWrapper = reinterpret_cast<ObjectWrapperBase*>(ObjectWrapperBufferCopy);
-
-            // In a multithreaded environment, reference counters object may 
-            // be destroyed at any time while m_pObject->~dtor() is running.
-            // NOTE: m_pObject may not be the only object referencing m_pRefCounters.
-            //       All objects that are owned by m_pObject will point to the same 
-            //       reference counters object.
-
-            // Note that this is the only place where m_ObjectState is
-            // modified after the ref counters object has been created
-            m_ObjectState = ObjectState::Destroyed;
-            // The object is now detached from the reference counters and it is if
-            // it was destroyed since no one can obtain access to it.
-
-
-            // It is essentially important to check the number of weak references
-            // while the object is locked. Otherwise reference counters object
-            // may be destroyed twice if ReleaseWeakRef() is executed by other thread:
-            //
-            //             This thread             |    Another thread - ReleaseWeakRef()
-            //                                     |           
-            // 1. Decrement m_lNumStrongReferences,|   
-            //    m_lNumStrongReferences==0,       |   
-            //    acquire the lock, destroy        |
-            //    the obj, release the lock        |
-            //    m_lNumWeakReferences == 1        | 
-            //                                     |   1. Aacquire the lock, 
-            //                                     |      decrement m_lNumWeakReferences,
-            //                                     |      m_lNumWeakReferences == 0, 
-            //                                     |      m_ObjectState == ObjectState::Destroyed
-            //                                     |
-            // 2. Read m_lNumWeakReferences == 0   |
-            // 3. Destroy the ref counters obj     |   2. Destroy the ref counters obj
-            //
-            bool bDestroyThis = m_lNumWeakReferences == 0;
-            // ReleaseWeakRef() decrements m_lNumWeakReferences, and checks it for
-            // zero only after acquiring the lock. So if m_lNumWeakReferences==0, no 
-            // weak reference-related code may be running
-
-
-            // We must explicitly unlock the object now to avoid deadlocks. Also, 
-            // if this is deleted, this->m_LockFlag will expire, which will cause 
-            // Lock.~LockHelper() to crash
-            Lock.Unlock();
-
-            // Destroy referenced object
-            pWrapper->DestroyObject();
-
-            // Note that <this> may be destroyed here already, 
-            // see comments in ~ControlledObjectType()
-            if( bDestroyThis )
-                SelfDestroy();
-        }
+        auto *pWrapper = reinterpret_cast<ObjectWrapperBase*>(ObjectWrapperBufferCopy);
+
+        // Setting DestroyedFlag and reading the number of weak references is a single atomic operation,
+        // see comments in ReleaseWeakRef(). If there are no weak references, no weak reference-related
+        // code can be running and this thread is responsible for destroying the reference counters.
+        auto PrevState = m_State.fetch_or(DestroyedFlag, std::memory_order_acq_rel);
+        VERIFY_EXPR( (PrevState & DestroyedFlag) == 0 );
+        bool bDestroyThis = UnpackNumWeakRefs(PrevState) == 0;
+
+        // In a multithreaded environment, reference counters object may 
+        // be destroyed at any time while m_pObject->~dtor() is running.
+        // NOTE: m_pObject may not be the only object referencing m_pRefCounters.
+        //       All objects that are owned by m_pObject will point to the same 
+        //       reference counters object.
+        pWrapper->DestroyObject();
+
+        // Note that <this> may be destroyed here already, 
+        // see comments in ~RefCountedObject()
+        if( bDestroyThis )
+            SelfDestroy();
     }
 
     void SelfDestroy()
@@ -452,7 +304,7 @@ private:
 
     ~RefCountersImpl()
     {
-        VERIFY( m_lNumStrongReferences == 0 && m_lNumWeakReferences == 0,
+        VERIFY( (m_State.load(std::memory_order_relaxed) & (StrongRefMask | WeakRefMask)) == 0,
                 "There exist outstanding references to the object being destroyed" );
     }
 
@@ -462,18 +314,29 @@ private:
     RefCountersImpl& operator = (const RefCountersImpl&) = delete;
     RefCountersImpl& operator = (RefCountersImpl&&) = delete;
 
+    // Strong and weak reference counters as well as the object state are packed into a single
+    // 64-bit word so that all transitions that must be consistent with each other are single
+    // atomic operations:
+    //
+    //   Bits  0-31  Number of strong references
+    //   Bits 32-61  Number of weak references
+    //   Bit     62  The object has been attached
+    //   Bit     63  The object has been destroyed
+    static constexpr Uint64 StrongRefIncrement = Uint64{1};
+    static constexpr Uint64 StrongRefMask      = Uint64{0xFFFFFFFF};
+    static constexpr Uint32 WeakRefShift       = 32;
+    static constexpr Uint64 WeakRefIncrement   = Uint64{1} << WeakRefShift;
+    static constexpr Uint64 WeakRefMask        = Uint64{0x3FFFFFFF} << WeakRefShift;
+    static constexpr Uint64 AliveFlag          = Uint64{1} << 62;
+    static constexpr Uint64 DestroyedFlag      = Uint64{1} << 63;
+
+    static Uint64 UnpackNumStrongRefs(Uint64 State){ return State & StrongRefMask; }
+    static Uint64 UnpackNumWeakRefs  (Uint64 State){ return (State & WeakRefMask) >> WeakRefShift; }
+    static bool   IsAlive            (Uint64 State){ return (State & (AliveFlag | DestroyedFlag)) == AliveFlag; }
+
     static constexpr size_t ObjectWrapperBufferSize = sizeof(ObjectWrapper<IObject, IMemoryAllocator>) / sizeof(size_t);
     size_t m_ObjectWrapperBuffer[ObjectWrapperBufferSize];
-    Atomics::AtomicLong m_lNumStrongReferences;
-    Atomics::AtomicLong m_lNumWeakReferences;
-    ThreadingTools::LockFlag m_LockFlag;
-    enum class ObjectState : Int32
-    {
-        NotInitialized,
-        Alive,
-        Destroyed
-    };
-    volatile ObjectState m_ObjectState = ObjectState::NotInitialized;
+    std::atomic<Uint64> m_State{0};
 };
 
 
@@ -500,7 +363,7 @@ public:
         //    A ==sp==> B ---wp---> A
         //    
         //    RefCounters_A.ReleaseStrongRef(){ // NumStrongRef == 0, NumWeakRef == 1
-        //      bDestroyThis = (m_lNumWeakReferences == 0) == false;
+        //      bDestroyThis = (NumWeakRefs == 0) == false;
         //      delete A{
         //        A.~dtor(){
         //            B.~dtor(){
@@ -152,6 +152,22 @@ struct STDDeleter
 
     AllocatorType &m_Allocator;
 };
+// Deleter for untyped memory buffers (e.g. std::unique_ptr<void, STDDeleterRawMem<void>>)
+template< typename AllocatorType > 
+struct STDDeleter<void, AllocatorType>
+{
+    STDDeleter(AllocatorType &Allocator) : 
+        m_Allocator(Allocator)
+    {}
+        
+    void operator()(void *ptr)
+    {
+        m_Allocator.Free(ptr);
+    }
+
+    AllocatorType &m_Allocator;
+};
+
 template<class T> using STDDeleterRawMem = STDDeleter<T, IMemoryAllocator>; 
 
 }
@@ -0,0 +1,63 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::StringInterner class
+
+#include "HashUtils.h"
+
+namespace Diligent
+{
+
+/// Global thread-safe string interner
+
+/// Every distinct string is stored once, and all requests to intern equal strings return
+/// the same InternedString atom. Atoms can thus be compared and hashed in constant time, 
+/// which makes them suitable as keys of hash tables that are looked up frequently, such as 
+/// shader variable tables. Tables keyed by atoms can be searched with raw strings through
+/// HashMapStringKey, which compares hashes and characters of non-interned keys. Find() locks
+/// a shard and hashes the string, so it should not be used on lookup hot paths.
+///
+/// \remarks Interned strings are never released and remain valid until the process terminates.
+///          Only engine-owned names that come from a bounded set, such as shader resource names,
+///          must be interned. Application-provided strings, which may be generated dynamically, 
+///          must not be interned.
+///          The interner is split into independently locked shards selected by the string hash,
+///          so that threads interning different strings rarely contend. Memory is allocated 
+///          through the raw memory allocator.
+class StringInterner
+{
+public:
+    /// Returns the atom for the given string, interning the string if necessary
+    static InternedString Intern(const Char* Str);
+
+    /// Returns the atom for the given string if the string has been interned, and null atom otherwise
+    static InternedString Find(const Char* Str);
+
+    /// Returns the total number of interned strings
+    static size_t GetNumStrings();
+};
+
+}
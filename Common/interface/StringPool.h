@@ -27,45 +27,84 @@
 /// Defines Diligent::StringPool class
 
 #include <cstring>
+#include <algorithm>
+#include <unordered_set>
+#include <new>
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
+#include "STDAllocator.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.h"
+#include "HashUtils.h"
 
 namespace Diligent
 {
 
-/// Implementation of a simple fixed-size string pool
+/// Implementation of a simple string pool
+
+/// The pool operates in one of two modes:
+/// - Fixed-size mode: memory is provided by AssignMemory() or Reserve() and the pool
+///   must not overflow it.
+/// - Growable mode: the pool is created with an allocator and a block size and chains
+///   new blocks from the allocator as needed. This allows filling the pool in a single pass
+///   without computing the total size of all strings beforehand.
+///
+/// If deduplication is enabled, CopyString() returns the existing copy of a string
+/// previously added to the pool instead of making a new one.
 class StringPool
 {
 public:
     StringPool(){}
+
+    /// Creates a growable pool that allocates blocks of at least BlockSize bytes from Allocator
+    StringPool(IMemoryAllocator &Allocator, size_t BlockSize, bool Deduplicate = false) :
+        m_pAllocator  (&Allocator),
+        m_BlockSize   (BlockSize),
+        m_Deduplicate (Deduplicate)
+    {
+        VERIFY(m_BlockSize != 0, "Block size must not be zero");
+        if (m_Deduplicate)
+        {
+            // The lookup set lives in the pool's allocator as do all other pool allocations
+            auto* pSetMem = m_pAllocator->Allocate(sizeof(StringSet), "Memory for string pool lookup set", __FILE__, __LINE__);
+            m_pStrings = new (pSetMem) StringSet(0, CStringHash<Char>(), CStringCompare<Char>(), STD_ALLOCATOR_RAW_MEM(const Char*, *m_pAllocator, "Allocator for unordered_set<const Char*>"));
+        }
+    }
     
     StringPool             (const StringPool&) = delete;
     StringPool& operator = (const StringPool&) = delete;
 
     ~StringPool()
     {
-        if(m_pBuffer != nullptr && m_pAllocator != nullptr)
+        if (m_pStrings != nullptr)
         {
-            m_pAllocator->Free(m_pBuffer);
+            m_pStrings->~StringSet();
+            m_pAllocator->Free(m_pStrings);
+        }
+
+        auto* pBlock = m_pBlocks;
+        while (pBlock != nullptr)
+        {
+            auto* pNextBlock = pBlock->pNext;
+            m_pAllocator->Free(pBlock);
+            pBlock = pNextBlock;
         }
     }
 
     void Reserve(size_t Size, IMemoryAllocator &Allocator)
     {
-        VERIFY(m_ReservedSize == 0, "Pool is already initialized");
+        VERIFY(m_ReservedSize == 0 && m_pBlocks == nullptr, "Pool is already initialized");
+        VERIFY(m_pAllocator == nullptr || m_pAllocator == &Allocator, "Inconsistent allocator");
         m_pAllocator = &Allocator;
-        m_ReservedSize = Size;
-        if (m_ReservedSize != 0)
+        if (Size != 0)
         {
-            m_pBuffer = reinterpret_cast<Char*>(m_pAllocator->Allocate(m_ReservedSize, "Memory for string pool", __FILE__, __LINE__));
+            AllocateBlock(Size);
         }
-        m_pCurrPtr = m_pBuffer;
     }
 
     void AssignMemory(Char* pBuffer, size_t Size)
     {
-        VERIFY(m_ReservedSize == 0, "Pool is already initialized");
+        VERIFY(m_ReservedSize == 0 && m_pBlocks == nullptr, "Pool is already initialized");
+        VERIFY(m_BlockSize == 0, "External memory cannot be assigned to a growable pool");
         m_ReservedSize = Size;
         m_pBuffer = pBuffer;
         m_pCurrPtr = m_pBuffer;
@@ -73,7 +112,15 @@ public:
 
     Char* Allocate(size_t Length)
     {
-        VERIFY(m_pCurrPtr + Length <= m_pBuffer + m_ReservedSize, "Not enough space in the buffer");
+        if (m_pCurrPtr + Length > m_pBuffer + m_ReservedSize)
+        {
+            if (m_BlockSize == 0)
+            {
+                UNEXPECTED("Not enough space in the buffer");
+                return nullptr;
+            }
+            AllocateBlock(std::max(Length, m_BlockSize));
+        }
         auto *Ptr = m_pCurrPtr;
         m_pCurrPtr += Length;
         return Ptr;
@@ -81,47 +128,86 @@ public:
 
     Char* CopyString(const String& Str)
     {
-        auto len = Str.length();
-        auto *str = Allocate(len + 1);
-        if(len != 0)
-        {
-            memcpy(str, Str.data(), len * sizeof(str[0]));
-        }
-        str[len] = 0;
-        return str;
+        return CopyString(Str.c_str(), Str.length());
     }
 
     Char* CopyString(const char* Str)
     {
-        auto* Ptr = m_pCurrPtr;
-        while(*Str != 0 && m_pCurrPtr < m_pBuffer + m_ReservedSize)
-        {
-            *(m_pCurrPtr++) = *(Str++);
-        }
-        if(m_pCurrPtr < m_pBuffer + m_ReservedSize)
-            *(m_pCurrPtr++) = 0;
-        else
-            UNEXPECTED("Not enough space reserved in the string pool");
-        return Ptr;
+        return CopyString(Str, strlen(Str));
     }
 
-
+    /// Returns the remaining size in the current block
     size_t GetRemainingSize()const
     {
         VERIFY(m_pCurrPtr <= m_pBuffer + m_ReservedSize, "Buffer overflow");
         return m_ReservedSize - (m_pCurrPtr - m_pBuffer);
     }
+
+    /// Returns the total size used in all blocks
     size_t GetUsedSize()const
     {
         VERIFY(m_pCurrPtr <= m_pBuffer + m_ReservedSize, "Buffer overflow");
-        return m_pCurrPtr - m_pBuffer;
+        return m_UsedSizeInFullBlocks + (m_pCurrPtr - m_pBuffer);
     }
 
 private:
+    // Str must be a null-terminated string of length Length
+    Char* CopyString(const Char* Str, size_t Length)
+    {
+        if (m_pStrings != nullptr)
+        {
+            auto it = m_pStrings->find(Str);
+            if (it != m_pStrings->end())
+                return const_cast<Char*>(*it);
+        }
+
+        auto *str = Allocate(Length + 1);
+        if (str == nullptr)
+            return nullptr;
+        if (Length != 0)
+        {
+            memcpy(str, Str, Length * sizeof(str[0]));
+        }
+        str[Length] = 0;
+
+        if (m_pStrings != nullptr)
+            m_pStrings->insert(str);
+        return str;
+    }
+
+    struct BlockHeader
+    {
+        BlockHeader* pNext;
+    };
+
+    void AllocateBlock(size_t Size)
+    {
+        VERIFY_EXPR(m_pAllocator != nullptr);
+        auto* pBlock = reinterpret_cast<BlockHeader*>(m_pAllocator->Allocate(sizeof(BlockHeader) + Size, "Memory for string pool", __FILE__, __LINE__));
+        pBlock->pNext = m_pBlocks;
+        m_pBlocks = pBlock;
+
+        m_UsedSizeInFullBlocks += m_pCurrPtr - m_pBuffer;
+        m_pBuffer = reinterpret_cast<Char*>(pBlock + 1);
+        m_pCurrPtr = m_pBuffer;
+        m_ReservedSize = Size;
+    }
+
     Char*               m_pBuffer       = nullptr;
     Char*               m_pCurrPtr      = nullptr;
     size_t              m_ReservedSize  = 0;
     IMemoryAllocator*   m_pAllocator    = nullptr;
+
+    // Blocks allocated by the pool, most recent first
+    BlockHeader*        m_pBlocks       = nullptr;
+    // Zero for fixed-size pools
+    size_t              m_BlockSize     = 0;
+    size_t              m_UsedSizeInFullBlocks = 0;
+
+    bool                m_Deduplicate   = false;
+    using StringSet = std::unordered_set<const Char*, CStringHash<Char>, CStringCompare<Char>, STDAllocatorRawMem<const Char*>>;
+    // Only created for deduplicating pools
+    StringSet*          m_pStrings      = nullptr;
 };
 
 }
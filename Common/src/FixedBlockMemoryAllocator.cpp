@@ -23,20 +23,60 @@
 
 #include "pch.h"
 #include "FixedBlockMemoryAllocator.h"
+#include "LockHelper.h"
 
 namespace Diligent
 {
+    namespace
+    {
+        inline Uint32 GetHeadIndex(Uint64 Head){return static_cast<Uint32>(Head & 0xFFFFFFFF);}
+        inline Uint32 GetHeadTag  (Uint64 Head){return static_cast<Uint32>(Head >> 32);}
+        inline Uint64 PackHead(Uint32 Index, Uint32 Tag){return (static_cast<Uint64>(Tag) << 32) | static_cast<Uint64>(Index);}
+    }
+
     FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                          size_t            BlockSize,
-                                                         Uint32            NumBlocksInPage) :
+                                                         Uint32            NumBlocksInPage,
+                                                         bool              ThreadCaching) :
         m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
         m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>")),
         m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
         m_RawMemoryAllocator(RawMemoryAllocator),
         m_BlockSize         (BlockSize),
-        m_NumBlocksInPage   (NumBlocksInPage)
+        m_NumBlocksInPage   (NumBlocksInPage),
+        m_ThreadCaching     (ThreadCaching),
+        m_GlobalFreeListHead(PackHead(InvalidBlockIndex, 0))
     {
-        if (BlockSize > 0)
+#ifdef _DEBUG
+        m_dbgNumAllocatedBlocks = 0;
+#endif
+        if (BlockSize == 0)
+            return;
+
+        if (m_ThreadCaching)
+        {
+            VERIFY(m_BlockSize >= sizeof(void*), "Block size (", m_BlockSize, ") must be at least ", sizeof(void*), " bytes in thread-cached mode");
+            if (m_BlockSize < sizeof(void*))
+                m_BlockSize = sizeof(void*);
+
+            m_AlignedPageHeaderSize = (sizeof(AlignedPageHeader) + 15) & ~size_t{15};
+            auto MinPageSize = m_AlignedPageHeaderSize + m_BlockSize * m_NumBlocksInPage;
+            m_AlignedPageSize = 1;
+            while (m_AlignedPageSize < MinPageSize)
+                m_AlignedPageSize *= 2;
+            // Use the space left after rounding the page size up to the power of two
+            m_NumBlocksInPage = static_cast<Uint32>((m_AlignedPageSize - m_AlignedPageHeaderSize) / m_BlockSize);
+
+            // Raw allocator does not support alignment, so align the caches manually
+            m_pThreadCachesRawMemory = m_RawMemoryAllocator.Allocate(sizeof(ThreadCache) * MaxThreadCaches + CacheLineSize - 1, "FixedBlockMemoryAllocator thread caches", __FILE__, __LINE__);
+            m_ThreadCaches = reinterpret_cast<ThreadCache*>( (reinterpret_cast<size_t>(m_pThreadCachesRawMemory) + CacheLineSize - 1) & ~(CacheLineSize - 1) );
+            for (Uint32 c = 0; c < MaxThreadCaches; ++c)
+                new(m_ThreadCaches + c) ThreadCache;
+
+            // Pages are created on first use, see RefillThreadCache(), so that allocators 
+            // that are never used do not reserve any memory for the pages
+        }
+        else
         {
             // Allocate one page
             CreateNewPage();
@@ -45,6 +85,26 @@ namespace Diligent
 
     FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
     {
+        if (m_ThreadCaching)
+        {
+#ifdef _DEBUG
+            VERIFY(m_dbgNumAllocatedBlocks == 0, "Memory leak detected: ", m_dbgNumAllocatedBlocks, " block(s) have not been released");
+#endif
+            // Pages carved out of one raw allocation follow the first page, so release 
+            // the allocations in reverse order to not access headers of released pages
+            for (Uint32 p = m_NumAlignedPages; p-- > 0; )
+            {
+                auto* pHeader = reinterpret_cast<AlignedPageHeader*>(m_PageTable[p / PageTableChunkSize][p % PageTableChunkSize]);
+                if (pHeader->pRawMemory != nullptr)
+                    m_RawMemoryAllocator.Free(pHeader->pRawMemory);
+            }
+            for (Uint32 c = 0; c < MaxPageTableChunks && m_PageTable[c] != nullptr; ++c)
+                m_RawMemoryAllocator.Free(m_PageTable[c]);
+            if (m_pThreadCachesRawMemory != nullptr)
+                m_RawMemoryAllocator.Free(m_pThreadCachesRawMemory);
+            return;
+        }
+
 #ifdef _DEBUG
         for (size_t p = 0; p < m_PagePool.size(); ++p)
         {
@@ -63,8 +123,11 @@ namespace Diligent
 
     void* FixedBlockMemoryAllocator::Allocate( size_t Size, const Char* dbgDescription, const char* dbgFileName, const  Int32 dbgLineNumber)
     {
-        VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+        VERIFY(m_BlockSize == Size || (m_ThreadCaching && Size <= m_BlockSize), "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
         
+        if (m_ThreadCaching)
+            return AllocateThreadCached();
+
         std::lock_guard<std::mutex> LockGuard(m_Mutex);
         
         if (m_AvailablePages.empty())
@@ -86,6 +149,12 @@ namespace Diligent
 
     void FixedBlockMemoryAllocator::Free(void *Ptr)
     {
+        if (m_ThreadCaching)
+        {
+            FreeThreadCached(Ptr);
+            return;
+        }
+
         std::lock_guard<std::mutex> LockGuard(m_Mutex);
         auto PageIdIt = m_AddrToPageId.find(Ptr);
         if (PageIdIt != m_AddrToPageId.end())
@@ -109,4 +178,183 @@ namespace Diligent
             UNEXPECTED("Address not found in the allocations list - double freeing memory?");
         }
     }
+
+
+    void FixedBlockMemoryAllocator::CreateAlignedPage()
+    {
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
+
+        auto PageIndex = m_NumAlignedPages;
+        auto ChunkIndex = PageIndex / PageTableChunkSize;
+        if (ChunkIndex >= MaxPageTableChunks || static_cast<Uint64>(PageIndex + 1) * m_NumBlocksInPage >= InvalidBlockIndex)
+        {
+            LOG_ERROR_AND_THROW("Maximum number of pages (", PageIndex, ") in the fixed block allocator has been reached");
+        }
+
+        if (m_PageTable[ChunkIndex] == nullptr)
+        {
+            m_PageTable[ChunkIndex] = reinterpret_cast<Uint8**>(
+                m_RawMemoryAllocator.Allocate(sizeof(Uint8*) * PageTableChunkSize, "FixedBlockMemoryAllocator page table chunk", __FILE__, __LINE__)
+                );
+        }
+
+        void* pRawMemory = nullptr;
+        if (m_NumReservedAlignedPages == 0)
+        {
+            // Raw allocator does not support alignment, so we have to allocate enough space to align the pages manually.
+            // Default raw allocators return memory aligned by at least sizeof(void*).
+            pRawMemory = m_RawMemoryAllocator.Allocate(m_AlignedPageSize * (AlignedPagesPerRawAllocation + 1) - sizeof(void*), "FixedBlockMemoryAllocator aligned pages", __FILE__, __LINE__);
+            m_pNextAlignedPage = reinterpret_cast<Uint8*>( (reinterpret_cast<size_t>(pRawMemory) + m_AlignedPageSize - 1) & ~(m_AlignedPageSize - 1) );
+            m_NumReservedAlignedPages = AlignedPagesPerRawAllocation;
+        }
+        auto* pPageStart = m_pNextAlignedPage;
+        m_pNextAlignedPage += m_AlignedPageSize;
+        --m_NumReservedAlignedPages;
+        FillWithDebugPattern(pPageStart, MemoryPage::NewPageMemPattern, m_AlignedPageSize);
+
+        auto* pHeader = reinterpret_cast<AlignedPageHeader*>(pPageStart);
+        // Only the first page keeps the pointer to the raw memory, which is released with all its pages
+        pHeader->pRawMemory = pRawMemory;
+        pHeader->PageIndex  = PageIndex;
+        m_PageTable[ChunkIndex][PageIndex % PageTableChunkSize] = pPageStart;
+        ++m_NumAlignedPages;
+
+        // Link all blocks of the page through their indices and release them to the global list
+        auto FirstBlockIndex = PageIndex * m_NumBlocksInPage;
+        for (Uint32 b = 0; b + 1 < m_NumBlocksInPage; ++b)
+            *reinterpret_cast<Uint32*>(GetBlockAddress(FirstBlockIndex + b)) = FirstBlockIndex + b + 1;
+        PushGlobalBlocks(FirstBlockIndex, GetBlockAddress(FirstBlockIndex + m_NumBlocksInPage - 1));
+    }
+
+    void* FixedBlockMemoryAllocator::GetBlockAddress(Uint32 BlockIndex)const
+    {
+        auto PageIndex = BlockIndex / m_NumBlocksInPage;
+        auto* pPageStart = m_PageTable[PageIndex / PageTableChunkSize][PageIndex % PageTableChunkSize];
+        return pPageStart + m_AlignedPageHeaderSize + (BlockIndex % m_NumBlocksInPage) * m_BlockSize;
+    }
+
+    Uint32 FixedBlockMemoryAllocator::GetBlockIndex(const void* pBlock)const
+    {
+        // Pages are aligned by their size, so the page header is found by masking the block address
+        auto* pPageStart = reinterpret_cast<const Uint8*>( reinterpret_cast<size_t>(pBlock) & ~(m_AlignedPageSize - 1) );
+        const auto* pHeader = reinterpret_cast<const AlignedPageHeader*>(pPageStart);
+        size_t Offset = reinterpret_cast<const Uint8*>(pBlock) - pPageStart - m_AlignedPageHeaderSize;
+        VERIFY(pHeader->PageIndex < m_NumAlignedPages && m_PageTable[pHeader->PageIndex / PageTableChunkSize][pHeader->PageIndex % PageTableChunkSize] == pPageStart,
+               "Address does not belong to this allocator");
+        VERIFY(Offset % m_BlockSize == 0 && Offset / m_BlockSize < m_NumBlocksInPage, "Invalid block address");
+        return pHeader->PageIndex * m_NumBlocksInPage + static_cast<Uint32>(Offset / m_BlockSize);
+    }
+
+    void FixedBlockMemoryAllocator::PushGlobalBlocks(Uint32 FirstBlockIndex, void* pLastBlock)
+    {
+        auto OldHead = m_GlobalFreeListHead.load(std::memory_order_relaxed);
+        do
+        {
+            *reinterpret_cast<Uint32*>(pLastBlock) = GetHeadIndex(OldHead);
+        } while (!m_GlobalFreeListHead.compare_exchange_weak(OldHead, PackHead(FirstBlockIndex, GetHeadTag(OldHead) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void* FixedBlockMemoryAllocator::PopGlobalBlock()
+    {
+        auto OldHead = m_GlobalFreeListHead.load(std::memory_order_acquire);
+        for (;;)
+        {
+            auto BlockIndex = GetHeadIndex(OldHead);
+            if (BlockIndex == InvalidBlockIndex)
+                return nullptr;
+
+            auto* pBlock = GetBlockAddress(BlockIndex);
+            // The block may have been popped and overwritten by another thread since we read the head. 
+            // In this case the value we read is garbage, but the tag guarantees that the exchange below fails.
+            auto NextIndex = *reinterpret_cast<volatile Uint32*>(pBlock);
+            if (m_GlobalFreeListHead.compare_exchange_weak(OldHead, PackHead(NextIndex, GetHeadTag(OldHead) + 1), std::memory_order_acquire, std::memory_order_acquire))
+                return pBlock;
+        }
+    }
+
+    void FixedBlockMemoryAllocator::RefillThreadCache(ThreadCache& Cache)
+    {
+        VERIFY_EXPR(Cache.NumBlocks == 0);
+        while (Cache.NumBlocks < ThreadCacheCapacity / 2)
+        {
+            auto* pBlock = PopGlobalBlock();
+            if (pBlock == nullptr)
+            {
+                if (Cache.NumBlocks > 0)
+                    break;
+                CreateAlignedPage();
+                continue;
+            }
+            *reinterpret_cast<void**>(pBlock) = Cache.pHead;
+            Cache.pHead = pBlock;
+            ++Cache.NumBlocks;
+        }
+    }
+
+    void FixedBlockMemoryAllocator::FlushThreadCache(ThreadCache& Cache, Uint32 NumBlocksToFlush)
+    {
+        VERIFY_EXPR(NumBlocksToFlush > 0 && NumBlocksToFlush <= Cache.NumBlocks);
+        // Relink the blocks through indices and release them to the global list with a single exchange
+        auto* pFirstBlock = Cache.pHead;
+        auto* pLastBlock  = pFirstBlock;
+        for (Uint32 b = 0; b < NumBlocksToFlush; ++b)
+        {
+            pLastBlock = Cache.pHead;
+            Cache.pHead = *reinterpret_cast<void**>(pLastBlock);
+            if (b + 1 < NumBlocksToFlush)
+                *reinterpret_cast<Uint32*>(pLastBlock) = GetBlockIndex(Cache.pHead);
+        }
+        Cache.NumBlocks -= NumBlocksToFlush;
+        PushGlobalBlocks(GetBlockIndex(pFirstBlock), pLastBlock);
+    }
+
+    void* FixedBlockMemoryAllocator::AllocateThreadCached()
+    {
+        void* pBlock = nullptr;
+        auto Slot = ThreadingTools::GetThreadSlot();
+        if (Slot < MaxThreadCaches)
+        {
+            auto& Cache = m_ThreadCaches[Slot];
+            if (Cache.NumBlocks == 0)
+                RefillThreadCache(Cache);
+            pBlock = Cache.pHead;
+            Cache.pHead = *reinterpret_cast<void**>(pBlock);
+            --Cache.NumBlocks;
+        }
+        else
+        {
+            // All cache slots are taken - use the global list directly
+            while ((pBlock = PopGlobalBlock()) == nullptr)
+                CreateAlignedPage();
+        }
+
+#ifdef _DEBUG
+        ++m_dbgNumAllocatedBlocks;
+#endif
+        FillWithDebugPattern(pBlock, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+        return pBlock;
+    }
+
+    void FixedBlockMemoryAllocator::FreeThreadCached(void* Ptr)
+    {
+#ifdef _DEBUG
+        GetBlockIndex(Ptr); // Verify the address
+        --m_dbgNumAllocatedBlocks;
+#endif
+        FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+        auto Slot = ThreadingTools::GetThreadSlot();
+        if (Slot < MaxThreadCaches)
+        {
+            auto& Cache = m_ThreadCaches[Slot];
+            *reinterpret_cast<void**>(Ptr) = Cache.pHead;
+            Cache.pHead = Ptr;
+            ++Cache.NumBlocks;
+            if (Cache.NumBlocks > ThreadCacheCapacity)
+                FlushThreadCache(Cache, ThreadCacheCapacity / 2);
+        }
+        else
+        {
+            PushGlobalBlocks(GetBlockIndex(Ptr), Ptr);
+        }
+    }
 }
@@ -0,0 +1,217 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <vector>
+#include "LockHelper.h"
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#   include <linux/futex.h>
+#   include <climits>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#   include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#   include <immintrin.h>
+#endif
+
+namespace ThreadingTools
+{
+
+namespace
+{
+
+inline void CpuPause()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__arm__) || defined(__aarch64__))
+    __asm__ __volatile__("yield");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+
+// Blocks the thread while the flag is equal to ExpectedValue
+inline void ParkThread(std::atomic<int>& Flag, int ExpectedValue)
+{
+    static_assert(sizeof(std::atomic<int>) == sizeof(int), "Futex requires atomic<int> to have the same layout as int");
+    syscall(SYS_futex, reinterpret_cast<int*>(&Flag), FUTEX_WAIT_PRIVATE, ExpectedValue, nullptr, nullptr, 0);
+}
+
+inline void UnparkThread(std::atomic<int>& Flag)
+{
+    syscall(SYS_futex, reinterpret_cast<int*>(&Flag), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+#else
+
+// Parking lot of condition variables shared by all flags. The flag address selects the slot.
+class ParkingLot
+{
+public:
+    static ParkingLot& Get()
+    {
+        static ParkingLot Lot;
+        return Lot;
+    }
+
+    void Park(std::atomic<int>& Flag, int ExpectedValue)
+    {
+        auto& Slot = GetSlot(Flag);
+        std::unique_lock<std::mutex> Lock(Slot.Mtx);
+        // The value is checked while holding the slot mutex, and UnparkThread() takes 
+        // the same mutex, so the wake-up cannot be lost
+        if (Flag.load(std::memory_order_relaxed) == ExpectedValue)
+            Slot.CondVar.wait(Lock);
+    }
+
+    void Unpark(std::atomic<int>& Flag)
+    {
+        auto& Slot = GetSlot(Flag);
+        {
+            std::lock_guard<std::mutex> Lock(Slot.Mtx);
+        }
+        // Threads parked on other flags may share the slot, so all of them are woken up
+        Slot.CondVar.notify_all();
+    }
+
+private:
+    struct Slot
+    {
+        std::mutex              Mtx;
+        std::condition_variable CondVar;
+    };
+
+    Slot& GetSlot(std::atomic<int>& Flag)
+    {
+        auto Addr = reinterpret_cast<size_t>(&Flag);
+        return m_Slots[(Addr >> 4) % NumSlots];
+    }
+
+    static constexpr size_t NumSlots = 64;
+    Slot m_Slots[NumSlots];
+};
+
+inline void ParkThread(std::atomic<int>& Flag, int ExpectedValue)
+{
+    ParkingLot::Get().Park(Flag, ExpectedValue);
+}
+
+inline void UnparkThread(std::atomic<int>& Flag)
+{
+    ParkingLot::Get().Unpark(Flag);
+}
+
+#endif
+
+class ThreadSlot
+{
+public:
+    static constexpr Diligent::Uint32 InvalidSlot = 0xFFFFFFFF;
+
+    ThreadSlot()
+    {
+        std::lock_guard<std::mutex> Lock(GetSlotPoolMutex());
+        auto& FreeSlots = GetFreeSlots();
+        if (!FreeSlots.empty())
+        {
+            m_Slot = FreeSlots.back();
+            FreeSlots.pop_back();
+        }
+        else
+            m_Slot = GetNextSlot()++;
+    }
+
+    ~ThreadSlot()
+    {
+        std::lock_guard<std::mutex> Lock(GetSlotPoolMutex());
+        GetFreeSlots().push_back(m_Slot);
+        m_Slot = InvalidSlot;
+    }
+
+    Diligent::Uint32 Get()const{return m_Slot;}
+
+private:
+    static std::mutex& GetSlotPoolMutex()
+    {
+        static std::mutex SlotPoolMutex;
+        return SlotPoolMutex;
+    }
+    static std::vector<Diligent::Uint32>& GetFreeSlots()
+    {
+        static std::vector<Diligent::Uint32> FreeSlots;
+        return FreeSlots;
+    }
+    static Diligent::Uint32& GetNextSlot()
+    {
+        static Diligent::Uint32 NextSlot = 0;
+        return NextSlot;
+    }
+
+    Diligent::Uint32 m_Slot = InvalidSlot;
+};
+
+}
+
+Diligent::Uint32 GetThreadSlot()
+{
+    static thread_local ThreadSlot Slot;
+    return Slot.Get();
+}
+
+void LockHelper::LockContended(LockFlag &LockFlag)
+{
+    // Spin with exponential backoff while the lock is likely to be released soon
+    static constexpr int MaxSpinCount = 64;
+    for (int SpinCount = 1; SpinCount <= MaxSpinCount; SpinCount *= 2)
+    {
+        for (int i = 0; i < SpinCount; ++i)
+            CpuPause();
+
+        if (LockFlag.m_Flag.load(std::memory_order_relaxed) == LockFlag::LOCK_FLAG_UNLOCKED && UnsafeTryLock(LockFlag))
+            return;
+    }
+
+    // Mark the flag as having waiters and park until it is released. Since the state of the flag 
+    // is unknown after waking up, the flag is always acquired in the locked-with-waiters state,
+    // which may only cause one unnecessary wake-up call.
+    while (LockFlag.m_Flag.exchange(LockFlag::LOCK_FLAG_LOCKED_WITH_WAITERS, std::memory_order_acquire) != LockFlag::LOCK_FLAG_UNLOCKED)
+    {
+        ParkThread(LockFlag.m_Flag, LockFlag::LOCK_FLAG_LOCKED_WITH_WAITERS);
+    }
+}
+
+void LockHelper::WakeWaiter(LockFlag &LockFlag)
+{
+    UnparkThread(LockFlag.m_Flag);
+}
+
+}
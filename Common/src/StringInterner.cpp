@@ -0,0 +1,167 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include <mutex>
+#include <vector>
+#include <unordered_set>
+#include "StringInterner.h"
+#include "STDAllocator.h"
+#include "FixedBlockMemoryAllocator.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+class StringInternerImpl
+{
+public:
+    static StringInternerImpl& Get()
+    {
+        static StringInternerImpl Interner;
+        return Interner;
+    }
+
+    // Returns the pointer to the interned copy of the string, or null if the string
+    // is not found and AddIfNotFound is false
+    const Char* Intern(const Char* Str, size_t Hash, bool AddIfNotFound)
+    {
+        auto& Shard = m_Shards[Hash % NumShards];
+        std::lock_guard<std::mutex> Lock(Shard.Mtx);
+        HashMapStringKey Key(Str);
+        auto it = Shard.Strings.find(Key);
+        if (it != Shard.Strings.end())
+            return it->GetStr();
+
+        if (!AddIfNotFound)
+            return nullptr;
+
+        auto* StrCopy = Shard.CopyString(Str);
+        Shard.Strings.emplace(StrCopy);
+        return StrCopy;
+    }
+
+    size_t GetNumStrings()
+    {
+        size_t NumStrings = 0;
+        for (auto& Shard : m_Shards)
+        {
+            std::lock_guard<std::mutex> Lock(Shard.Mtx);
+            NumStrings += Shard.Strings.size();
+        }
+        return NumStrings;
+    }
+
+private:
+    static constexpr size_t NumShards = 16;
+    static constexpr size_t ChunkSize = 4096;
+
+    struct Shard
+    {
+        Shard() :
+            Allocator(GetRawAllocator()),
+            Strings(0, std::hash<HashMapStringKey>(), std::equal_to<HashMapStringKey>(), STD_ALLOCATOR_RAW_MEM(HashMapStringKey, Allocator, "Allocator for unordered_set<HashMapStringKey>")),
+            Chunks(STD_ALLOCATOR_RAW_MEM(void*, Allocator, "Allocator for vector<void*>"))
+        {}
+
+        ~Shard()
+        {
+            // Keys do not own the strings, so they must be released before the chunks
+            Strings.clear();
+            for (auto* pChunk : Chunks)
+                Allocator.Free(pChunk);
+        }
+
+        Shard(const Shard&) = delete;
+        Shard& operator = (const Shard&) = delete;
+
+        const Char* CopyString(const Char* Str)
+        {
+            auto LenWithZeroTerm = strlen(Str) + 1;
+            Char* Dst = nullptr;
+            if (LenWithZeroTerm > ChunkSize / 4)
+            {
+                // Long strings get their own chunks so that little space is wasted
+                Dst = AllocateChunk(LenWithZeroTerm);
+                // Keep current chunk at the end
+                if (Chunks.size() > 1)
+                    std::swap(Chunks[Chunks.size() - 1], Chunks[Chunks.size() - 2]);
+            }
+            else
+            {
+                if (ChunkOffset + LenWithZeroTerm > ChunkSize)
+                {
+                    AllocateChunk(ChunkSize);
+                    ChunkOffset = 0;
+                }
+                Dst = reinterpret_cast<Char*>(Chunks.back()) + ChunkOffset;
+                ChunkOffset += LenWithZeroTerm;
+            }
+            memcpy(Dst, Str, LenWithZeroTerm);
+            return Dst;
+        }
+
+        Char* AllocateChunk(size_t Size)
+        {
+            auto* pChunk = Allocator.Allocate(Size, "String interner chunk", __FILE__, __LINE__);
+            Chunks.push_back(pChunk);
+            return reinterpret_cast<Char*>(pChunk);
+        }
+
+        IMemoryAllocator& Allocator;
+        std::mutex Mtx;
+        // Keys point to the strings in Chunks and do not own the memory
+        std::unordered_set<HashMapStringKey, std::hash<HashMapStringKey>, std::equal_to<HashMapStringKey>, STDAllocatorRawMem<HashMapStringKey>> Strings;
+        std::vector<void*, STDAllocatorRawMem<void*>> Chunks;
+        size_t ChunkOffset = ChunkSize;
+    };
+
+    Shard m_Shards[NumShards];
+};
+
+}
+
+InternedString StringInterner::Intern(const Char* Str)
+{
+    VERIFY(Str != nullptr, "String must not be null");
+    auto Hash = CStringHash<Char>()(Str);
+    auto* InternedStr = StringInternerImpl::Get().Intern(Str, Hash, true);
+    return InternedString{InternedStr, Hash};
+}
+
+InternedString StringInterner::Find(const Char* Str)
+{
+    VERIFY(Str != nullptr, "String must not be null");
+    auto Hash = CStringHash<Char>()(Str);
+    auto* InternedStr = StringInternerImpl::Get().Intern(Str, Hash, false);
+    return InternedStr != nullptr ? InternedString{InternedStr, Hash} : InternedString{};
+}
+
+size_t StringInterner::GetNumStrings()
+{
+    return StringInternerImpl::Get().GetNumStrings();
+}
+
+}
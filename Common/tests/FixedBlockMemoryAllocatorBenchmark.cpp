@@ -0,0 +1,102 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the multi-threaded throughput of FixedBlockMemoryAllocator in the default (mutex)
+// mode and in the thread-cached mode. Every thread keeps a window of live blocks and 
+// replaces them in a round-robin fashion, writing to every block to detect overlaps.
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "FixedBlockMemoryAllocator.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Timer.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr size_t BlockSize         = 64;
+static constexpr Uint32 NumBlocksInPage   = 256;
+static constexpr Uint32 NumLiveBlocks     = 128;
+static constexpr Uint32 NumOpsPerThread   = 200000;
+
+std::atomic<Uint32> NumCorruptedBlocks{0};
+
+void RunThread(FixedBlockMemoryAllocator& Allocator, Uint32 ThreadId)
+{
+    std::vector<void*> Blocks(NumLiveBlocks, nullptr);
+    for (Uint32 op = 0; op < NumOpsPerThread; ++op)
+    {
+        auto &pBlock = Blocks[op % NumLiveBlocks];
+        if (pBlock != nullptr)
+        {
+            if (*reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(pBlock) + sizeof(void*)) != ThreadId)
+                ++NumCorruptedBlocks;
+            Allocator.Free(pBlock);
+        }
+        pBlock = Allocator.Allocate(BlockSize, "Benchmark block", __FILE__, __LINE__);
+        *reinterpret_cast<Uint32*>(reinterpret_cast<Uint8*>(pBlock) + sizeof(void*)) = ThreadId;
+    }
+    for (auto *pBlock : Blocks)
+        Allocator.Free(pBlock);
+}
+
+double Run(bool ThreadCaching, Uint32 NumThreads)
+{
+    FixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), BlockSize, NumBlocksInPage, ThreadCaching);
+    std::vector<std::thread> Threads;
+    Timer timer;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        Threads.emplace_back(RunThread, std::ref(Allocator), t);
+    for (auto &Thread : Threads)
+        Thread.join();
+    auto ElapsedTime = timer.GetElapsedTime();
+    // Millions of allocate/free pairs per second
+    return static_cast<double>(NumOpsPerThread) * NumThreads / ElapsedTime * 1e-6;
+}
+
+}
+
+int main()
+{
+    std::cout << "FixedBlockMemoryAllocator throughput, millions of allocate/free pairs per second\n"
+              << "Threads      Mutex   Thread-cached\n";
+    for (Uint32 NumThreads = 1; NumThreads <= 8; NumThreads *= 2)
+    {
+        auto MutexRate  = Run(false, NumThreads);
+        auto CachedRate = Run(true,  NumThreads);
+        std::cout << std::setw(7) << NumThreads << std::fixed << std::setprecision(2)
+                  << std::setw(11) << MutexRate << std::setw(16) << CachedRate << '\n';
+    }
+
+    if (NumCorruptedBlocks != 0)
+    {
+        std::cerr << NumCorruptedBlocks << " block(s) were overwritten by another thread\n";
+        return 1;
+    }
+    return 0;
+}
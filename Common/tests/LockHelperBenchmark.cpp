@@ -0,0 +1,139 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the throughput of ThreadingTools::LockHelper with the yield-spinning lock it
+// replaced and with std::mutex. Every thread repeatedly increments a shared counter in
+// a short critical section and does some work outside of it. The test fails if any
+// increment is lost.
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include "LockHelper.h"
+#include "Timer.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr Uint32 NumOpsPerThread = 100000;
+static constexpr Uint32 NumWorkIterations = 50;
+
+int NumFailures = 0;
+
+// The lock that LockHelper used before: spin on the flag and yield the time slice after every failed attempt
+class YieldSpinLock
+{
+public:
+    void lock()
+    {
+        int Expected = 0;
+        while (!m_Flag.compare_exchange_weak(Expected, 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            Expected = 0;
+            std::this_thread::yield();
+        }
+    }
+    void unlock()
+    {
+        m_Flag.store(0, std::memory_order_release);
+    }
+
+private:
+    std::atomic<int> m_Flag{0};
+};
+
+class AdaptiveLock
+{
+public:
+    void lock()  {ThreadingTools::LockHelper::UnsafeLock(m_Flag);}
+    void unlock(){ThreadingTools::LockHelper::UnsafeUnlock(m_Flag);}
+
+private:
+    ThreadingTools::LockFlag m_Flag;
+};
+
+template<typename LockType>
+double Run(const char* Name, Uint32 NumThreads)
+{
+    LockType Lock;
+    Uint64 Counter = 0;
+    std::vector<std::thread> Threads;
+    Timer timer;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Lock, &Counter]()
+            {
+                volatile Uint32 Work = 0;
+                for (Uint32 op = 0; op < NumOpsPerThread; ++op)
+                {
+                    {
+                        std::lock_guard<LockType> Guard(Lock);
+                        ++Counter;
+                    }
+                    for (Uint32 i = 0; i < NumWorkIterations; ++i)
+                        Work = Work + i;
+                }
+            }
+        );
+    }
+    for (auto &Thread : Threads)
+        Thread.join();
+    auto ElapsedTime = timer.GetElapsedTime();
+
+    if (Counter != Uint64{NumOpsPerThread} * NumThreads)
+    {
+        std::cerr << Name << ": " << Uint64{NumOpsPerThread} * NumThreads - Counter << " increment(s) lost with " << NumThreads << " threads\n";
+        ++NumFailures;
+    }
+    // Millions of lock/unlock pairs per second
+    return static_cast<double>(NumOpsPerThread) * NumThreads / ElapsedTime * 1e-6;
+}
+
+}
+
+int main()
+{
+    std::cout << "Lock throughput, millions of lock/unlock pairs per second\n"
+              << "Threads Yield-spin  LockHelper  std::mutex\n";
+    for (Uint32 NumThreads = 1; NumThreads <= 8; NumThreads *= 2)
+    {
+        auto YieldSpinRate = Run<YieldSpinLock>("Yield-spin lock", NumThreads);
+        auto AdaptiveRate  = Run<AdaptiveLock> ("LockHelper",      NumThreads);
+        auto MutexRate     = Run<std::mutex>   ("std::mutex",      NumThreads);
+        std::cout << std::setw(7) << NumThreads << std::fixed << std::setprecision(2)
+                  << std::setw(11) << YieldSpinRate << std::setw(12) << AdaptiveRate << std::setw(12) << MutexRate << '\n';
+    }
+
+    if (NumFailures != 0)
+    {
+        std::cerr << NumFailures << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
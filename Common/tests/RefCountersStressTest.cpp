@@ -0,0 +1,260 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Stress test for the lock-free reference counters. Several threads concurrently add and
+// release strong references, lock and release weak references to a shared object, and
+// release the last strong reference at the same time. The test verifies that every object
+// is destroyed exactly once, that a locked weak pointer never returns a destroyed object,
+// and that weak pointers are null once the object has been destroyed. It also covers
+// A ==sp==> B --wp--> A cycles and constructors that throw while holding a weak pointer
+// to the object itself.
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdexcept>
+#include "ObjectBase.h"
+#include "RefCntAutoPtr.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr Uint32 NumThreads     = 4;
+static constexpr Uint32 NumIterations  = 2000;
+static constexpr Uint32 NumOpsPerPhase = 50;
+
+std::atomic<Int32>  NumLiveObjects{0};
+std::atomic<Uint32> NumErrors{0};
+
+void ReportError(const char* Msg)
+{
+    if (NumErrors.fetch_add(1) < 10)
+        std::cerr << Msg << '\n';
+}
+
+class TestObject : public ObjectBase<IObject>
+{
+public:
+    static constexpr Uint32 AliveMagic     = 0x600DF00D;
+    static constexpr Uint32 DestroyedMagic = 0xDEADBEEF;
+
+    TestObject(IReferenceCounters* pRefCounters) : 
+        ObjectBase<IObject>(pRefCounters)
+    {
+        ++NumLiveObjects;
+    }
+
+    ~TestObject()
+    {
+        if (m_Magic != AliveMagic)
+            ReportError("Object is destroyed more than once");
+        m_Magic = DestroyedMagic;
+        --NumLiveObjects;
+    }
+
+    void Check()const
+    {
+        if (m_Magic != AliveMagic)
+            ReportError("Reference to a destroyed object was obtained");
+    }
+
+    // A ==sp==> B --wp--> A
+    RefCntAutoPtr<TestObject> pStrongRef;
+    RefCntWeakPtr<TestObject> pWeakRef;
+
+private:
+    volatile Uint32 m_Magic = AliveMagic;
+};
+
+class ThrowingObject : public ObjectBase<IObject>
+{
+public:
+    ThrowingObject(IReferenceCounters* pRefCounters) : 
+        ObjectBase<IObject>(pRefCounters),
+        m_pSelf(this)
+    {
+        throw std::runtime_error("Test exception");
+    }
+
+private:
+    RefCntWeakPtr<ThrowingObject> m_pSelf;
+};
+
+// Reusable barrier that synchronizes the worker threads with the main thread
+class Barrier
+{
+public:
+    explicit Barrier(Uint32 NumThreads) : m_NumThreads(NumThreads) {}
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> Lock(m_Mutex);
+        auto Generation = m_Generation;
+        if (++m_NumWaiting == m_NumThreads)
+        {
+            m_NumWaiting = 0;
+            ++m_Generation;
+            m_CondVar.notify_all();
+        }
+        else
+            m_CondVar.wait(Lock, [&]{return Generation != m_Generation;});
+    }
+
+private:
+    std::mutex              m_Mutex;
+    std::condition_variable m_CondVar;
+    const Uint32            m_NumThreads;
+    Uint32                  m_NumWaiting = 0;
+    Uint32                  m_Generation = 0;
+};
+
+struct ThreadData
+{
+    // Thread 0 only holds a weak reference and races its Lock() with the release of the strong references
+    RefCntAutoPtr<TestObject> pObject;
+    RefCntWeakPtr<TestObject> pWeakObject;
+    // Weak reference through the cycle: pObject ==sp==> B --wp--> pObject
+    RefCntWeakPtr<TestObject> pCycleObject;
+};
+
+void WorkerThread(ThreadData& Data, Barrier& SyncBarrier)
+{
+    for (Uint32 it = 0; it < NumIterations; ++it)
+    {
+        // Wait until the main thread has set up the objects
+        SyncBarrier.Wait();
+
+        for (Uint32 op = 0; op < NumOpsPerPhase; ++op)
+        {
+            if (Data.pObject)
+            {
+                // Copy and release the strong reference
+                RefCntAutoPtr<TestObject> pCopy(Data.pObject);
+                pCopy->Check();
+                // The object must be alive while this thread holds a strong reference
+                auto pLocked = Data.pWeakObject.Lock();
+                if (!pLocked)
+                    ReportError("Weak pointer is null while a strong reference is held");
+            }
+            else
+            {
+                auto pLocked = Data.pWeakObject.Lock();
+                if (pLocked)
+                    pLocked->Check();
+            }
+            auto pCycleLocked = Data.pCycleObject.Lock();
+            if (pCycleLocked)
+                pCycleLocked->Check();
+        }
+
+        // Release the strong reference. One of the threads destroys the object.
+        Data.pObject.Release();
+        for (Uint32 op = 0; op < NumOpsPerPhase; ++op)
+        {
+            auto pLocked = Data.pWeakObject.Lock();
+            if (pLocked)
+                pLocked->Check();
+        }
+
+        // Wait until all strong references have been released
+        SyncBarrier.Wait();
+
+        if (Data.pWeakObject.Lock() || Data.pCycleObject.Lock())
+            ReportError("Weak pointer is not null after the object has been destroyed");
+        Data.pWeakObject.Release();
+        Data.pCycleObject.Release();
+
+        // Let the main thread set up the next iteration
+        SyncBarrier.Wait();
+    }
+}
+
+void TestThrowingConstructor()
+{
+    for (Uint32 i = 0; i < 100; ++i)
+    {
+        try
+        {
+            RefCntAutoPtr<ThrowingObject> pObj{MakeNewRCObj<ThrowingObject>()()};
+            ReportError("Exception was not propagated from the constructor");
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+}
+
+}
+
+int main()
+{
+    TestThrowingConstructor();
+
+    std::vector<ThreadData> Data(NumThreads);
+    // The main thread participates in the barrier
+    Barrier SyncBarrier(NumThreads + 1);
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        Threads.emplace_back(WorkerThread, std::ref(Data[t]), std::ref(SyncBarrier));
+
+    for (Uint32 it = 0; it < NumIterations; ++it)
+    {
+        {
+            RefCntAutoPtr<TestObject> pObject{MakeNewRCObj<TestObject>()()};
+            RefCntAutoPtr<TestObject> pCycleObject{MakeNewRCObj<TestObject>()()};
+            pObject->pStrongRef = pCycleObject;
+            pCycleObject->pWeakRef = RefCntWeakPtr<TestObject>(pObject);
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                if (t != 0)
+                    Data[t].pObject = pObject;
+                Data[t].pWeakObject  = RefCntWeakPtr<TestObject>(pObject);
+                Data[t].pCycleObject = RefCntWeakPtr<TestObject>(pCycleObject);
+            }
+            // Only the worker threads hold strong references now
+        }
+        SyncBarrier.Wait();
+        SyncBarrier.Wait();
+        SyncBarrier.Wait();
+    }
+    for (auto &Thread : Threads)
+        Thread.join();
+
+    if (NumLiveObjects != 0)
+    {
+        std::cerr << NumLiveObjects << " object(s) have not been destroyed\n";
+        ++NumErrors;
+    }
+    if (NumErrors != 0)
+    {
+        std::cerr << NumErrors << " error(s) detected\n";
+        return 1;
+    }
+    std::cout << "Reference counters stress test passed (" << NumIterations << " iterations, " << NumThreads << " threads)\n";
+    return 0;
+}
@@ -284,8 +284,7 @@ protected:
                     Uint32              NumACs, 
                     Uint32              NumSepImgs, 
                     Uint32              NumSepSmpls, 
-                    Uint32              NumStaticSamplers,
-                    size_t              ResourceNamesPoolSize);
+                    Uint32              NumStaticSamplers);
 
     __forceinline SPIRVShaderResourceAttribs& GetResAttribs(Uint32 n, Uint32 NumResources, Uint32 Offset)noexcept
     {
@@ -318,8 +317,12 @@ protected:
 
 private:
     // Memory buffer that holds all resources as continuous chunk of memory:
-    // |  UBs  |  SBs  |  StrgImgs  |  SmplImgs  |  ACs  |  SepImgs  |  SepSamplers  | Static Samplers |   Resource Names   |
+    // |  UBs  |  SBs  |  StrgImgs  |  SmplImgs  |  ACs  |  SepImgs  |  SepSamplers  | Static Samplers |
     std::unique_ptr< void, STDDeleterRawMem<void> > m_MemoryBuffer;
+
+    // Resource names are stored in a separate growable pool, so that resources can be
+    // reflected in a single pass.
+    static constexpr size_t ResourceNamesBlockSize = 512;
     StringPool m_ResourceNames;
 
     using OffsetType = Uint16;
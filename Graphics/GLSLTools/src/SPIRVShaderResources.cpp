@@ -92,6 +92,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&         Allocator,
                                            std::vector<uint32_t>     spirv_binary,
                                            const ShaderDesc&         shaderDesc) :
     m_MemoryBuffer(nullptr, STDDeleterRawMem<void>(Allocator)),
+    m_ResourceNames(Allocator, ResourceNamesBlockSize),
     m_ShaderType(shaderDesc.ShaderType)
 {
     // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
@@ -100,22 +101,6 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&         Allocator,
     // The SPIR-V is now parsed, and we can perform reflection on it.
     spirv_cross::ShaderResources resources = Compiler.get_shader_resources();
 
-    size_t ResourceNamesPoolSize = 0;
-    for(auto *pResType : 
-        {
-            &resources.uniform_buffers,
-            &resources.storage_buffers,
-            &resources.storage_images,
-            &resources.sampled_images,
-            &resources.atomic_counters,
-            &resources.separate_images,
-            &resources.separate_samplers
-        })
-    {
-        for(const auto &res : *pResType)
-            ResourceNamesPoolSize += res.name.length() + 1;
-    }
-
     Initialize(Allocator, 
                static_cast<Uint32>(resources.uniform_buffers.size()),
                static_cast<Uint32>(resources.storage_buffers.size()),
@@ -124,8 +109,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&         Allocator,
                static_cast<Uint32>(resources.atomic_counters.size()),
                static_cast<Uint32>(resources.separate_images.size()),
                static_cast<Uint32>(resources.separate_samplers.size()),
-               shaderDesc.NumStaticSamplers,
-               ResourceNamesPoolSize);
+               shaderDesc.NumStaticSamplers);
 
     {
         Uint32 CurrUB = 0;
@@ -242,8 +226,6 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&         Allocator,
         VERIFY_EXPR(CurrSepSmpl == GetNumSepSmpls());
     }
 
-    VERIFY(m_ResourceNames.GetRemainingSize() == 0, "Names pool must be empty");
-
     for (Uint32 s = 0; s < m_NumStaticSamplers; ++s)
     {
         SamplerPtrType &pStaticSampler = GetStaticSampler(s);
@@ -324,8 +306,7 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator& Allocator,
                                       Uint32            NumACs,
                                       Uint32            NumSepImgs, 
                                       Uint32            NumSepSmpls, 
-                                      Uint32            NumStaticSamplers,
-                                      size_t            ResourceNamesPoolSize)
+                                      Uint32            NumStaticSamplers)
 {
     VERIFY(&m_MemoryBuffer.get_deleter().m_Allocator == &Allocator, "Incosistent allocators provided");
 
@@ -359,8 +340,7 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator& Allocator,
     static_assert(sizeof(SPIRVShaderResourceAttribs) % sizeof(void*) == 0, "Size of SPIRVShaderResourceAttribs struct must be multiple of sizeof(void*)");
     static_assert(sizeof(SamplerPtrType) % sizeof(void*) == 0, "Size of SamplerPtrType must be multiple of sizeof(void*)");
     auto MemorySize = m_TotalResources * sizeof(SPIRVShaderResourceAttribs) + 
-                      m_NumStaticSamplers * sizeof(SamplerPtrType) +
-                      ResourceNamesPoolSize * sizeof(char);
+                      m_NumStaticSamplers * sizeof(SamplerPtrType);
 
     VERIFY_EXPR(GetNumUBs()      == NumUBs);
     VERIFY_EXPR(GetNumSBs()      == NumSBs);
@@ -374,10 +354,6 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator& Allocator,
     {
         auto *pRawMem = Allocator.Allocate(MemorySize, "Memory for shader resources", __FILE__, __LINE__);
         m_MemoryBuffer.reset(pRawMem);
-        char* NamesPool = reinterpret_cast<char*>(m_MemoryBuffer.get()) + 
-                          m_TotalResources * sizeof(SPIRVShaderResourceAttribs) +
-                          m_NumStaticSamplers * sizeof(SamplerPtrType);
-        m_ResourceNames.AssignMemory(NamesPool, ResourceNamesPoolSize);
     }
 }
 
@@ -0,0 +1,157 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+
+#include <deque>
+#include <atomic>
+#include "MemoryAllocator.h"
+#include "STDAllocator.h"
+#include "DebugUtilities.h"
+
+namespace Diligent
+{
+    /// Implementation of a ring buffer that allows allocating space from multiple threads
+
+    /// \remarks Allocate() is lock-free and can be called by any number of threads simultaneously.
+    ///          FinishCurrentFrame() and ReleaseCompletedFrames() must be externally synchronized
+    ///          with each other, but may run concurrently with Allocate().
+    ///
+    ///          Head and tail are kept as monotonically increasing 64-bit positions, the offset in the
+    ///          buffer being the position modulo the buffer size. Every frame tail thus uniquely identifies 
+    ///          the amount of space to release, and there is no need to track frame sizes like RingBuffer does.
+    class ConcurrentRingBuffer
+    {
+    public:
+        typedef size_t OffsetType;
+        struct FrameTailAttribs
+        {
+            FrameTailAttribs(Uint64 fv, Uint64 pos) : 
+                FenceValue(fv),
+                Position(pos)
+            {}
+
+            // Fence value associated with the command list in which 
+            // the allocation could have been referenced last time
+            Uint64 FenceValue;
+            // Tail position at the end of the frame
+            Uint64 Position;
+        };
+        static const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+        ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator &Allocator)noexcept : 
+            m_CompletedFrameTails(0, FrameTailAttribs(0,0), STD_ALLOCATOR_RAW_MEM(FrameTailAttribs, Allocator, "Allocator for deque<FrameTailAttribs>" )),
+            m_MaxSize(MaxSize)
+        {}
+
+        ConcurrentRingBuffer             (const ConcurrentRingBuffer&) = delete;
+        ConcurrentRingBuffer             (ConcurrentRingBuffer&&)      = delete;
+        ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&) = delete;
+        ConcurrentRingBuffer& operator = (ConcurrentRingBuffer&&)      = delete;
+
+        ~ConcurrentRingBuffer()
+        {
+            VERIFY(IsEmpty(), "All space in the ring buffer must be released");
+        }
+
+        OffsetType Allocate(OffsetType Size)
+        {
+            VERIFY_EXPR(Size > 0);
+            if (Size > m_MaxSize)
+                return InvalidOffset;
+
+            auto Tail = m_Tail.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                auto Start = Tail;
+                auto Offset = static_cast<OffsetType>(Start % m_MaxSize);
+                if (Offset + Size > m_MaxSize)
+                {
+                    // The allocation does not fit into the remaining space at the end 
+                    // of the buffer. Skip this space and allocate from the beginning.
+                    //
+                    //       Head             Tail   MaxSize
+                    //       |                |      |
+                    //  [    xxxxxxxxxxxxxxxxx.......]
+                    //
+                    Start += m_MaxSize - Offset;
+                    Offset = 0;
+                }
+
+                // Head only moves forward, so stale value may only cause spurious failure
+                auto Head = m_Head.load(std::memory_order_acquire);
+                if (Start + Size - Head > m_MaxSize)
+                    return InvalidOffset;
+
+                if (m_Tail.compare_exchange_weak(Tail, Start + Size, std::memory_order_relaxed, std::memory_order_relaxed))
+                    return Offset;
+            }
+        }
+
+        // FenceValue is the fence value associated with the command list in which the tail
+        // could have been referenced last time. Allocations that complete after the tail has been 
+        // read belong to the next frame.
+        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        void FinishCurrentFrame(Uint64 FenceValue)
+        {
+            m_CompletedFrameTails.emplace_back(FenceValue, m_Tail.load(std::memory_order_relaxed));
+        }
+
+        // CompletedFenceValue indicates GPU progress
+        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+        {
+            // We can release all tails whose associated fence value is less than or equal to CompletedFenceValue
+            while(!m_CompletedFrameTails.empty() && m_CompletedFrameTails.front().FenceValue <= CompletedFenceValue)
+            {
+                const auto &OldestFrameTail = m_CompletedFrameTails.front();
+                VERIFY_EXPR(OldestFrameTail.Position >= m_Head.load(std::memory_order_relaxed));
+                m_Head.store(OldestFrameTail.Position, std::memory_order_release);
+                m_CompletedFrameTails.pop_front();
+            }
+        }
+
+        OffsetType GetMaxSize()const{return m_MaxSize;}
+        bool IsFull()const{ return GetUsedSize()==m_MaxSize; };
+        bool IsEmpty()const{ return GetUsedSize()==0; };
+        OffsetType GetUsedSize()const
+        {
+            auto Head = m_Head.load(std::memory_order_acquire);
+            auto Tail = m_Tail.load(std::memory_order_relaxed);
+            return static_cast<OffsetType>(Tail - Head);
+        }
+
+    private:
+        std::deque< FrameTailAttribs, STDAllocatorRawMem<FrameTailAttribs> > m_CompletedFrameTails;
+        const OffsetType m_MaxSize;
+
+        // Keep head and tail in different cache lines as they are modified by different threads
+        std::atomic<Uint64> m_Head{0};
+        Uint8               m_Padding[64 - sizeof(std::atomic<Uint64>)];
+        std::atomic<Uint64> m_Tail{0};
+    };
+}
@@ -131,6 +131,17 @@ const Char* GetValueTypeString( VALUE_TYPE Val );
 ///         format attributes.
 const TextureFormatAttribs& GetTextureFormatAttribs(TEXTURE_FORMAT Format);
 
+/// Returns the size of one texel in bytes or, for block-compressed formats, the size of one compressed block
+
+/// \remarks For compressed formats, ComponentSize is already the block size, and NumComponents 
+///          must not be taken into account.
+inline Uint32 GetTexelBlockSize(const TextureFormatAttribs &FmtAttribs)
+{
+    return FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? 
+        Uint32{FmtAttribs.ComponentSize} : 
+        Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+}
+
 /// Returns the default format for a specified texture view type
 
 /// The default view is defined as follows:
@@ -32,79 +32,144 @@
 #include <mutex>
 #include <deque>
 #include <memory>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <cstddef>
 
 #include "MemoryAllocator.h"
 #include "STDAllocator.h"
+#include "FixedBlockMemoryAllocator.h"
 #include "DebugUtilities.h"
 
 namespace Diligent
 {
 
 /// Helper class that wraps stale resources of different types
+
+/// Resources that fit into the wrapper's inline storage are moved directly into it, so that
+/// wrapping a resource does not require memory allocation. Only resources that are larger than
+/// InlineStorageSize or that cannot be moved without throwing are allocated on the heap.
 class DynamicStaleResourceWrapper
 {
 public:
-    //   ___________________________                                  ___________________________
-    //  |DynamicStaleResourceWrapper|                                |DynamicStaleResourceWrapper|
-    //  |                           |                                |                           |
-    //  |   m_pStaleResource        |                                |   m_pStaleResource        |
-    //  |__________|________________|                                |__________|________________|
-    //             |                                                            |
-    //             |                                                            |
-    //             |                                                            |
-    //   __________V___________________________________               __________V___________________________________
-    //  |SpecificStaleResource<VulkanBufferWrapper>    |             |SpecificStaleResource<VulkanMemoryAllocation> |
-    //  |                                              |             |                                              |
-    //  |  VulkanBufferWrapper m_SpecificResource;     |             |  VulkanMemoryAllocation m_SpecificResource;  |
-    //  |______________________________________________|             |______________________________________________|
+    //   ______________________________________               ______________________________________
+    //  |DynamicStaleResourceWrapper           |             |DynamicStaleResourceWrapper           |
+    //  |                                      |             |                                      |
+    //  |  m_pOps: Ops<VulkanBufferWrapper>    |             |  m_pOps: Ops<unique_ptr<LargeType>>  |
+    //  |  m_Storage:                          |             |  m_Storage:                          |
+    //  |    VulkanBufferWrapper               |             |    unique_ptr<LargeType>             |
+    //  |______________________________________|             |_______________|______________________|
+    //                                                                        |
+    //                                                                        V
+    //                                                                    LargeType
     //
 
+    static constexpr size_t InlineStorageSize = 4 * sizeof(void*);
+
     template<typename ResourceType>
     static DynamicStaleResourceWrapper Create(ResourceType&& Resource)
     {
-        class SpecificStaleResource : public StaleResourceBase
-        {
-        public:
-            SpecificStaleResource(ResourceType&& SpecificResource) :
-                m_SpecificResource(std::move(SpecificResource))
-            {}
-
-            SpecificStaleResource             (const SpecificStaleResource&) = delete;
-            SpecificStaleResource             (SpecificStaleResource&&)      = delete;
-            SpecificStaleResource& operator = (const SpecificStaleResource&) = delete;
-            SpecificStaleResource& operator = (SpecificStaleResource&&)      = delete;
-
-        private:
-            ResourceType m_SpecificResource;
-        };
-        return DynamicStaleResourceWrapper{new SpecificStaleResource{std::move(Resource)}};
+        using SpecificResourceType = typename std::decay<ResourceType>::type;
+        return CreateSpecific<SpecificResourceType>(std::move(Resource), std::integral_constant<bool, IsStoredInline<SpecificResourceType>()>{});
     }
 
     DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs)noexcept :
-        m_pStaleResource(std::move(rhs.m_pStaleResource))
-    {}
+        m_pOps(rhs.m_pOps)
+    {
+        // The moved-from resource is destroyed by rhs
+        if (m_pOps != nullptr)
+            m_pOps->MoveConstruct(&m_Storage, &rhs.m_Storage);
+    }
 
     DynamicStaleResourceWrapper& operator = (DynamicStaleResourceWrapper&& rhs)noexcept
     {
-        m_pStaleResource = std::move(rhs.m_pStaleResource);
+        if (this != &rhs)
+        {
+            Reset();
+            m_pOps = rhs.m_pOps;
+            if (m_pOps != nullptr)
+                m_pOps->MoveConstruct(&m_Storage, &rhs.m_Storage);
+        }
         return *this;
     }
 
     DynamicStaleResourceWrapper             (const DynamicStaleResourceWrapper&) = delete;
     DynamicStaleResourceWrapper& operator = (const DynamicStaleResourceWrapper&) = delete;
 
+    ~DynamicStaleResourceWrapper()
+    {
+        Reset();
+    }
+
 private:
-    class StaleResourceBase
+    // Type-erased operations on the resource kept in the inline storage
+    struct ResourceOps
     {
-    public:
-        virtual ~StaleResourceBase() = 0 {}
+        void (*MoveConstruct)(void* pDst, void* pSrc);
+        void (*Destroy)      (void* pResource);
     };
 
-    DynamicStaleResourceWrapper(StaleResourceBase *pStaleResource) :
-        m_pStaleResource(pStaleResource)
-    {}
+    template<typename SpecificResourceType>
+    struct SpecificResourceOps
+    {
+        static void MoveConstruct(void* pDst, void* pSrc)
+        {
+            new(pDst) SpecificResourceType(std::move(*reinterpret_cast<SpecificResourceType*>(pSrc)));
+        }
+
+        static void Destroy(void* pResource)
+        {
+            reinterpret_cast<SpecificResourceType*>(pResource)->~SpecificResourceType();
+        }
+
+        static const ResourceOps* Get()
+        {
+            static const ResourceOps Ops = {&MoveConstruct, &Destroy};
+            return &Ops;
+        }
+    };
+
+    using StorageType = typename std::aligned_storage<InlineStorageSize, alignof(std::max_align_t)>::type;
+
+    template<typename SpecificResourceType>
+    static constexpr bool IsStoredInline()
+    {
+        return sizeof(SpecificResourceType)  <= sizeof(StorageType)  &&
+               alignof(SpecificResourceType) <= alignof(StorageType) &&
+               std::is_nothrow_move_constructible<SpecificResourceType>::value;
+    }
+
+    DynamicStaleResourceWrapper() = default;
+
+    template<typename SpecificResourceType>
+    static DynamicStaleResourceWrapper CreateSpecific(SpecificResourceType&& Resource, std::true_type /*StoredInline*/)
+    {
+        DynamicStaleResourceWrapper Wrapper;
+        new(&Wrapper.m_Storage) SpecificResourceType(std::move(Resource));
+        Wrapper.m_pOps = SpecificResourceOps<SpecificResourceType>::Get();
+        return Wrapper;
+    }
+
+    template<typename SpecificResourceType>
+    static DynamicStaleResourceWrapper CreateSpecific(SpecificResourceType&& Resource, std::false_type /*StoredInline*/)
+    {
+        using HeapResourcePtr = std::unique_ptr<SpecificResourceType>;
+        static_assert(IsStoredInline<HeapResourcePtr>(), "Pointer to the resource must fit into the inline storage");
+        return CreateSpecific<HeapResourcePtr>(HeapResourcePtr{new SpecificResourceType{std::move(Resource)}}, std::true_type{});
+    }
 
-    std::unique_ptr<StaleResourceBase> m_pStaleResource;
+    void Reset()
+    {
+        if (m_pOps != nullptr)
+        {
+            m_pOps->Destroy(&m_Storage);
+            m_pOps = nullptr;
+        }
+    }
+
+    const ResourceOps* m_pOps = nullptr;
+    StorageType        m_Storage;
 };
 
 /// Helper class that wraps stale resources of the same type
@@ -148,6 +213,10 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Releasing a resource does not take a lock: stale objects are pushed to a lock-free multi-producer
+/// list, and nodes of the list come from the thread-cached fixed block allocator, so that every thread
+/// obtains and returns nodes in batches. DiscardStaleResources() and Purge() are serialized by a mutex.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template<typename ResourceWrapperType>
 class ResourceReleaseQueue
@@ -155,23 +224,32 @@ class ResourceReleaseQueue
 public:
     ResourceReleaseQueue(IMemoryAllocator& Allocator) : 
         m_ReleaseQueue(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_StaleNodeAllocator(Allocator, sizeof(StaleResourceNode), 256, true)
     {}
 
     ~ResourceReleaseQueue()
     {
-        VERIFY(m_StaleResources.empty(), "Not all stale objects were destroyed");
+        VERIFY(m_NumStaleResources == 0, "Not all stale objects were destroyed");
         VERIFY(m_ReleaseQueue.empty(), "Release queue is not empty");
+        DestroyNodeList(m_pStaleListHead.exchange(nullptr));
+        DestroyNodeList(m_pPendingStaleHead);
     }
 
     /// Moves resource to the release queue
     /// \param [in] Resource              - Resource to be released
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
+    ///
+    /// \remarks This method is lock-free and can be called by multiple threads simultaneously
     template<typename ResourceType>
     void SafeReleaseResource(ResourceType&& Resource, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, ResourceWrapperType::Create(std::move(Resource)) );
+        auto* pNodeMem = m_StaleNodeAllocator.Allocate(sizeof(StaleResourceNode), "Stale resource node", __FILE__, __LINE__);
+        auto* pNode = new(pNodeMem) StaleResourceNode{NextCommandListNumber, ResourceWrapperType::Create(std::move(Resource))};
+        m_NumStaleResources.fetch_add(1, std::memory_order_relaxed);
+
+        pNode->pNext = m_pStaleListHead.load(std::memory_order_relaxed);
+        while (!m_pStaleListHead.compare_exchange_weak(pNode->pNext, pNode, std::memory_order_release, std::memory_order_relaxed))
+            ;
     }
 
 
@@ -184,21 +262,52 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
-        // Only discard these stale objects that were released before CmdBuffNumber
-        // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty() )
+
+        // Take all nodes pushed so far and append them to the pending list in release order
+        auto* pNode = m_pStaleListHead.exchange(nullptr, std::memory_order_acquire);
+        StaleResourceNode* pReversed = nullptr;
+        StaleResourceNode* pLast     = pNode;
+        while (pNode != nullptr)
+        {
+            auto* pNext = pNode->pNext;
+            pNode->pNext = pReversed;
+            pReversed = pNode;
+            pNode = pNext;
+        }
+        if (pReversed != nullptr)
         {
-            auto &FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
+            if (m_pPendingStaleTail != nullptr)
+                m_pPendingStaleTail->pNext = pReversed;
+            else
+                m_pPendingStaleHead = pReversed;
+            m_pPendingStaleTail = pLast;
+        }
+
+        // Only discard these stale objects that were released before CmdBuffNumber
+        // was executed. Since threads do not synchronize when they release resources, 
+        // command list numbers in the list are not necessarily ordered and the whole
+        // list needs to be checked.
+        size_t NumDiscarded = 0;
+        StaleResourceNode** ppNode = &m_pPendingStaleHead;
+        m_pPendingStaleTail = nullptr;
+        while (*ppNode != nullptr)
+        {
+            auto* pCurrNode = *ppNode;
+            if (pCurrNode->CmdListNumber <= SubmittedCmdBuffNumber)
             {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
-                m_StaleResources.pop_front();
+                *ppNode = pCurrNode->pNext;
+                m_ReleaseQueue.emplace_back(FenceValue, std::move(pCurrNode->Resource));
+                DestroyNode(pCurrNode);
+                ++NumDiscarded;
+            }
+            else
+            {
+                m_pPendingStaleTail = pCurrNode;
+                ppNode = &pCurrNode->pNext;
             }
-            else 
-                break;
         }
+        m_NumStaleResources.fetch_sub(NumDiscarded, std::memory_order_relaxed);
     }
 
 
@@ -224,7 +333,7 @@ public:
     /// Returns the number of stale resources
     size_t GetStaleResourceCount()const
     {
-        return m_StaleResources.size();
+        return m_NumStaleResources.load(std::memory_order_relaxed);
     }
 
     /// Returns the number of resources pending release
@@ -234,13 +343,47 @@ public:
     }
 
 private:
+    struct StaleResourceNode
+    {
+        StaleResourceNode(Uint64 _CmdListNumber, ResourceWrapperType&& _Resource) :
+            CmdListNumber(_CmdListNumber),
+            Resource     (std::move(_Resource))
+        {}
+
+        const Uint64        CmdListNumber;
+        ResourceWrapperType Resource;
+        StaleResourceNode*  pNext = nullptr;
+    };
+
+    void DestroyNode(StaleResourceNode* pNode)
+    {
+        pNode->~StaleResourceNode();
+        m_StaleNodeAllocator.Free(pNode);
+    }
+
+    void DestroyNodeList(StaleResourceNode* pNode)
+    {
+        while (pNode != nullptr)
+        {
+            auto* pNext = pNode->pNext;
+            DestroyNode(pNode);
+            pNode = pNext;
+        }
+    }
 
     std::mutex m_ReleaseQueueMutex;
     using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
     std::deque< ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType> > m_ReleaseQueue;
 
-    std::mutex m_StaleObjectsMutex;
-    std::deque< ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType> > m_StaleResources;
+    FixedBlockMemoryAllocator m_StaleNodeAllocator;
+
+    // Lock-free list of released resources in reverse release order
+    std::atomic<StaleResourceNode*> m_pStaleListHead{nullptr};
+    // Stale resources that were taken from the lock-free list but whose command lists 
+    // have not been submitted yet. Protected by m_ReleaseQueueMutex.
+    StaleResourceNode* m_pPendingStaleHead = nullptr;
+    StaleResourceNode* m_pPendingStaleTail = nullptr;
+    std::atomic<size_t> m_NumStaleResources{0};
 };
 
 }
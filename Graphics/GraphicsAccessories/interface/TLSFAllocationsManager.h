@@ -0,0 +1,515 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Two-level segregated fit (TLSF) allocations manager. 
+// See M. Masmano, I. Ripoll, A. Crespo, J. Real "TLSF: a New Dynamic Memory Allocator for Real-Time Systems"
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include "MemoryAllocator.h"
+#include "STDAllocator.h"
+#include "DebugUtilities.h"
+#include "PlatformMisc.h"
+
+namespace Diligent
+{
+    // The class has the same interface as VariableSizeAllocationsManager, but allocates and releases 
+    // blocks in constant time. Free blocks are kept in segregated lists indexed by a two-level bitmap: 
+    // the first level splits block sizes into power-of-two ranges, the second level linearly subdivides 
+    // every range into 32 classes. Allocation rounds the requested size up to the next class, so that
+    // any block from the first non-empty list found by the bitmap search is large enough.
+    //
+    //   m_FLBitmap     0 0 1 0 0 1 ...
+    //                      |     |
+    //   m_SLBitmaps[fl]    |    0 1 0 ... 0 1
+    //                      |      |         |
+    //   m_FreeLists[fl][sl]|     [N3]      [N7]<->[N1]
+    //                      |
+    //                     0 0 1 ...
+    //                         |
+    //                        [N0]<->[N5]
+    //
+    // Since the managed memory is generally not CPU-accessible, block descriptors are kept in a separate
+    // node pool. Allocated blocks are not tracked at all; free blocks are found by their start and end
+    // offsets through an open-addressing hash table, which enables merging with adjacent blocks.
+    // The node pool and the hash table only grow when the number of free blocks exceeds their 
+    // capacity, so no heap operations are performed in the steady state.
+    class TLSFAllocationsManager
+    {
+    public:
+        typedef size_t OffsetType;
+        static constexpr OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    private:
+        static constexpr Uint32 SLBits      = 5;
+        static constexpr Uint32 SLCount     = 1 << SLBits;
+        static constexpr Uint32 FLCount     = sizeof(OffsetType) * 8 - SLBits + 1;
+        static constexpr Uint32 InvalidNode = static_cast<Uint32>(-1);
+
+        struct FreeBlockNode
+        {
+            OffsetType Offset   = 0;
+            OffsetType Size     = 0;
+            Uint32     PrevFree = InvalidNode; // Previous block in the same segregated list
+            Uint32     NextFree = InvalidNode; // Next block in the same segregated list or next unused node
+        };
+
+        struct HashSlot
+        {
+            Uint64 Key  = 0;
+            Uint32 Node = InvalidNode;
+        };
+
+        using TNodePool  = std::vector<FreeBlockNode, STDAllocatorRawMem<FreeBlockNode>>;
+        using THashTable = std::vector<HashSlot,      STDAllocatorRawMem<HashSlot>>;
+
+    public:
+        TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator &Allocator) : 
+            m_Nodes    ( STD_ALLOCATOR_RAW_MEM(FreeBlockNode, Allocator, "Allocator for vector<FreeBlockNode>") ),
+            m_HashTable( STD_ALLOCATOR_RAW_MEM(HashSlot, Allocator, "Allocator for vector<HashSlot>") ),
+            m_MaxSize  (MaxSize),
+            m_FreeSize (MaxSize)
+        {
+            for (Uint32 fl = 0; fl < FLCount; ++fl)
+            {
+                for (Uint32 sl = 0; sl < SLCount; ++sl)
+                    m_FreeLists[fl][sl] = InvalidNode;
+            }
+
+            if (m_MaxSize > 0)
+            {
+                m_Nodes.reserve(16);
+                m_HashTable.resize(32);
+                // Insert single maximum-size block
+                InsertFreeBlock(0, m_MaxSize);
+            }
+#ifdef _DEBUG
+            DbgVerifyLists();
+#endif
+        }
+
+        ~TLSFAllocationsManager()
+        {
+#ifdef _DEBUG
+            if (m_NumFreeBlocks != 0)
+            {
+                VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+                VERIFY(m_FreeSize == m_MaxSize, "Not all allocations have been released");
+            }
+#endif
+        }
+
+        TLSFAllocationsManager(TLSFAllocationsManager&& rhs) : 
+            m_Nodes           (std::move(rhs.m_Nodes)),
+            m_HashTable       (std::move(rhs.m_HashTable)),
+            m_FirstUnusedNode (rhs.m_FirstUnusedNode),
+            m_NumFreeBlocks   (rhs.m_NumFreeBlocks),
+            m_FLBitmap        (rhs.m_FLBitmap),
+            m_MaxSize         (rhs.m_MaxSize),
+            m_FreeSize        (rhs.m_FreeSize)
+        {
+            memcpy(m_SLBitmaps, rhs.m_SLBitmaps, sizeof(m_SLBitmaps));
+            memcpy(m_FreeLists, rhs.m_FreeLists, sizeof(m_FreeLists));
+            rhs.m_FirstUnusedNode = InvalidNode;
+            rhs.m_NumFreeBlocks   = 0;
+            rhs.m_FLBitmap        = 0;
+            rhs.m_MaxSize         = 0;
+            rhs.m_FreeSize        = 0;
+        }
+
+        TLSFAllocationsManager& operator = (TLSFAllocationsManager&& rhs)
+        {
+            m_Nodes           = std::move(rhs.m_Nodes);
+            m_HashTable       = std::move(rhs.m_HashTable);
+            m_FirstUnusedNode = rhs.m_FirstUnusedNode;
+            m_NumFreeBlocks   = rhs.m_NumFreeBlocks;
+            m_FLBitmap        = rhs.m_FLBitmap;
+            m_MaxSize         = rhs.m_MaxSize;
+            m_FreeSize        = rhs.m_FreeSize;
+            memcpy(m_SLBitmaps, rhs.m_SLBitmaps, sizeof(m_SLBitmaps));
+            memcpy(m_FreeLists, rhs.m_FreeLists, sizeof(m_FreeLists));
+            rhs.m_FirstUnusedNode = InvalidNode;
+            rhs.m_NumFreeBlocks   = 0;
+            rhs.m_FLBitmap        = 0;
+            rhs.m_MaxSize         = 0;
+            rhs.m_FreeSize        = 0;
+            return *this;
+        }
+        TLSFAllocationsManager(const TLSFAllocationsManager&) = delete;
+        TLSFAllocationsManager& operator = (const TLSFAllocationsManager&) = delete;
+
+        OffsetType Allocate(OffsetType Size, OffsetType Alignment = 1)
+        {
+            VERIFY_EXPR(Size != 0);
+            VERIFY(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment (", Alignment, ") must be power of 2");
+            if (m_FreeSize < Size)
+                return InvalidOffset;
+
+            // Reserve space for the worst-case alignment padding
+            auto SearchSize = Size + (Alignment > 1 ? Alignment - 1 : 0);
+            auto Node = InvalidNode;
+            if (SearchSize <= m_MaxSize)
+            {
+                Uint32 fl, sl;
+                MappingSearch(SearchSize, fl, sl);
+                Node = FindSuitableBlock(fl, sl);
+            }
+            // The good-fit search rounds the size up to the next class and may miss blocks that 
+            // are large enough, e.g. the whole free page when Size is equal to the page size. 
+            // Check individual blocks before giving up.
+            if (Node == InvalidNode)
+                Node = FindAlignedFit(Size, Alignment);
+            if (Node == InvalidNode)
+                return InvalidOffset;
+
+            //     BlockOffset    AlignedOffset
+            //        |                |                          |
+            //        |<---Padding---->|<------Size------>|<-Rem->|
+            //        |<-----------------BlockSize--------------->|
+            //
+            auto BlockOffset = m_Nodes[Node].Offset;
+            auto BlockSize   = m_Nodes[Node].Size;
+            RemoveFreeBlock(Node);
+
+            auto AlignedOffset = (BlockOffset + (Alignment - 1)) & ~(Alignment - 1);
+            VERIFY_EXPR(AlignedOffset + Size <= BlockOffset + BlockSize);
+            auto Padding       = AlignedOffset - BlockOffset;
+            auto Remainder     = BlockSize - Padding - Size;
+            // Return leading padding and trailing remainder to the free lists
+            if (Padding > 0)
+                InsertFreeBlock(BlockOffset, Padding);
+            if (Remainder > 0)
+                InsertFreeBlock(AlignedOffset + Size, Remainder);
+
+            m_FreeSize -= Size;
+
+#ifdef _DEBUG
+            DbgVerifyLists();
+#endif
+            return AlignedOffset;
+        }
+
+        void Free(OffsetType Offset, OffsetType Size)
+        {
+            VERIFY_EXPR(Size != 0 && Offset + Size <= m_MaxSize);
+
+            auto NewOffset = Offset;
+            auto NewSize   = Size;
+
+            // Merge with the free block that ends where the released block starts
+            auto PrevNode = FindNode(EndKey(Offset));
+            if (PrevNode != InvalidNode)
+            {
+                VERIFY_EXPR(m_Nodes[PrevNode].Offset + m_Nodes[PrevNode].Size == Offset);
+                NewOffset = m_Nodes[PrevNode].Offset;
+                NewSize  += m_Nodes[PrevNode].Size;
+                RemoveFreeBlock(PrevNode);
+            }
+
+            // Merge with the free block that starts where the released block ends
+            auto NextNode = FindNode(StartKey(Offset + Size));
+            if (NextNode != InvalidNode)
+            {
+                VERIFY_EXPR(m_Nodes[NextNode].Offset == Offset + Size);
+                NewSize += m_Nodes[NextNode].Size;
+                RemoveFreeBlock(NextNode);
+            }
+
+            InsertFreeBlock(NewOffset, NewSize);
+
+            m_FreeSize += Size;
+#ifdef _DEBUG
+            DbgVerifyLists();
+#endif
+        }
+
+        bool IsFull() const{ return m_FreeSize==0; };
+        bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+        OffsetType GetMaxSize() const{return m_MaxSize;}
+        OffsetType GetFreeSize()const{return m_FreeSize;}
+        OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+
+#ifdef _DEBUG
+        size_t DbgGetNumFreeBlocks()const{return m_NumFreeBlocks;}
+#endif
+
+    private:
+        static Uint32 GetMSB(Uint64 Val)
+        {
+            auto Hi = static_cast<Uint32>(Val >> 32);
+            return Hi != 0 ? 32 + PlatformMisc::GetMSB(Hi) : PlatformMisc::GetMSB(static_cast<Uint32>(Val));
+        }
+
+        static Uint32 GetLSB(Uint64 Val)
+        {
+            auto Lo = static_cast<Uint32>(Val);
+            return Lo != 0 ? PlatformMisc::GetLSB(Lo) : 32 + PlatformMisc::GetLSB(static_cast<Uint32>(Val >> 32));
+        }
+
+        // Returns the list that a free block of the given size belongs to
+        static void MappingInsert(OffsetType Size, Uint32& fl, Uint32& sl)
+        {
+            if (Size < SLCount)
+            {
+                // Small blocks are stored in the first-level list 0 with linear second-level classes
+                fl = 0;
+                sl = static_cast<Uint32>(Size);
+            }
+            else
+            {
+                auto MSB = GetMSB(Size);
+                fl = MSB - SLBits + 1;
+                sl = static_cast<Uint32>(Size >> (MSB - SLBits)) - SLCount;
+            }
+            VERIFY_EXPR(fl < FLCount && sl < SLCount);
+        }
+
+        // Returns the first list that only contains blocks of at least the given size
+        static void MappingSearch(OffsetType Size, Uint32& fl, Uint32& sl)
+        {
+            if (Size >= SLCount)
+                Size += (OffsetType{1} << (GetMSB(Size) - SLBits)) - 1;
+            MappingInsert(Size, fl, sl);
+        }
+
+        Uint32 FindSuitableBlock(Uint32& fl, Uint32& sl)const
+        {
+            // Search the remaining classes of the current first-level range
+            auto SLMap = m_SLBitmaps[fl] & (~Uint32{0} << sl);
+            if (SLMap == 0)
+            {
+                // Search larger first-level ranges
+                auto FLMap = fl + 1 < FLCount ? m_FLBitmap & (~Uint64{0} << (fl + 1)) : 0;
+                if (FLMap == 0)
+                    return InvalidNode;
+                fl = GetLSB(FLMap);
+                SLMap = m_SLBitmaps[fl];
+                VERIFY(SLMap != 0, "Second-level bitmap must not be empty when first-level bit is set");
+            }
+            sl = GetLSB(SLMap);
+            return m_FreeLists[fl][sl];
+        }
+
+        // Linearly searches all free blocks starting from the class of the requested size for a block
+        // that fits the aligned allocation. Only used when the constant-time search fails.
+        Uint32 FindAlignedFit(OffsetType Size, OffsetType Alignment)const
+        {
+            Uint32 fl, sl;
+            MappingInsert(Size, fl, sl);
+            // Blocks in lower classes are all smaller than Size
+            auto SLMap = m_SLBitmaps[fl] & (~Uint32{0} << sl);
+            for (;;)
+            {
+                while (SLMap != 0)
+                {
+                    sl = GetLSB(SLMap);
+                    for (auto Node = m_FreeLists[fl][sl]; Node != InvalidNode; Node = m_Nodes[Node].NextFree)
+                    {
+                        const auto& Block = m_Nodes[Node];
+                        auto AlignedOffset = (Block.Offset + (Alignment - 1)) & ~(Alignment - 1);
+                        if (AlignedOffset + Size <= Block.Offset + Block.Size)
+                            return Node;
+                    }
+                    SLMap &= SLMap - 1;
+                }
+                auto FLMap = fl + 1 < FLCount ? m_FLBitmap & (~Uint64{0} << (fl + 1)) : 0;
+                if (FLMap == 0)
+                    return InvalidNode;
+                fl = GetLSB(FLMap);
+                SLMap = m_SLBitmaps[fl];
+            }
+        }
+
+        static Uint64 StartKey(OffsetType Offset){ return static_cast<Uint64>(Offset) << 1; }
+        static Uint64 EndKey  (OffsetType Offset){ return (static_cast<Uint64>(Offset) << 1) | 1; }
+
+        size_t GetHashSlot(Uint64 Key)const
+        {
+            // Fibonacci hashing
+            return static_cast<size_t>((Key * 0x9E3779B97F4A7C15ull) >> 32) & (m_HashTable.size() - 1);
+        }
+
+        Uint32 FindNode(Uint64 Key)const
+        {
+            for (auto Slot = GetHashSlot(Key); m_HashTable[Slot].Node != InvalidNode; Slot = (Slot + 1) & (m_HashTable.size() - 1))
+            {
+                if (m_HashTable[Slot].Key == Key)
+                    return m_HashTable[Slot].Node;
+            }
+            return InvalidNode;
+        }
+
+        void InsertKey(Uint64 Key, Uint32 Node)
+        {
+            auto Slot = GetHashSlot(Key);
+            while (m_HashTable[Slot].Node != InvalidNode)
+            {
+                VERIFY(m_HashTable[Slot].Key != Key, "Key is already in the table");
+                Slot = (Slot + 1) & (m_HashTable.size() - 1);
+            }
+            m_HashTable[Slot].Key  = Key;
+            m_HashTable[Slot].Node = Node;
+        }
+
+        void EraseKey(Uint64 Key)
+        {
+            const auto Mask = m_HashTable.size() - 1;
+            auto Slot = GetHashSlot(Key);
+            while (m_HashTable[Slot].Node == InvalidNode || m_HashTable[Slot].Key != Key)
+            {
+                VERIFY(m_HashTable[Slot].Node != InvalidNode, "Key is not found in the table");
+                Slot = (Slot + 1) & Mask;
+            }
+            // Backward-shift deletion keeps probe sequences intact without tombstones
+            auto Hole = Slot;
+            for (auto Next = (Hole + 1) & Mask; m_HashTable[Next].Node != InvalidNode; Next = (Next + 1) & Mask)
+            {
+                auto Home = GetHashSlot(m_HashTable[Next].Key);
+                // Move the element to the hole if its home slot is not in the cyclic range (Hole, Next]
+                if (((Next - Home) & Mask) >= ((Next - Hole) & Mask))
+                {
+                    m_HashTable[Hole] = m_HashTable[Next];
+                    Hole = Next;
+                }
+            }
+            m_HashTable[Hole].Node = InvalidNode;
+        }
+
+        void GrowHashTable()
+        {
+            THashTable OldTable(std::move(m_HashTable));
+            m_HashTable = THashTable(OldTable.size() * 2, HashSlot{}, OldTable.get_allocator());
+            for (const auto& Slot : OldTable)
+            {
+                if (Slot.Node != InvalidNode)
+                    InsertKey(Slot.Key, Slot.Node);
+            }
+        }
+
+        void InsertFreeBlock(OffsetType Offset, OffsetType Size)
+        {
+            Uint32 Node = m_FirstUnusedNode;
+            if (Node != InvalidNode)
+                m_FirstUnusedNode = m_Nodes[Node].NextFree;
+            else
+            {
+                Node = static_cast<Uint32>(m_Nodes.size());
+                m_Nodes.emplace_back();
+            }
+            ++m_NumFreeBlocks;
+
+            Uint32 fl, sl;
+            MappingInsert(Size, fl, sl);
+            auto& Block = m_Nodes[Node];
+            Block.Offset   = Offset;
+            Block.Size     = Size;
+            Block.PrevFree = InvalidNode;
+            Block.NextFree = m_FreeLists[fl][sl];
+            if (Block.NextFree != InvalidNode)
+                m_Nodes[Block.NextFree].PrevFree = Node;
+            m_FreeLists[fl][sl] = Node;
+            m_FLBitmap     |= Uint64{1} << fl;
+            m_SLBitmaps[fl] |= Uint32{1} << sl;
+
+            // Every free block has two keys in the table. Keep load factor at most 1/2.
+            if (m_NumFreeBlocks * 4 > m_HashTable.size())
+                GrowHashTable();
+            InsertKey(StartKey(Offset), Node);
+            InsertKey(EndKey(Offset + Size), Node);
+        }
+
+        void RemoveFreeBlock(Uint32 Node)
+        {
+            auto& Block = m_Nodes[Node];
+            Uint32 fl, sl;
+            MappingInsert(Block.Size, fl, sl);
+            if (Block.PrevFree != InvalidNode)
+                m_Nodes[Block.PrevFree].NextFree = Block.NextFree;
+            else
+            {
+                VERIFY_EXPR(m_FreeLists[fl][sl] == Node);
+                m_FreeLists[fl][sl] = Block.NextFree;
+                if (Block.NextFree == InvalidNode)
+                {
+                    m_SLBitmaps[fl] &= ~(Uint32{1} << sl);
+                    if (m_SLBitmaps[fl] == 0)
+                        m_FLBitmap &= ~(Uint64{1} << fl);
+                }
+            }
+            if (Block.NextFree != InvalidNode)
+                m_Nodes[Block.NextFree].PrevFree = Block.PrevFree;
+
+            EraseKey(StartKey(Block.Offset));
+            EraseKey(EndKey(Block.Offset + Block.Size));
+
+            Block.PrevFree    = InvalidNode;
+            Block.NextFree    = m_FirstUnusedNode;
+            m_FirstUnusedNode = Node;
+            --m_NumFreeBlocks;
+        }
+
+#ifdef _DEBUG
+        void DbgVerifyLists()
+        {
+            OffsetType TotalFreeSize = 0;
+            Uint32 NumFreeBlocks = 0;
+            for (Uint32 fl = 0; fl < FLCount; ++fl)
+            {
+                VERIFY_EXPR( ((m_FLBitmap & (Uint64{1} << fl)) != 0) == (m_SLBitmaps[fl] != 0) );
+                for (Uint32 sl = 0; sl < SLCount; ++sl)
+                {
+                    VERIFY_EXPR( ((m_SLBitmaps[fl] & (Uint32{1} << sl)) != 0) == (m_FreeLists[fl][sl] != InvalidNode) );
+                    for (auto Node = m_FreeLists[fl][sl]; Node != InvalidNode; Node = m_Nodes[Node].NextFree)
+                    {
+                        const auto& Block = m_Nodes[Node];
+                        Uint32 BlockFL, BlockSL;
+                        MappingInsert(Block.Size, BlockFL, BlockSL);
+                        VERIFY_EXPR(BlockFL == fl && BlockSL == sl);
+                        VERIFY_EXPR(Block.Offset + Block.Size <= m_MaxSize);
+                        VERIFY_EXPR(FindNode(StartKey(Block.Offset)) == Node && FindNode(EndKey(Block.Offset + Block.Size)) == Node);
+                        VERIFY(FindNode(EndKey(Block.Offset)) == InvalidNode && FindNode(StartKey(Block.Offset + Block.Size)) == InvalidNode, "Unmerged adjacent blocks detected");
+                        TotalFreeSize += Block.Size;
+                        ++NumFreeBlocks;
+                    }
+                }
+            }
+            VERIFY_EXPR(NumFreeBlocks == m_NumFreeBlocks);
+            VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+        }
+#endif
+
+        TNodePool  m_Nodes;
+        THashTable m_HashTable;
+        Uint32     m_FirstUnusedNode = InvalidNode;
+        Uint32     m_NumFreeBlocks   = 0;
+
+        Uint64 m_FLBitmap = 0;
+        Uint32 m_SLBitmaps[FLCount] = {};
+        Uint32 m_FreeLists[FLCount][SLCount];
+
+        OffsetType m_MaxSize  = 0;
+        OffsetType m_FreeSize = 0;
+    };
+}
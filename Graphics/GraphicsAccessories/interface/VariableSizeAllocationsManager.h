@@ -98,7 +98,8 @@ namespace Diligent
             m_FreeSize(MaxSize)
         {
             // Insert single maximum-size block
-            AddNewBlock(0, m_MaxSize);
+            if (m_MaxSize > 0)
+                AddNewBlock(0, m_MaxSize);
 
 #ifdef _DEBUG
             DbgVerifyList();
@@ -137,9 +138,13 @@ namespace Diligent
         VariableSizeAllocationsManager(const VariableSizeAllocationsManager&) = delete;
         VariableSizeAllocationsManager& operator = (const VariableSizeAllocationsManager&) = delete;
 
-        OffsetType Allocate(OffsetType Size)
+        // Allocates Size bytes at the offset that is a multiple of Alignment. The returned 
+        // offset must be released with the same Size. Space skipped to align the offset 
+        // is returned to the free list.
+        OffsetType Allocate(OffsetType Size, OffsetType Alignment = 1)
         {
             VERIFY_EXPR(Size != 0);
+            VERIFY(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment (", Alignment, ") must be power of 2");
             if(m_FreeSize < Size)
                 return InvalidOffset;
 
@@ -147,6 +152,16 @@ namespace Diligent
             // lower_bound() returns an iterator pointing to the first element that 
             // is not less (i.e. >= ) than key
             auto SmallestBlockItIt = m_FreeBlocksBySize.lower_bound(Size);
+
+            // Skip blocks that cannot accommodate aligned allocation. Any block that is
+            // at least Size + Alignment - 1 bytes large is guaranteed to fit, so the search 
+            // only goes through the blocks whose size is in [Size, Size + Alignment - 1) range.
+            while (SmallestBlockItIt != m_FreeBlocksBySize.end() && 
+                   AlignOffset(SmallestBlockItIt->second->first, Alignment) + Size > SmallestBlockItIt->second->first + SmallestBlockItIt->first)
+            {
+                ++SmallestBlockItIt;
+            }
+
             if(SmallestBlockItIt == m_FreeBlocksBySize.end())
                 return InvalidOffset;
 
@@ -155,18 +170,24 @@ namespace Diligent
             VERIFY_EXPR(SmallestBlockIt->second.Size == SmallestBlockItIt->first);
             
             //     SmallestBlockIt.Offset      
-            //        |                                  |
-            //        |<------SmallestBlockIt.Size------>|
-            //        |<------Size------>|<---NewSize--->|
-            //        |                  |
-            //      Offset              NewOffset
+            //        |                                                   |
+            //        |<-------------SmallestBlockIt.Size---------------->|
+            //        |<--Padding-->|<------Size------>|<----NewSize----->|
+            //        |             |                  |
+            //   BlockOffset      Offset              NewOffset
             //
-            auto Offset = SmallestBlockIt->first;
+            auto BlockOffset = SmallestBlockIt->first;
+            auto Offset = AlignOffset(BlockOffset, Alignment);
+            auto Padding = Offset - BlockOffset;
             auto NewOffset = Offset + Size;
-            auto NewSize = SmallestBlockIt->second.Size - Size;
+            auto NewSize = SmallestBlockIt->second.Size - Padding - Size;
             VERIFY_EXPR(SmallestBlockItIt == SmallestBlockIt->second.OrderBySizeIt);
             m_FreeBlocksBySize.erase(SmallestBlockItIt);
             m_FreeBlocksByOffset.erase(SmallestBlockIt);
+            if (Padding > 0)
+            {
+                AddNewBlock(BlockOffset, Padding);
+            }
             if (NewSize > 0)
             {
                 AddNewBlock(NewOffset, NewSize);
@@ -280,6 +301,11 @@ namespace Diligent
 #endif
 
     private:
+        static OffsetType AlignOffset(OffsetType Offset, OffsetType Alignment)
+        {
+            return (Offset + (Alignment - 1)) & ~(Alignment - 1);
+        }
+
         void AddNewBlock(OffsetType Offset, OffsetType Size)
         {
             auto NewBlockIt = m_FreeBlocksByOffset.emplace(Offset, Size);
@@ -0,0 +1,136 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the cost of random allocations and releases in VariableSizeAllocationsManager 
+// and TLSFAllocationsManager, and verifies that both managers return all space when 
+// the allocations are released and that a moved-from TLSF manager is empty.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include "VariableSizeAllocationsManager.h"
+#include "TLSFAllocationsManager.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Timer.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr size_t MaxSize          = size_t{256} << 20;
+static constexpr Uint32 NumLiveAllocs    = 4096;
+static constexpr Uint32 NumOps           = 200000;
+static constexpr size_t MinAllocSize     = 256;
+static constexpr size_t MaxAllocSize     = 64 << 10;
+static constexpr size_t Alignment        = 256;
+
+int NumFailures = 0;
+
+template<typename AllocationsManagerType>
+double Run(const char* Name)
+{
+    struct Allocation
+    {
+        size_t Offset = 0;
+        size_t Size   = 0;
+    };
+    AllocationsManagerType Mgr(MaxSize, DefaultRawMemoryAllocator::GetAllocator());
+    std::vector<Allocation> Allocs(NumLiveAllocs);
+    // Same sequence of sizes for both managers
+    std::mt19937 Rand(0);
+    std::uniform_int_distribution<size_t> SizeDistr(MinAllocSize, MaxAllocSize);
+
+    Timer timer;
+    for (Uint32 op = 0; op < NumOps; ++op)
+    {
+        auto &Alloc = Allocs[Rand() % NumLiveAllocs];
+        if (Alloc.Size != 0)
+            Mgr.Free(Alloc.Offset, Alloc.Size);
+        Alloc.Size   = SizeDistr(Rand);
+        Alloc.Offset = Mgr.Allocate(Alloc.Size, Alignment);
+        if (Alloc.Offset == AllocationsManagerType::InvalidOffset || Alloc.Offset % Alignment != 0)
+        {
+            std::cerr << Name << ": failed to allocate " << Alloc.Size << " bytes\n";
+            ++NumFailures;
+            Alloc.Size = 0;
+        }
+    }
+    auto ElapsedTime = timer.GetElapsedTime();
+
+    for (auto &Alloc : Allocs)
+    {
+        if (Alloc.Size != 0)
+            Mgr.Free(Alloc.Offset, Alloc.Size);
+    }
+    if (!Mgr.IsEmpty())
+    {
+        std::cerr << Name << ": " << Mgr.GetUsedSize() << " bytes are still in use after all allocations have been released\n";
+        ++NumFailures;
+    }
+
+    // Nanoseconds per allocate/free pair
+    return ElapsedTime / NumOps * 1e+9;
+}
+
+void TestTLSFMove()
+{
+    TLSFAllocationsManager Mgr(1024, DefaultRawMemoryAllocator::GetAllocator());
+    TLSFAllocationsManager Mgr2(2048, DefaultRawMemoryAllocator::GetAllocator());
+    Mgr2 = std::move(Mgr);
+    TLSFAllocationsManager Mgr3(std::move(Mgr2));
+    if (Mgr.GetMaxSize() != 0 || Mgr.GetFreeSize() != 0 || Mgr2.GetMaxSize() != 0 || Mgr2.GetFreeSize() != 0)
+    {
+        std::cerr << "Moved-from TLSF allocations manager is not empty\n";
+        ++NumFailures;
+    }
+    auto Offset = Mgr3.Allocate(1024);
+    if (Mgr3.GetMaxSize() != 1024 || Offset != 0 || !Mgr3.IsFull())
+    {
+        std::cerr << "Moved TLSF allocations manager is in invalid state\n";
+        ++NumFailures;
+    }
+    Mgr3.Free(Offset, 1024);
+}
+
+}
+
+int main()
+{
+    TestTLSFMove();
+
+    auto VSATime  = Run<VariableSizeAllocationsManager>("VariableSizeAllocationsManager");
+    auto TLSFTime = Run<TLSFAllocationsManager>("TLSFAllocationsManager");
+    std::cout << "Random allocate/free pairs, " << NumLiveAllocs << " live allocations, ns per pair\n"
+              << std::fixed << std::setprecision(1)
+              << "VariableSizeAllocationsManager: " << VSATime << '\n'
+              << "TLSFAllocationsManager:         " << TLSFTime << '\n';
+
+    if (NumFailures != 0)
+    {
+        std::cerr << NumFailures << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the multi-threaded allocation throughput of RingBuffer protected by a mutex,
+// which is how dynamic heaps used it before, and the lock-free ConcurrentRingBuffer.
+// Every frame, all threads allocate chunks that together fill most of the buffer, then
+// the frame is finished and released. The test verifies that no two allocations made
+// by the concurrent buffer in the same frame overlap.
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include "RingBuffer.h"
+#include "ConcurrentRingBuffer.h"
+#include "DefaultRawMemoryAllocator.h"
+#include "Timer.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr size_t BufferSize          = size_t{64} << 20;
+static constexpr size_t ChunkSize           = 4096;
+static constexpr Uint32 NumFrames           = 50;
+// All threads together allocate 3/4 of the buffer every frame
+static constexpr Uint32 NumChunksPerFrame   = static_cast<Uint32>(BufferSize / ChunkSize * 3 / 4);
+
+int NumFailures = 0;
+
+class MutexRingBuffer
+{
+public:
+    MutexRingBuffer(size_t MaxSize, IMemoryAllocator& Allocator) : 
+        m_RingBuffer(MaxSize, Allocator)
+    {}
+
+    size_t Allocate(size_t Size)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        return m_RingBuffer.Allocate(Size);
+    }
+
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_RingBuffer.FinishCurrentFrame(FenceValue);
+    }
+
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_RingBuffer.ReleaseCompletedFrames(CompletedFenceValue);
+    }
+
+    static constexpr size_t InvalidOffset = RingBuffer::InvalidOffset;
+
+private:
+    std::mutex m_Mutex;
+    RingBuffer m_RingBuffer;
+};
+
+template<typename RingBufferType>
+double Run(const char* Name, Uint32 NumThreads)
+{
+    RingBufferType Buffer(BufferSize, DefaultRawMemoryAllocator::GetAllocator());
+    const Uint32 NumChunksPerThread = NumChunksPerFrame / NumThreads;
+    std::vector<std::vector<size_t>> Offsets(NumThreads);
+    for (auto &ThreadOffsets : Offsets)
+        ThreadOffsets.resize(NumChunksPerThread);
+
+    std::vector<size_t> FrameOffsets;
+    double TotalTime = 0;
+    for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        Timer timer;
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&Buffer, &Offsets, t, NumChunksPerThread]()
+                {
+                    for (Uint32 c = 0; c < NumChunksPerThread; ++c)
+                        Offsets[t][c] = Buffer.Allocate(ChunkSize);
+                }
+            );
+        }
+        for (auto &Thread : Threads)
+            Thread.join();
+        TotalTime += timer.GetElapsedTime();
+
+        FrameOffsets.clear();
+        for (const auto &ThreadOffsets : Offsets)
+            FrameOffsets.insert(FrameOffsets.end(), ThreadOffsets.begin(), ThreadOffsets.end());
+        std::sort(FrameOffsets.begin(), FrameOffsets.end());
+        if (FrameOffsets.back() == RingBufferType::InvalidOffset)
+        {
+            std::cerr << Name << ": allocation failed in frame " << Frame << '\n';
+            ++NumFailures;
+        }
+        else if (std::adjacent_find(FrameOffsets.begin(), FrameOffsets.end(), [](size_t o0, size_t o1){return o1 - o0 < ChunkSize;}) != FrameOffsets.end())
+        {
+            std::cerr << Name << ": overlapping allocations found in frame " << Frame << '\n';
+            ++NumFailures;
+        }
+
+        Buffer.FinishCurrentFrame(Frame);
+        Buffer.ReleaseCompletedFrames(Frame);
+    }
+
+    // Millions of allocations per second
+    return static_cast<double>(NumChunksPerThread) * NumThreads * NumFrames / TotalTime * 1e-6;
+}
+
+}
+
+int main()
+{
+    std::cout << "Ring buffer allocation throughput, millions of allocations per second\n"
+              << "Threads      Mutex      Lock-free\n";
+    for (Uint32 NumThreads = 1; NumThreads <= 8; NumThreads *= 2)
+    {
+        auto MutexRate    = Run<MutexRingBuffer>     ("RingBuffer",           NumThreads);
+        auto LockFreeRate = Run<ConcurrentRingBuffer>("ConcurrentRingBuffer", NumThreads);
+        std::cout << std::setw(7) << NumThreads << std::fixed << std::setprecision(2)
+                  << std::setw(11) << MutexRate << std::setw(15) << LockFreeRate << '\n';
+    }
+
+    if (NumFailures != 0)
+    {
+        std::cerr << NumFailures << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
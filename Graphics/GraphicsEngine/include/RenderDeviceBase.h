@@ -198,6 +198,8 @@ public:
     /// \param FenceSize        - size of the fence object, in bytes
     /// \remarks Render device uses fixed block allocators (see FixedBlockMemoryAllocator) to allocate memory for
     ///          device objects. The object sizes provided to constructor are used to initialize the allocators.
+    ///          Allocators for texture views, buffer views and shader resource bindings, which are frequently
+    ///          created from multiple threads, use thread caching.
     RenderDeviceBase(IReferenceCounters* pRefCounters,
                      IMemoryAllocator&   RawMemAllocator, 
                      Uint32 NumDeferredContexts,
@@ -216,13 +218,13 @@ public:
         m_TexFmtInfoInitFlags   (TEX_FORMAT_NUM_FORMATS, false, STD_ALLOCATOR_RAW_MEM(bool, RawMemAllocator, "Allocator for vector<bool>") ),
         m_wpDeferredContexts    (NumDeferredContexts, RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
         m_TexObjAllocator       (RawMemAllocator, TextureObjSize, 64),
-        m_TexViewObjAllocator   (RawMemAllocator, TexViewObjSize, 64),
+        m_TexViewObjAllocator   (RawMemAllocator, TexViewObjSize, 64, true),
         m_BufObjAllocator       (RawMemAllocator, BufferObjSize, 128),
-        m_BuffViewObjAllocator  (RawMemAllocator, BuffViewObjSize, 128),
+        m_BuffViewObjAllocator  (RawMemAllocator, BuffViewObjSize, 128, true),
         m_ShaderObjAllocator    (RawMemAllocator, ShaderObjSize, 32),
         m_SamplerObjAllocator   (RawMemAllocator, SamplerObjSize, 32),
         m_PSOAllocator          (RawMemAllocator, PSOSize, 128),
-        m_SRBAllocator          (RawMemAllocator, SRBSize, 1024),
+        m_SRBAllocator          (RawMemAllocator, SRBSize, 1024, true),
         m_FenceAllocator        (RawMemAllocator, FenceSize, 16),
         m_ResMappingAllocator   (RawMemAllocator, sizeof(ResourceMappingImpl), 16)
     {
@@ -27,8 +27,11 @@
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
 #include "DeviceObject.h"
-#include <unordered_map>
+#include <atomic>
+#include <new>
 #include "STDAllocator.h"
+#include "LockHelper.h"
+#include "RefCntAutoPtr.h"
 
 namespace Diligent
 {
@@ -54,6 +57,16 @@ namespace Diligent
     /// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
     /// If after that this thread locks the registry first, it will be waiting for the object to unlock in
     /// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+    /// \remarks
+    /// Find() does not take any locks. The registry is a hash table with a fixed number of buckets, 
+    /// each bucket being a singly-linked list of immutable entries. Add() and Purge() are serialized by the
+    /// lock flag and publish changes with atomic pointer stores, so readers always see consistent lists.
+    /// Entries that are unlinked from the lists are not destroyed immediately, but are retired and released
+    /// using epoch-based reclamation: every thread announces the global epoch it observed when entering 
+    /// Find() in its own reader slot (see ThreadingTools::GetThreadSlot()), so readers never write to shared
+    /// cache lines. An entry retired at some epoch is released once every thread that is inside Find() has
+    /// entered it at a later epoch. Expired entries are removed incrementally: every Add() scans a few 
+    /// buckets, and the whole table is purged when the number of reported deleted objects reaches the threshold.
     template<typename ResourceDescType>
     class StateObjectsRegistry
     {
@@ -61,10 +74,35 @@ namespace Diligent
         /// Number of outstanding deleted objects to purge the registry.
         static constexpr int DeletedObjectsToPurge = 32;
 
+        /// Number of buckets that are checked for expired objects every time a new object is added.
+        static constexpr Uint32 BucketsToPurgePerAdd = 4;
+
+        /// Registry statistics
+        struct Statistics
+        {
+            /// Number of Find() calls that returned an object
+            Uint64 NumHits          = 0;
+
+            /// Number of Find() calls that did not find the object
+            Uint64 NumMisses        = 0;
+
+            /// Number of Find() calls that found an expired object
+            Uint64 NumExpiredHits   = 0;
+
+            /// Total number of expired objects removed from the registry
+            Uint64 NumPurgedObjects = 0;
+
+            /// Number of full registry purges
+            Uint64 NumPurges        = 0;
+        };
+
         StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-            m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >") ),
+            m_RawAllocator( RawAllocator ),
             m_RegistryName( RegistryName )
-        {}
+        {
+            for(auto& Bucket : m_Buckets)
+                Bucket.store(nullptr, std::memory_order_relaxed);
+        }
         
         ~StateObjectsRegistry()
         {
@@ -74,7 +112,20 @@ namespace Diligent
             // may only be expired references in the registry. After we
             // purge it, the registry must be empty.
             Purge();
-            VERIFY( m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty" );
+            VERIFY( m_NumEntries == 0, "Registry is not empty" );
+            VERIFY_EXPR( m_NumOverflowReaders == 0 );
+            for(auto& Bucket : m_Buckets)
+            {
+                auto* pEntry = Bucket.load(std::memory_order_relaxed);
+                while(pEntry != nullptr)
+                {
+                    auto* pNext = pEntry->pNext.load(std::memory_order_relaxed);
+                    DestroyEntry(pEntry);
+                    pEntry = pNext;
+                }
+            }
+            ReleaseRetiredEntries();
+            VERIFY( m_pRetiredEntries == nullptr, "Find() is in progress while the registry is being destroyed" );
         }
 
         /// Adds a new object to the registry
@@ -82,9 +133,9 @@ namespace Diligent
         /// \param [in] ObjectDesc - object description.
         /// \param [in] pObject - pointer to the object.
         /// 
-        /// Besides adding a new object, the function also checks the number of
-        /// outstanding deleted objects and calls Purge() if the number has reached
-        /// the threshold value DeletedObjectsToPurge. Creating a state object is 
+        /// Besides adding a new object, the function also removes expired objects from several 
+        /// buckets, and purges the whole registry if the number of outstanding deleted objects has 
+        /// reached the threshold value DeletedObjectsToPurge. Creating a state object is 
         /// assumed to be an expensive operation and should be performed during
         /// the initialization. Occasional purge operations should not add significant
         /// cost to it.
@@ -97,12 +148,19 @@ namespace Diligent
             // to do.
             if( m_NumDeletedObjects >= DeletedObjectsToPurge )
             {
-                Purge();
+                PurgeBuckets(0, NumBuckets);
                 m_NumDeletedObjects = 0;
+                m_NumPurges.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                PurgeBuckets(m_NextBucketToPurge, BucketsToPurgePerAdd);
+                m_NextBucketToPurge = (m_NextBucketToPurge + BucketsToPurgePerAdd) % NumBuckets;
             }
 
-            // Try to construct the new element in place
-            auto Elems = m_DescToObjHashMap.emplace( std::make_pair( ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject) ) );
+            auto Hash = std::hash<ResourceDescType>()(ObjectDesc);
+            auto& Bucket = m_Buckets[Hash % NumBuckets];
+
             // It is theorertically possible that the same object can be found
             // in the registry. This might happen if two threads try to create
             // the same object at the same time. They both will not find the
@@ -116,69 +174,102 @@ namespace Diligent
             // the second thread creates the same object and tries to add it to
             // the registry. It will find an existing expired reference to the 
             // object.
-            if( !Elems.second )
+            //
+            // Entries are immutable as other threads may read them, so the existing 
+            // entry is replaced with the new one.
+            auto* pNewEntry = CreateEntry(ObjectDesc, pObject, Hash);
+            auto* pPrevNext = &Bucket;
+            for(auto* pEntry = Bucket.load(std::memory_order_relaxed); pEntry != nullptr; pEntry = pEntry->pNext.load(std::memory_order_relaxed))
+            {
+                if( pEntry->Hash == Hash && pEntry->Desc == ObjectDesc )
+                {
+                    LOG_WARNING_MESSAGE( "Object named \"", pEntry->Desc.Name, "\" with the same description already exists in the registry."
+                                         "Replacing with the new object named \"", ObjectDesc.Name ? ObjectDesc.Name : "", "\".");
+                    pNewEntry->pNext.store(pEntry->pNext.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    pPrevNext->store(pNewEntry, std::memory_order_seq_cst);
+                    RetireEntry(pEntry);
+                    --m_NumEntries;
+                    pNewEntry = nullptr;
+                    break;
+                }
+                pPrevNext = &pEntry->pNext;
+            }
+
+            if( pNewEntry != nullptr )
             {
-                VERIFY( Elems.first->first == ObjectDesc, "Incorrect object description" );
-                LOG_WARNING_MESSAGE( "Object named \"", Elems.first->first.Name, "\" with the same description already exists in the registry."
-                                     "Replacing with the new object named \"", ObjectDesc.Name ? ObjectDesc.Name : "", "\".");
-                Elems.first->second = pObject;
+                // Insert the new entry at the head of the list
+                pNewEntry->pNext.store(Bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                Bucket.store(pNewEntry, std::memory_order_release);
             }
+            ++m_NumEntries;
+
+            ReleaseRetiredEntries();
         }
 
         /// Finds the object in the registry
+
+        /// \remarks The method is lock-free and may run concurrently with other Find(), Add() and Purge() calls.
         void Find( const ResourceDescType& Desc, IDeviceObject** ppObject )
         {
             VERIFY( *ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks" );
             *ppObject = nullptr;
-            ThreadingTools::LockHelper Lock( m_LockFlag );
 
-            auto It = m_DescToObjHashMap.find( Desc );
-            if( It != m_DescToObjHashMap.end() )
+            auto Hash = std::hash<ResourceDescType>()(Desc);
+
+            auto SlotIndex = ThreadingTools::GetThreadSlot();
+            auto* pSlot = SlotIndex < MaxReaderSlots ? &m_ReaderSlots[SlotIndex] : nullptr;
+            EnterReader(pSlot);
+            bool ExpiredHit = false;
+            for(auto* pEntry = m_Buckets[Hash % NumBuckets].load(std::memory_order_seq_cst); pEntry != nullptr; pEntry = pEntry->pNext.load(std::memory_order_acquire))
             {
-                // Try to obtain strong reference to the object.
-                // This is an atomic operation and we either get
-                // a new strong reference or object has been destroyed
-                // and we get null.
-                auto pObject = It->second.Lock();
-                if( pObject )
+                if( pEntry->Hash == Hash && pEntry->Desc == Desc )
                 {
-                    *ppObject = pObject.Detach();
-                    //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
-                }
-                else
-                {
-                    // Expired object found: remove it from the map
-                    m_DescToObjHashMap.erase(It);
-                    Atomics::AtomicDecrement(m_NumDeletedObjects);
+                    // Try to obtain strong reference to the object.
+                    // This is an atomic operation and we either get
+                    // a new strong reference or object has been destroyed
+                    // and we get null. The entry is shared by all readers
+                    // and must not be modified, so we lock a copy of the weak pointer.
+                    auto WeakPtr = pEntry->pObject;
+                    auto pObject = WeakPtr.Lock();
+                    if( pObject )
+                    {
+                        *ppObject = pObject.Detach();
+                        //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
+                    }
+                    else
+                    {
+                        // Expired object found. It will be removed by the next Add() or Purge()
+                        ExpiredHit = true;
+                    }
+                    break;
                 }
             }
+            LeaveReader(pSlot);
+
+            if( pSlot != nullptr )
+            {
+                // Only the owner thread modifies the counters in its slot, so no read-modify-write is needed
+                auto& Counter = *ppObject != nullptr ? pSlot->NumHits : pSlot->NumMisses;
+                Counter.store(Counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                if( ExpiredHit )
+                    pSlot->NumExpiredHits.store(pSlot->NumExpiredHits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            else
+            {
+                (*ppObject != nullptr ? m_NumHits : m_NumMisses).fetch_add(1, std::memory_order_relaxed);
+                if( ExpiredHit )
+                    m_NumExpiredHits.fetch_add(1, std::memory_order_relaxed);
+            }
         }
 
         /// Purges outstanding deleted objects from the registry
         void Purge()
         {
-            Uint32 NumPurgedObjects = 0;
-            auto It = m_DescToObjHashMap.begin();
-            while(  It != m_DescToObjHashMap.end() )
-            {
-                auto NextIt = It;
-                ++NextIt;
-                // Note that IsValid() is not a thread-safe function in the sense that it 
-                // can give false positive results. The only thread-safe way to check if the
-                // object is alive is to lock the weak pointer, but that requires thread 
-                // synchronization. We will immediately unlock the pointer anyway, so we
-                // want to detect 100% expired pointers. IsValid() does provide that information
-                // because once a weak pointer becomes invalid, it will be invalid
-                // until it is destroyed. It is not a problem if we miss an expired weak
-                // pointer as it will definitiely be removed next time.
-                if( !It->second.IsValid() )
-                {
-                    m_DescToObjHashMap.erase( It );
-                    ++NumPurgedObjects;
-                }
-
-                It = NextIt;
-            }
+            ThreadingTools::LockHelper Lock( m_LockFlag );
+            auto NumPurgedObjects = PurgeBuckets(0, NumBuckets);
+            m_NumDeletedObjects = 0;
+            m_NumPurges.fetch_add(1, std::memory_order_relaxed);
+            ReleaseRetiredEntries();
             LOG_INFO_MESSAGE( "Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry" );
         }
 
@@ -190,16 +281,205 @@ namespace Diligent
             Atomics::AtomicIncrement(m_NumDeletedObjects);
         }
 
+        /// Returns registry statistics
+        Statistics GetStatistics()const
+        {
+            Statistics Stats;
+            Stats.NumHits          = m_NumHits.load(std::memory_order_relaxed);
+            Stats.NumMisses        = m_NumMisses.load(std::memory_order_relaxed);
+            Stats.NumExpiredHits   = m_NumExpiredHits.load(std::memory_order_relaxed);
+            for(const auto& Slot : m_ReaderSlots)
+            {
+                Stats.NumHits        += Slot.NumHits.load(std::memory_order_relaxed);
+                Stats.NumMisses      += Slot.NumMisses.load(std::memory_order_relaxed);
+                Stats.NumExpiredHits += Slot.NumExpiredHits.load(std::memory_order_relaxed);
+            }
+            Stats.NumPurgedObjects = m_NumPurgedObjects.load(std::memory_order_relaxed);
+            Stats.NumPurges        = m_NumPurges.load(std::memory_order_relaxed);
+            return Stats;
+        }
+
     private:
-        /// Lock flag to protect the m_DescToObjHashMap
+        static constexpr Uint32 NumBuckets = 256;
+
+        /// Maximum number of threads that use their own reader slots. Other threads 
+        /// are tracked by a shared counter, which delays reclamation while they are in Find().
+        static constexpr Uint32 MaxReaderSlots = 64;
+
+        struct ReaderSlot
+        {
+            /// Global epoch observed by the thread when it entered Find(), or zero if the thread is not in Find()
+            std::atomic<Uint64> Epoch{0};
+
+            /// Statistics of Find() calls made by the thread that owns the slot
+            std::atomic<Uint64> NumHits       {0};
+            std::atomic<Uint64> NumMisses     {0};
+            std::atomic<Uint64> NumExpiredHits{0};
+
+            // The registry may not be aligned by the cache line size, so every slot is padded 
+            // to two cache lines to never share a cache line with the data of the other slots
+            Uint8 Padding[128 - 4 * sizeof(std::atomic<Uint64>)];
+        };
+
+        struct Entry
+        {
+            Entry(const ResourceDescType& _Desc, IDeviceObject* _pObject, size_t _Hash) :
+                Desc   (_Desc),
+                pObject(_pObject),
+                Hash   (_Hash)
+            {}
+
+            const ResourceDescType       Desc;
+            RefCntWeakPtr<IDeviceObject> pObject;
+            const size_t                 Hash;
+            std::atomic<Entry*>          pNext{nullptr};
+            Entry*                       pNextRetired = nullptr;
+            Uint64                       RetireEpoch  = 0;
+        };
+
+        Entry* CreateEntry(const ResourceDescType& Desc, IDeviceObject* pObject, size_t Hash)
+        {
+            auto* pMem = m_RawAllocator.Allocate(sizeof(Entry), "State object registry entry", __FILE__, __LINE__);
+            return new(pMem) Entry(Desc, pObject, Hash);
+        }
+
+        void DestroyEntry(Entry* pEntry)
+        {
+            pEntry->~Entry();
+            m_RawAllocator.Free(pEntry);
+        }
+
+        void EnterReader(ReaderSlot* pSlot)
+        {
+            // Sequentially consistent ordering is required here to pair with the writer that
+            // unlinks an entry, advances the epoch and then checks the reader slots.
+            if( pSlot != nullptr )
+                pSlot->Epoch.store(m_GlobalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            else
+                m_NumOverflowReaders.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        void LeaveReader(ReaderSlot* pSlot)
+        {
+            if( pSlot != nullptr )
+                pSlot->Epoch.store(0, std::memory_order_release);
+            else
+                m_NumOverflowReaders.fetch_sub(1, std::memory_order_release);
+        }
+
+        // Must be called with the lock flag held after the entry has been unlinked. 
+        // Readers may still be accessing the entry.
+        void RetireEntry(Entry* pEntry)
+        {
+            // Readers that observe the advanced epoch have entered Find() after the entry was unlinked
+            pEntry->RetireEpoch = m_GlobalEpoch.fetch_add(1, std::memory_order_seq_cst);
+            // pNext of the retired entry is kept intact as readers may be traversing 
+            // the list through it. Retired entries are linked through a separate pointer.
+            pEntry->pNextRetired = m_pRetiredEntries;
+            m_pRetiredEntries = pEntry;
+        }
+
+        // Must be called with the lock flag held
+        void ReleaseRetiredEntries()
+        {
+            if( m_pRetiredEntries == nullptr )
+                return;
+
+            if( m_NumOverflowReaders.load(std::memory_order_seq_cst) != 0 )
+                return;
+
+            auto MinReaderEpoch = ~Uint64{0};
+            for(const auto& Slot : m_ReaderSlots)
+            {
+                auto Epoch = Slot.Epoch.load(std::memory_order_seq_cst);
+                if( Epoch != 0 && Epoch < MinReaderEpoch )
+                    MinReaderEpoch = Epoch;
+            }
+
+            // An entry retired before the epoch of the oldest active reader cannot be reached by any reader
+            auto** ppPrevNext = &m_pRetiredEntries;
+            while(*ppPrevNext != nullptr)
+            {
+                auto* pEntry = *ppPrevNext;
+                if( pEntry->RetireEpoch < MinReaderEpoch )
+                {
+                    *ppPrevNext = pEntry->pNextRetired;
+                    DestroyEntry(pEntry);
+                }
+                else
+                    ppPrevNext = &pEntry->pNextRetired;
+            }
+        }
+
+        // Must be called with the lock flag held
+        Uint32 PurgeBuckets(Uint32 FirstBucket, Uint32 NumBucketsToPurge)
+        {
+            Uint32 NumPurgedObjects = 0;
+            for(Uint32 b = 0; b < NumBucketsToPurge; ++b)
+            {
+                auto* pPrevNext = &m_Buckets[(FirstBucket + b) % NumBuckets];
+                auto* pEntry = pPrevNext->load(std::memory_order_relaxed);
+                while( pEntry != nullptr )
+                {
+                    auto* pNext = pEntry->pNext.load(std::memory_order_relaxed);
+                    // Note that IsValid() is not a thread-safe function in the sense that it 
+                    // can give false positive results. The only thread-safe way to check if the
+                    // object is alive is to lock the weak pointer, but that requires thread 
+                    // synchronization. We will immediately unlock the pointer anyway, so we
+                    // want to detect 100% expired pointers. IsValid() does provide that information
+                    // because once a weak pointer becomes invalid, it will be invalid
+                    // until it is destroyed. It is not a problem if we miss an expired weak
+                    // pointer as it will definitiely be removed next time.
+                    if( !pEntry->pObject.IsValid() )
+                    {
+                        pPrevNext->store(pNext, std::memory_order_seq_cst);
+                        RetireEntry(pEntry);
+                        --m_NumEntries;
+                        ++NumPurgedObjects;
+                    }
+                    else
+                    {
+                        pPrevNext = &pEntry->pNext;
+                    }
+                    pEntry = pNext;
+                }
+            }
+            m_NumPurgedObjects.fetch_add(NumPurgedObjects, std::memory_order_relaxed);
+            return NumPurgedObjects;
+        }
+
+        IMemoryAllocator& m_RawAllocator;
+
+        /// Lock flag that serializes modifications of the registry
         ThreadingTools::LockFlag m_LockFlag;
         
         /// Nmber of outstanding deleted objects that have not been purged
-        Atomics::AtomicLong m_NumDeletedObjects;
+        Atomics::AtomicLong m_NumDeletedObjects{0};
+
+        /// Hash table buckets that contain lists of entries
+        std::atomic<Entry*> m_Buckets[NumBuckets];
+
+        /// Epoch that is advanced every time an entry is retired
+        std::atomic<Uint64> m_GlobalEpoch{1};
+
+        /// Per-thread reader epochs and statistics
+        ReaderSlot m_ReaderSlots[MaxReaderSlots];
+
+        /// Number of Find() calls in progress by threads that have no reader slot
+        std::atomic<Uint32> m_NumOverflowReaders{0};
+
+        /// Entries removed from the table that may still be accessed by readers
+        Entry* m_pRetiredEntries = nullptr;
+
+        size_t m_NumEntries        = 0;
+        Uint32 m_NextBucketToPurge = 0;
 
-        /// Hash map that stores weak pointers to the referenced objects
-        typedef std::pair< const ResourceDescType, RefCntWeakPtr<IDeviceObject> > HashMapElem;
-        std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem> > m_DescToObjHashMap;
+        /// Statistics of threads that have no reader slot
+        std::atomic<Uint64> m_NumHits         {0};
+        std::atomic<Uint64> m_NumMisses       {0};
+        std::atomic<Uint64> m_NumExpiredHits  {0};
+        std::atomic<Uint64> m_NumPurgedObjects{0};
+        std::atomic<Uint64> m_NumPurges       {0};
 
         /// Registry name used for debug output
         const String m_RegistryName;
@@ -130,6 +130,13 @@ struct BufferDesc : DeviceObjectAttribs
     /// on the format size and assuming that elements are densely packed.
     Uint32 ElementByteStride;
 
+    /// Command queues that access the buffer, see Diligent::COMMAND_QUEUE_FLAGS for details.
+
+    /// Initial data is always uploaded by the graphics queue. In Vulkan, a buffer that is accessed by 
+    /// queues from more than one queue family is created with VK_SHARING_MODE_CONCURRENT, which may
+    /// be slower. Otherwise, the buffer must only be used by the graphics queue.
+    Uint32 CommandQueueFlags;
+
     /// Initializes the structure members with default values
 
     /// Default values:
@@ -141,6 +148,7 @@ struct BufferDesc : DeviceObjectAttribs
     /// CPUAccessFlags      | 0
     /// Mode                | Diligent::BUFFER_MODE_UNDEFINED
     /// ElementByteStride   | 0
+    /// CommandQueueFlags   | Diligent::COMMAND_QUEUE_FLAG_GRAPHICS
     /// Members of BufferDesc::Format are initialized with default values by BufferFormat::BufferFormat()
     BufferDesc() : 
         uiSizeInBytes(0),
@@ -148,7 +156,8 @@ struct BufferDesc : DeviceObjectAttribs
         Usage(USAGE_DEFAULT),
         CPUAccessFlags(0),
         Mode( BUFFER_MODE_UNDEFINED ),
-        ElementByteStride(0)
+        ElementByteStride(0),
+        CommandQueueFlags(COMMAND_QUEUE_FLAG_GRAPHICS)
     {}
 
 
@@ -168,7 +177,8 @@ struct BufferDesc : DeviceObjectAttribs
                CPUAccessFlags    == RHS.CPUAccessFlags &&
                Mode              == RHS.Mode           &&
                Format            == RHS.Format         &&
-               ElementByteStride == RHS.ElementByteStride;
+               ElementByteStride == RHS.ElementByteStride &&
+               CommandQueueFlags == RHS.CommandQueueFlags;
     }
 };
 
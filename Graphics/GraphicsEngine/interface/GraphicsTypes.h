@@ -1271,6 +1271,42 @@ namespace Diligent
         Uint32 NumCommandsToFlushCmdList = 256;
     };
 
+    /// Command queue types
+
+    /// The enumeration is used by EngineVkAttribs to select the queue that
+    /// a deferred context records commands for
+    enum COMMAND_QUEUE_TYPE : Uint8
+    {
+        /// Main queue that supports graphics, compute and transfer operations
+        COMMAND_QUEUE_TYPE_GRAPHICS = 0,
+
+        /// Queue from a dedicated compute queue family that supports compute and
+        /// transfer operations
+        COMMAND_QUEUE_TYPE_COMPUTE,
+
+        /// Queue from a dedicated transfer queue family that only supports transfer operations
+        COMMAND_QUEUE_TYPE_TRANSFER,
+
+        /// Helper value that stores the total number of queue types in the enumeration
+        COMMAND_QUEUE_TYPE_NUM_TYPES
+    };
+
+    /// Command queue flags
+
+    /// The enumeration is used by BufferDesc and TextureDesc to describe the command queues
+    /// that access the resource. The flags are only used by Vulkan backend.
+    enum COMMAND_QUEUE_FLAGS : Uint32
+    {
+        /// The resource is accessed by the graphics queue
+        COMMAND_QUEUE_FLAG_GRAPHICS = 1 << COMMAND_QUEUE_TYPE_GRAPHICS,
+
+        /// The resource is accessed by the dedicated compute queue
+        COMMAND_QUEUE_FLAG_COMPUTE  = 1 << COMMAND_QUEUE_TYPE_COMPUTE,
+
+        /// The resource is accessed by the dedicated transfer queue
+        COMMAND_QUEUE_FLAG_TRANSFER = 1 << COMMAND_QUEUE_TYPE_TRANSFER
+    };
+
     /// Attributes specific to Vulkan engine
     struct EngineVkAttribs : public EngineCreationAttribs
     {
@@ -1286,6 +1322,13 @@ namespace Diligent
         /// Allocator used as pAllocator parameter in callse to Vulkan Create* functions
         void *pVkAllocator = nullptr;
 
+        /// Create the device without presentation support. Surface and swap chain extensions
+        /// are not required and are not enabled, so that the engine can run on servers and 
+        /// with software implementations that expose no window system. Swap chains cannot be 
+        /// created for a headless device: the application renders into textures and must call 
+        /// IRenderDeviceVk::FinishFrame() at the end of every frame.
+        bool Headless = false;
+
         /// Number of commands to flush the command buffer. Only draw/dispatch commands count
         /// towards the limit. Command buffers are only flushed when pipeline state is changed
         /// or when backbuffer is presented.
@@ -1376,6 +1419,11 @@ namespace Diligent
         /// pages when resources are released
         Uint32 HostVisibleMemoryReserveSize = 256 << 20;
 
+        /// Use two-level segregated fit allocator to manage free space in device memory pages.
+        /// The allocator performs allocations and deallocations in constant time, 
+        /// while the default map-based allocator takes logarithmic time.
+        bool UseTLSFMemoryAllocator = false;
+
         /// Page size for the upload heap used by the immediate context.
         /// Upload heap is used to update resources with UpdateData()
         Uint32 ImmediateCtxUploadHeapPageSize = 1 << 20;
@@ -1407,6 +1455,39 @@ namespace Diligent
         /// the global dynamic heap ring buffer to perform lock-free dynamic 
         /// allocations from
         Uint32 DeferredCtxDynamicHeapPageSize = 64 << 10;
+
+        /// Size of the ring buffer that is used to stage initial data of buffers and textures.
+        /// Data that does not fit into the ring buffer is staged in dedicated buffers.
+        Uint32 UploadRingBufferSize = 32 << 20;
+
+        /// Amount of initial data after which the pending upload batch is submitted for execution.
+        /// Otherwise, the batch is submitted along with the next command buffer.
+        Uint32 UploadBatchSize = 8 << 20;
+
+        /// Initial contents of the device pipeline cache, typically retrieved by 
+        /// IRenderDeviceVk::GetPipelineCacheData() during the previous run. The data is ignored 
+        /// if it was produced by a different device or driver. The memory only needs to be valid
+        /// during the device initialization.
+        const void* pPipelineCacheData = nullptr;
+
+        /// Size of the initial pipeline cache data, in bytes
+        size_t PipelineCacheDataSize = 0;
+
+        /// Create a queue from a dedicated compute queue family (a family that supports compute,
+        /// but not graphics operations), if the device exposes one
+        bool EnableComputeQueue = false;
+
+        /// Create a queue from a dedicated transfer queue family (a family that supports neither 
+        /// graphics nor compute operations), if the device exposes one
+        bool EnableTransferQueue = false;
+
+        /// Array of NumDeferredContexts elements that specifies the queue every deferred context 
+        /// records commands for. If null, all deferred contexts use the graphics queue. A context 
+        /// that requests a queue that has not been created falls back to the graphics queue.
+        /// Buffers and textures used by a context that records commands for a dedicated queue 
+        /// must include the queue in BufferDesc::CommandQueueFlags or TextureDesc::CommandQueueFlags.
+        /// The memory only needs to be valid during the device initialization.
+        const COMMAND_QUEUE_TYPE* pDeferredContextQueues = nullptr;
     };
 
     /// Box
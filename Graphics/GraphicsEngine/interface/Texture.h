@@ -130,6 +130,13 @@ struct TextureDesc : DeviceObjectAttribs
     /// Optimized clear value
     OptimizedClearValue ClearValue;
 
+    /// Command queues that access the texture, see Diligent::COMMAND_QUEUE_FLAGS for details.
+
+    /// Initial data is always uploaded by the graphics queue. In Vulkan, a texture that is accessed by 
+    /// queues from more than one queue family is created with VK_SHARING_MODE_CONCURRENT, which may
+    /// be slower. Otherwise, the texture must only be used by the graphics queue.
+    Uint32 CommandQueueFlags;
+
     /// Initializes the structure members with default values
 
     /// Default values:
@@ -146,6 +153,7 @@ struct TextureDesc : DeviceObjectAttribs
     /// BindFlags       | 0
     /// CPUAccessFlags  | 0
     /// MiscFlags       | 0
+    /// CommandQueueFlags | COMMAND_QUEUE_FLAG_GRAPHICS
     TextureDesc() : 
         Type(RESOURCE_DIM_UNDEFINED),
         Width(0),
@@ -157,7 +165,8 @@ struct TextureDesc : DeviceObjectAttribs
         Usage(USAGE_DEFAULT),
         BindFlags(0),
         CPUAccessFlags(0),
-        MiscFlags(0)
+        MiscFlags(0),
+        CommandQueueFlags(COMMAND_QUEUE_FLAG_GRAPHICS)
     {
     }
 
@@ -185,7 +194,8 @@ struct TextureDesc : DeviceObjectAttribs
                 BindFlags      == RHS.BindFlags      &&
                 CPUAccessFlags == RHS.CPUAccessFlags &&
                 MiscFlags      == RHS.MiscFlags      &&
-                ClearValue     == RHS.ClearValue;
+                ClearValue     == RHS.ClearValue     &&
+                CommandQueueFlags == RHS.CommandQueueFlags;
     }
 };
 
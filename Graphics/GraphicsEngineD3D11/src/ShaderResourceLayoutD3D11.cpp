@@ -34,6 +34,7 @@
 #include "SamplerD3D11Impl.h"
 #include "D3DShaderResourceLoader.h"
 #include "ShaderD3D11Impl.h"
+#include "StringInterner.h"
 
 namespace Diligent
 {
@@ -334,27 +335,27 @@ void ShaderResourceLayoutD3D11::InitVariablesHashMap()
     HandleResources(
         [&](ConstBuffBindInfo&cb)
         {
-            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(cb.Attribs.Name, true), &cb ) );
+            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(cb.Attribs.Name)), &cb ) );
         },
 
         [&](TexAndSamplerBindInfo& ts)
         {
-            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(ts.Attribs.Name, true), &ts ) );
+            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(ts.Attribs.Name)), &ts ) );
         },
 
         [&](TexUAVBindInfo& uav)
         {
-            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(uav.Attribs.Name, true), &uav ) );
+            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(uav.Attribs.Name)), &uav ) );
         },
 
         [&](BuffSRVBindInfo& srv)
         {
-            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(srv.Attribs.Name, true), &srv ) );
+            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(srv.Attribs.Name)), &srv ) );
         },
 
         [&](BuffUAVBindInfo& uav)
         {
-            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(uav.Attribs.Name, true), &uav ) );
+            m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(uav.Attribs.Name)), &uav ) );
         }
     );
 #endif
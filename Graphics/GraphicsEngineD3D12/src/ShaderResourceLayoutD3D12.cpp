@@ -34,6 +34,7 @@
 #include "ShaderD3D12Impl.h"
 #include "RootSignature.h"
 #include "PipelineStateD3D12Impl.h"
+#include "StringInterner.h"
 
 namespace Diligent
 {
@@ -441,8 +442,8 @@ void ShaderResourceLayoutD3D12::InitVariablesHashMap()
     for(Uint32 r=0; r < TotalResources; ++r)
     {
         auto &Res = GetSrvCbvUav(r);
-        /* HashMapStringKey will make a copy of the string*/
-        m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(Res.Name, true), &Res ) );
+        // Interned names are shared by all layouts and do not need to be copied
+        m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(Res.Name)), &Res ) );
     }
 #endif
 }
@@ -68,6 +68,13 @@ public:
 
     const GLObjectWrappers::GLBufferObj& GetGLHandle(){ return m_GlBuffer; }
 
+    /// Buffer object and offset that hold the current buffer contents. For dynamic uniform 
+    /// buffers streamed through the dynamic heap, this is the last heap allocation.
+    GLuint GetActiveGLBuffer()const{ return m_DynamicAllocation.GLBuffer != 0 ? m_DynamicAllocation.GLBuffer : static_cast<GLuint>(m_GlBuffer); }
+    size_t GetActiveOffset()const{ return m_DynamicAllocation.Offset; }
+    // Active buffer and offset of such buffers change every time the buffer is mapped with MAP_FLAG_DISCARD
+    bool UsesDynamicHeap()const{ return m_bUseDynamicHeap; }
+
     virtual GLuint GetGLBufferHandle()override final { return GetGLHandle(); }
     virtual void* GetNativeHandle()override final { return reinterpret_cast<void*>(static_cast<size_t>(GetGLBufferHandle())); }
 
@@ -81,6 +88,9 @@ private:
     Uint32 m_uiMapTarget;
     const GLenum m_GLUsageHint;
     const Bool m_bUseMapWriteDiscardBugWA;
+    const Bool m_bUseDynamicHeap;
+    Bool m_bMappedInDynamicHeap = False;
+    GLDynamicAllocation m_DynamicAllocation;
 };
 
 }
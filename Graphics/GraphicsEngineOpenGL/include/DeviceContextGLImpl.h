@@ -100,13 +100,35 @@ protected:
     GLContextState m_ContextState;
 
 private:
+    void BindVertexAndIndexBuffers( IBuffer *pIndexBuffer );
+    void RebindDynamicUniformBuffers();
+
     Uint32 m_CommitedResourcesTentativeBarriers;
 
     std::vector<class TextureBaseGL*> m_BoundWritableTextures;
     std::vector<class BufferGLImpl*> m_BoundWritableBuffers;
 
+    // Flat binding tables filled by BindProgramResources(), indexed by the uniform buffer 
+    // binding points and texture units assigned by the pipeline state
+    std::vector<GLuint> m_BoundUniformBuffers;
+    std::vector<GLintptr> m_BoundUniformBufferOffsets;
+    std::vector<GLsizeiptr> m_BoundUniformBufferSizes;
+    // Uniform buffers in the dynamic heap and their binding points. The buffers may be mapped
+    // with MAP_FLAG_DISCARD after the resources are committed, which moves them to a new heap 
+    // offset, so their bindings are refreshed by every draw and dispatch command.
+    std::vector< std::pair<Uint32, class BufferGLImpl*> > m_BoundDynamicUniformBuffers;
+    std::vector<GLenum> m_BoundTextureTargets;
+    std::vector<const GLObjectWrappers::GLTextureObj*> m_pBoundTextures;
+    std::vector<const GLObjectWrappers::GLSamplerObj*> m_pBoundSamplers;
+
     bool m_bVAOIsUpToDate = false;
+    // FBO cache of the current GL context. Cached to avoid taking the device-wide 
+    // lock every time render targets are committed
+    class FBOCache* m_pFBOCache = nullptr;
+    GLContext::NativeGLContextType m_FBOCacheGLContext = {};
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
+    // Null sampler that makes buffer textures use default sampling parameters
+    GLObjectWrappers::GLSamplerObj m_DefaultSampler;
 };
 
 }
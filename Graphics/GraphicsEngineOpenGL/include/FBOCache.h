@@ -23,19 +23,30 @@
 
 #pragma once
 
+#include <list>
 #include "GraphicsTypes.h"
 #include "TextureView.h"
 #include "LockHelper.h"
 #include "HashUtils.h"
 #include "GLObjectWrapper.h"
+#include "RenderDeviceGL.h"
 
 namespace Diligent
 {
 
+/// Cache of framebuffer objects for one GL context.
+
+/// FBOs are not shared between GL contexts, so every context has its own cache (see RenderDeviceGLImpl::GetFBOCache()).
+/// The number of FBOs is bounded by the cache size; least recently used FBOs are evicted first.
+/// GetFBO() must only be called from the thread that owns the context. The cache is still protected by its own 
+/// lock because OnReleaseTexture() may be called from any thread.
 class FBOCache
 {
 public:
-    FBOCache();
+    using Statistics = FBOCacheStatistics;
+
+    /// \param [in] MaxSize - maximum number of FBOs in the cache; zero means no limit.
+    FBOCache(Uint32 MaxSize);
     ~FBOCache();
 
     FBOCache(const FBOCache&)  = delete;
@@ -49,6 +60,8 @@ public:
                                                        class GLContextState &ContextState);
     void OnReleaseTexture(ITexture *pTexture);
 
+    Statistics GetStatistics();
+
 private:
     // This structure is used as the key to find FBO
     struct FBOCacheKey
@@ -85,13 +98,34 @@ private:
     };
 
 
+    struct FBOCacheEntry
+    {
+        FBOCacheEntry(GLObjectWrappers::GLFrameBufferObj &&_FBO, std::list<FBOCacheKey>::iterator _LRUIt) : 
+            FBO(std::move(_FBO)),
+            LRUIt(_LRUIt)
+        {}
+
+        GLObjectWrappers::GLFrameBufferObj FBO;
+        // Position of the key in the LRU list
+        std::list<FBOCacheKey>::iterator LRUIt;
+    };
+    typedef std::unordered_map<FBOCacheKey, FBOCacheEntry, FBOCacheKeyHashFunc> CacheMapType;
+
+    void EraseEntry(CacheMapType::iterator It);
+
     friend class RenderDeviceGLImpl;
     ThreadingTools::LockFlag m_CacheLockFlag;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
+    CacheMapType m_Cache;
+
+    // Keys ordered from the most recently to the least recently used
+    std::list<FBOCacheKey> m_LRUList;
+    const Uint32 m_MaxSize;
     
     // Multimap that sets up correspondence between unique texture id and all
     // FBOs it is used in
     std::unordered_multimap<Diligent::UniqueIdentifier, FBOCacheKey> m_TexIdToKey;
+
+    Statistics m_Stats;
 };
 
 }
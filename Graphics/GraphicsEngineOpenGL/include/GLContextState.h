@@ -43,6 +43,17 @@ public:
     void SetActiveTexture( Int32 Index );
     void BindTexture( Int32 Index, GLenum BindTarget, const GLObjectWrappers::GLTextureObj &Tex);
     void BindSampler( Uint32 Index, const GLObjectWrappers::GLSamplerObj &GLSampler);
+    // Bind textures/samplers to NumUnits consecutive units starting at FirstUnit. Null entries 
+    // are skipped. When GL_ARB_multi_bind is available, every contiguous run of units
+    // that has changed is bound with a single glBindTextures()/glBindSamplers() call
+    void BindTextures( Uint32 FirstUnit, Uint32 NumUnits, const GLenum *BindTargets, const GLObjectWrappers::GLTextureObj* const* ppTextures );
+    void BindSamplers( Uint32 FirstUnit, Uint32 NumUnits, const GLObjectWrappers::GLSamplerObj* const* ppSamplers );
+    // Vertex buffer and index buffer bindings are part of the VAO state, so they are only 
+    // tracked until a different VAO is bound. Used with GL_ARB_vertex_attrib_binding.
+    void BindVertexBuffers( Uint32 FirstSlot, Uint32 NumSlots, const GLObjectWrappers::GLBufferObj* const* ppBuffers, const GLintptr *pOffsets, const GLsizei *pStrides );
+    void BindIndexBuffer( const GLObjectWrappers::GLBufferObj &Buffer );
+    // Binds ranges of NumBindings uniform buffers starting at FirstBinding. Zero handles unbind the slot
+    void BindUniformBuffers( Uint32 FirstBinding, Uint32 NumBindings, const GLuint *pBuffers, const GLintptr *pOffsets, const GLsizeiptr *pSizes );
     void BindImage( Uint32 Index, class TextureViewGLImpl *pTexView, GLint MipLevel, GLboolean IsLayered, GLint Layer, GLenum Access, GLenum Format );
     void EnsureMemoryBarrier(Uint32 RequiredBarriers, class AsyncWritableResource *pRes = nullptr);
     void SetPendingMemoryBarriers( Uint32 PendingBarriers );
@@ -80,6 +91,9 @@ public:
     struct ContextCaps
     {
         bool bFillModeSelectionSupported = True;
+        bool bMultiBindSupported = false;
+        bool bVertexAttribBindingSupported = false;
+        GLint m_iMaxVertexAttribRelativeOffset = 0;
         GLint m_iMaxCombinedTexUnits = 0;
         GLint m_iMaxDrawBuffers = 0;
     };
@@ -135,6 +149,18 @@ private:
         }
     };
     std::vector< BoundImageInfo > m_BoundImages;
+    struct BoundVertexBufferInfo
+    {
+        Diligent::UniqueIdentifier BufferID = -1;
+        GLintptr Offset = 0;
+        GLsizei Stride = 0;
+    };
+    // Vertex buffers and index buffer bound to the current VAO
+    std::vector< BoundVertexBufferInfo > m_BoundVertexBuffers;
+    Diligent::UniqueIdentifier m_IndexBufferId = -1;
+
+    // Scratch array of GL handles passed to multi-bind functions
+    std::vector< GLuint > m_MultiBindHandles;
 
     Uint32 m_PendingMemoryBarriers = 0;
 
@@ -0,0 +1,92 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <deque>
+#include "BasicTypes.h"
+#include "MemoryAllocator.h"
+#include "RingBuffer.h"
+#include "GLObjectWrapper.h"
+
+namespace Diligent
+{
+
+/// Space suballocated from the dynamic heap
+struct GLDynamicAllocation
+{
+    GLuint GLBuffer    = 0;       // Heap buffer handle, zero if the allocation failed
+    size_t Offset      = 0;       // Offset from the start of the heap buffer
+    size_t Size        = 0;       // Reserved size of the allocation
+    Uint8* pCPUAddress = nullptr; // Persistently mapped CPU address of the allocation
+    Uint64 FrameNumber = 0;       // Frame the allocation belongs to
+};
+
+/// Streaming heap for USAGE_DYNAMIC buffers
+
+/// The heap is a single buffer with immutable storage (GL_ARB_buffer_storage) that is
+/// mapped once with GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT. Space is suballocated
+/// in ring-buffer fashion, so mapping a dynamic buffer never makes the driver orphan
+/// or reallocate its storage. Every frame is guarded by a fence sync object, and the space
+/// used by the frame is only reused after the GPU has signaled that fence.
+/// The class is not thread-safe, which matches the single immediate context of the GL backend.
+class GLDynamicHeap
+{
+public:
+    GLDynamicHeap(IMemoryAllocator &Allocator, Uint32 Size);
+    ~GLDynamicHeap();
+
+    GLDynamicHeap             (const GLDynamicHeap&) = delete;
+    GLDynamicHeap             (GLDynamicHeap&&)      = delete;
+    GLDynamicHeap& operator = (const GLDynamicHeap&) = delete;
+    GLDynamicHeap& operator = (GLDynamicHeap&&)      = delete;
+
+    /// Allocates space aligned to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT. If the heap is full, waits
+    /// for the oldest finished frame to complete. Returns an allocation with a zero buffer handle 
+    /// if the request cannot be satisfied without waiting for the current frame.
+    GLDynamicAllocation Allocate(Uint32 SizeInBytes);
+
+    /// Inserts a fence that guards all space allocated since the previous call and releases
+    /// space used by frames that the GPU has already completed
+    void FinishFrame();
+
+    GLuint GetGLBuffer()const{ return m_GlBuffer; }
+
+    /// Space allocated in earlier frames may be reused as soon as their fences are signaled
+    Uint64 GetCurrentFrameNumber()const{ return m_CurrentFrameNumber; }
+
+private:
+    // Returns true if space used by at least one frame has been released
+    bool ReleaseCompletedFrames(bool WaitForOldestFrame);
+
+    const Uint32 m_Alignment;
+    RingBuffer m_RingBuffer;
+    GLObjectWrappers::GLBufferObj m_GlBuffer;
+    Uint8* m_pCPUAddress = nullptr;
+
+    Uint64 m_CurrentFrameNumber = 1;
+    bool m_bCurrentFrameHasAllocations = false;
+    std::deque< std::pair<Uint64, GLObjectWrappers::GLSyncObj> > m_FrameFences;
+};
+
+}
@@ -45,6 +45,19 @@ namespace Diligent
 
         const GLProgramResources& GetAllResources()const{return m_AllResources;}
         GLProgramResources& GetConstantResources(){return m_ConstantResources;}
+
+        // Counts uniform buffer binding points and texture units used by static resources
+        // and by mutable and dynamic resources
+        void CountResourceBindings(Uint32 &NumStaticUniformBindings, 
+                                   Uint32 &NumDynamicUniformBindings,
+                                   Uint32 &NumStaticTextureUnits,
+                                   Uint32 &NumDynamicTextureUnits)const;
+
+        // Assigns consecutive uniform buffer binding points and texture units to all 
+        // uniform blocks and samplers: static resources first, then mutable and dynamic 
+        // ones. Does nothing if the program already uses the same assignment.
+        // If UseProgramUniform is false, the program must be current.
+        void ApplyResourceBindings(Uint32 FirstUniformBinding, Uint32 FirstTextureUnit, bool UseProgramUniform);
         
 
 #ifdef VERIFY_RESOURCE_BINDINGS
@@ -59,6 +72,8 @@ namespace Diligent
 
         GLProgramResources m_AllResources;
         GLProgramResources m_ConstantResources;
+        Uint32 m_FirstUniformBinding = static_cast<Uint32>(-1);
+        Uint32 m_FirstTextureUnit = static_cast<Uint32>(-1);
         // When adding new member DO NOT FORGET TO UPDATE GLProgram( GLProgram&& Program )!!!
     };
 }
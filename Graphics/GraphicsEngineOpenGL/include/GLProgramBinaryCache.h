@@ -0,0 +1,97 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "BasicTypes.h"
+#include "LockHelper.h"
+#include "DataBlob.h"
+#include "EngineGLAttribs.h"
+
+namespace Diligent
+{
+
+/// Cache of linked program binaries (GL_ARB_get_program_binary)
+
+/// Programs are identified by a key computed from the final GLSL source of all their shaders.
+/// Binaries are kept in memory and can optionally be stored in a user-supplied directory 
+/// (one file per program, named after the program key) or serialized to a data blob. 
+/// Every stored binary records a hash of the vendor, renderer and version strings of the driver
+/// it was produced by. Binaries from a different driver are ignored: a stale program file is 
+/// deleted when it is read and is written again once the program is relinked, so the directory
+/// does not grow when the driver is updated.
+class GLProgramBinaryCache
+{
+public:
+    GLProgramBinaryCache(const EngineGLAttribs& InitAttribs);
+
+    GLProgramBinaryCache(const GLProgramBinaryCache&)  = delete;
+    GLProgramBinaryCache(      GLProgramBinaryCache&&) = delete;
+    GLProgramBinaryCache& operator = (const GLProgramBinaryCache&)  = delete;
+    GLProgramBinaryCache& operator = (      GLProgramBinaryCache&&) = delete;
+
+    bool IsEnabled()const{return m_IsEnabled;}
+
+    /// Computes the key of the program linked from the given shader sources
+    Uint64 ComputeProgramKey(bool IsSeparable, Uint32 NumSources, const std::string* const* ppSources)const;
+
+    /// Loads the program binary with the given key into the program object. 
+    /// Returns false if the binary is not found or if the driver rejects it.
+    bool LoadProgram(Uint64 ProgramKey, GLuint Program);
+
+    /// Must be called before the program is linked to let the driver know that its binary will be retrieved
+    void PrepareForLinking(GLuint Program)const;
+
+    /// Retrieves the binary of the linked program and adds it to the cache
+    void StoreProgram(Uint64 ProgramKey, GLuint Program);
+
+    /// Serializes all program binaries in the cache
+    void Serialize(IDataBlob** ppCacheData);
+
+private:
+    struct ProgramBinary
+    {
+        GLenum             Format = 0;
+        std::vector<Uint8> Data;
+    };
+    using ProgramBinaryMap = std::unordered_map<Uint64, ProgramBinary>;
+
+    // Parses the binaries produced by the current driver into Programs. Does not access the cache.
+    void ParsePrograms(const Uint8* pData, size_t Size, const Char* SourceName, ProgramBinaryMap& Programs)const;
+    // Deletes the file if it was produced by a different driver
+    bool ReadProgramFile(Uint64 ProgramKey, ProgramBinaryMap& Programs)const;
+    std::string GetProgramFilePath(Uint64 ProgramKey)const;
+
+    bool        m_IsEnabled  = false;
+    Uint64      m_DriverHash = 0;
+    std::string m_CacheDir;
+
+    // Only guards access to m_Programs. File IO and GL calls are never performed under the lock.
+    ThreadingTools::LockFlag m_CacheLockFlag;
+    ProgramBinaryMap m_Programs;
+};
+
+}
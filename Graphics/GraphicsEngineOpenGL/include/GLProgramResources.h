@@ -100,6 +100,7 @@ namespace Diligent
             GLuint Index;
         };
         std::vector<UniformBufferInfo>& GetUniformBlocks(){ return m_UniformBlocks; }
+        const std::vector<UniformBufferInfo>& GetUniformBlocks()const{ return m_UniformBlocks; }
 
         struct SamplerInfo : GLProgramVariableBase
         {
@@ -127,6 +128,7 @@ namespace Diligent
             RefCntAutoPtr<class SamplerGLImpl> pStaticSampler;
         };
         std::vector<SamplerInfo>& GetSamplers(){ return m_Samplers; }
+        const std::vector<SamplerInfo>& GetSamplers()const{ return m_Samplers; }
         
         struct ImageInfo : GLProgramVariableBase
         {
@@ -57,12 +57,41 @@ public:
     GLProgram &GetGLProgram(){return m_GLProgram;}
     GLObjectWrappers::GLPipelineObj &GetGLProgramPipeline(GLContext::NativeGLContextType Context);
 
+    /// Returns the VAO that holds the vertex format of the input layout (GL_ARB_vertex_attrib_binding) in the 
+    /// given context. Vertex buffers are bound to the VAO separately, so a single VAO serves all draws with this
+    /// pipeline state. Returns null if the layout cannot be expressed this way, in which case VAOCache must be used.
+    const GLObjectWrappers::GLVertexArrayObj* GetVertexFormatVAO(GLContext::NativeGLContextType Context, class GLContextState &GLContextState);
+
+    /// First uniform buffer binding point and texture unit assigned to static and to 
+    /// mutable/dynamic resources of one program. Bindings within every group are consecutive
+    /// and follow the order of resources in GLProgramResources.
+    struct ProgramResourceBindings
+    {
+        Uint32 FirstStaticUniformBinding  = 0;
+        Uint32 FirstDynamicUniformBinding = 0;
+        Uint32 FirstStaticTextureUnit     = 0;
+        Uint32 FirstDynamicTextureUnit    = 0;
+    };
+    /// One entry per program: every shader when program pipelines are used, the single linked program otherwise
+    const ProgramResourceBindings& GetProgramResourceBindings(Uint32 ProgNum)const{ return m_ResourceBindings[ProgNum]; }
+    Uint32 GetNumUniformBindings()const{ return m_NumUniformBindings; }
+    Uint32 GetNumTextureUnits()const{ return m_NumTextureUnits; }
+
 private:
     void LinkGLProgram(bool bIsProgramPipelineSupported);
+    void InitResourceBindings(bool bIsProgramPipelineSupported);
 
     GLProgram m_GLProgram;
     ThreadingTools::LockFlag m_ProgPipelineLockFlag;
     std::unordered_map<GLContext::NativeGLContextType, GLObjectWrappers::GLPipelineObj> m_GLProgPipelines;
+
+    ThreadingTools::LockFlag m_VAOLockFlag;
+    std::unordered_map<GLContext::NativeGLContextType, GLObjectWrappers::GLVertexArrayObj> m_VertexFormatVAOs;
+    bool m_bVertexFormatVAOSupported = true;
+
+    std::vector<ProgramResourceBindings> m_ResourceBindings;
+    Uint32 m_NumUniformBindings = 0;
+    Uint32 m_NumTextureUnits = 0;
 };
 
 }
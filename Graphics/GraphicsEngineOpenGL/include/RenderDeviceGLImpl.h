@@ -30,6 +30,8 @@
 #include "FBOCache.h"
 #include "TexRegionRender.h"
 #include "EngineGLAttribs.h"
+#include "GLProgramBinaryCache.h"
+#include "GLDynamicHeap.h"
 
 enum class GPU_VENDOR
 {
@@ -79,8 +81,18 @@ public:
 
     virtual void CreateBufferFromGLHandle(Uint32 GLHandle, const BufferDesc &BuffDesc, IBuffer **ppBuffer)override final;
 
+    virtual void GetProgramBinaryCacheData(IDataBlob **ppCacheData)override final;
+
+    virtual void GetFBOCacheStatistics(void *pNativeGLContext, FBOCacheStatistics &Stats)override final;
+
     const GPUInfo& GetGPUInfo(){ return m_GPUInfo; }
 
+    GLProgramBinaryCache& GetProgramBinaryCache(){ return m_ProgramBinaryCache; }
+
+    /// Returns null if the dynamic heap is disabled or not supported
+    GLDynamicHeap* GetDynamicHeap(){ return m_pDynamicHeap.get(); }
+
+    /// Returns the FBO cache of the given context. The reference stays valid for the lifetime of the device.
     FBOCache& GetFBOCache(GLContext::NativeGLContextType Context);
     void OnReleaseTexture(ITexture *pTexture);
 
@@ -101,12 +113,18 @@ protected:
     // Must be the first member because its constructor initializes OpenGL
     GLContext m_GLContext; 
 
+    GLProgramBinaryCache m_ProgramBinaryCache;
+
     std::unordered_set<String> m_ExtensionStrings;
 
+    std::unique_ptr<GLDynamicHeap> m_pDynamicHeap;
+
     ThreadingTools::LockFlag m_VAOCacheLockFlag;
     std::unordered_map<GLContext::NativeGLContextType, VAOCache> m_VAOCache;
 
+    // The lock only protects the map itself; every FBOCache has its own lock
     ThreadingTools::LockFlag m_FBOCacheLockFlag;
+    const Uint32 m_FBOCacheSize;
     std::unordered_map<GLContext::NativeGLContextType, FBOCache> m_FBOCache;
 
     GPUInfo m_GPUInfo;
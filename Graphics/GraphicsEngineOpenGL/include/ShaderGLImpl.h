@@ -81,6 +81,9 @@ public:
 
     GLProgram& GetGlProgram(){return m_GlProgObj;}
 
+    /// Returns the shader object, compiling the shader first if this has not been done yet
+    const GLObjectWrappers::GLShaderObj& GetGLShaderObj();
+
 private:
 
     friend class PipelineStateGLImpl;
@@ -88,6 +91,8 @@ private:
 
     GLProgram m_GlProgObj;  // Used if program pipeline supported
     GLObjectWrappers::GLShaderObj m_GLShaderObj; // Used if program pipelines are not supported
+    // GLSL source used to compute program binary cache keys if program pipelines are not supported
+    std::string m_GLSLSource;
 };
 
 }
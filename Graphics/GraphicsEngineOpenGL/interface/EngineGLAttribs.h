@@ -44,5 +44,31 @@ namespace Diligent
         /// For linux platform only, this is the pointer to the display
         void *pDisplay = nullptr;
 #endif
+
+        /// Whether to cache linked program binaries. The cache is only enabled
+        /// if the driver supports at least one program binary format.
+        bool EnableProgramBinaryCache = false;
+
+        /// Directory where program binaries are stored, one file per program. 
+        /// The directory must exist. If null, the binaries are only kept in memory
+        /// and can be retrieved by IRenderDeviceGL::GetProgramBinaryCacheData().
+        const Char *ProgramBinaryCacheDir = nullptr;
+
+        /// Program binary cache data previously retrieved by IRenderDeviceGL::GetProgramBinaryCacheData()
+        const void *pProgramBinaryCacheData = nullptr;
+
+        /// Size of the program binary cache data, in bytes
+        Uint32 ProgramBinaryCacheDataSize = 0;
+
+        /// Size of the persistently mapped ring buffer that USAGE_DYNAMIC uniform buffers
+        /// are suballocated from when they are mapped with MAP_FLAG_DISCARD. The heap requires 
+        /// OpenGL 4.4 or GL_ARB_buffer_storage. Zero disables the heap, in which case mapping 
+        /// a dynamic buffer orphans its storage.
+        Uint32 DynamicHeapSize = 8 << 20;
+
+        /// Maximum number of framebuffer objects cached per GL context. When the limit is reached,
+        /// the least recently used FBO is destroyed. Zero means that the cache size is not limited.
+        /// Cache hits, misses and evictions are reported by IRenderDeviceGL::GetFBOCacheStatistics().
+        Uint32 FBOCacheSize = 256;
     };
 }
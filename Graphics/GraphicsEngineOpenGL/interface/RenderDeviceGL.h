@@ -27,6 +27,7 @@
 /// Definition of the Diligent::IRenderDeviceGL interface
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Primitives/interface/DataBlob.h"
 
 /// Namespace for the OpenGL implementation of the graphics engine
 namespace Diligent
@@ -36,6 +37,19 @@ namespace Diligent
 static constexpr INTERFACE_ID IID_RenderDeviceGL =
 { 0xb4b395b9, 0xac99, 0x4e8a, { 0xb7, 0xe1, 0x9d, 0xca, 0xd, 0x48, 0x56, 0x18 } };
 
+/// Framebuffer object cache statistics of one GL context
+struct FBOCacheStatistics
+{
+    /// Number of times a cached FBO was reused
+    Uint64 NumHits      = 0;
+
+    /// Number of FBOs that were created because no matching FBO was found in the cache
+    Uint64 NumMisses    = 0;
+
+    /// Number of FBOs destroyed because the cache reached EngineGLAttribs::FBOCacheSize
+    Uint64 NumEvictions = 0;
+};
+
 /// Interface to the render device object implemented in OpenGL
 class IRenderDeviceGL : public IRenderDevice
 {
@@ -68,6 +82,25 @@ public:
     /// \note  Diligent engine buffer object does not take ownership of the GL resource, 
     ///        and the application must not destroy it while it is in use by the engine.
     virtual void CreateBufferFromGLHandle(Uint32 GLHandle, const BufferDesc &BuffDesc, IBuffer **ppBuffer) = 0;
+
+    /// Serializes all program binaries in the program binary cache
+
+    /// \param [out] ppCacheData - Address of the memory location where the pointer to the
+    ///                            data blob will be stored. The blob is empty if the cache
+    ///                            is disabled.
+    /// \note  The data can be passed to EngineGLAttribs::pProgramBinaryCacheData when the
+    ///        device is created next time. Binaries produced by a different driver are ignored.
+    virtual void GetProgramBinaryCacheData(IDataBlob **ppCacheData) = 0;
+
+    /// Returns framebuffer object cache statistics
+
+    /// \param [in] pNativeGLContext - Native GL context handle (HGLRC on Windows, GLXContext on Linux,
+    ///                               EGLContext on Android). If null, the context that is current
+    ///                               in the calling thread is used.
+    /// \param [out] Stats - Statistics of the FBO cache of the context. All values are zero
+    ///                      if the engine has not rendered to the context.
+    /// \note  FBOs are not shared between GL contexts, so every context has its own cache.
+    virtual void GetFBOCacheStatistics(void *pNativeGLContext, FBOCacheStatistics &Stats) = 0;
 };
 
 }
@@ -41,13 +41,25 @@ static bool GetUseMapWriteDiscardBugWA(RenderDeviceGLImpl *pDeviceGL)
     return pDeviceGL->GetGPUInfo().Vendor == GPU_VENDOR::INTEL;
 }
 
+static bool GetUseDynamicHeap(RenderDeviceGLImpl *pDeviceGL, const BufferDesc& Desc)
+{
+    // Only uniform buffers are streamed through the dynamic heap as they are bound with an offset
+    // via glBindBufferRange(). Vertex buffers are baked into VAOs and the rest need views.
+    return Desc.Usage == USAGE_DYNAMIC && Desc.BindFlags == BIND_UNIFORM_BUFFER && pDeviceGL->GetDynamicHeap() != nullptr;
+}
+
 static GLenum GetBufferBindTarget(const BufferDesc& Desc)
 {
     GLenum Target = GL_ARRAY_BUFFER;
     if (Desc.BindFlags & BIND_VERTEX_BUFFER)
         Target = GL_ARRAY_BUFFER;
     else if(Desc.BindFlags & BIND_INDEX_BUFFER)
-        Target = GL_ELEMENT_ARRAY_BUFFER;
+    {
+        // GL_ELEMENT_ARRAY_BUFFER binding is part of the currently bound VAO state, so 
+        // binding the buffer to this target would detach index buffer from that VAO.
+        // All targets are equivalent from a transfer point of view, so use GL_ARRAY_BUFFER
+        Target = GL_ARRAY_BUFFER;
+    }
     else if (Desc.BindFlags & BIND_UNIFORM_BUFFER)
         Target = GL_UNIFORM_BUFFER;
     else if(Desc.BindFlags & BIND_INDIRECT_DRAW_ARGS)
@@ -77,7 +89,8 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters *pRefCounters,
     m_GlBuffer(true), // Create buffer immediately
     m_uiMapTarget(0),
     m_GLUsageHint(UsageToGLUsage(BuffDesc.Usage)),
-    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL))
+    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL)),
+    m_bUseDynamicHeap(GetUseDynamicHeap(pDeviceGL, BuffDesc))
 {
     if( BuffDesc.Usage == USAGE_STATIC && BuffData.pData == nullptr )
         LOG_ERROR_AND_THROW("Static buffer must be initialized with data at creation time");
@@ -173,7 +186,8 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters *pRefCounters,
     m_GlBuffer(true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)),
     m_uiMapTarget(0),
     m_GLUsageHint(UsageToGLUsage(BuffDesc.Usage)),
-    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL))
+    m_bUseMapWriteDiscardBugWA(GetUseMapWriteDiscardBugWA(pDeviceGL)),
+    m_bUseDynamicHeap(false)
 {
 }
 
@@ -228,8 +242,8 @@ void BufferGLImpl :: CopyData(IDeviceContext *pContext, IBuffer *pSrcBuffer, Uin
     // the purposes of copying or staging data without disturbing OpenGL state or needing to keep track of 
     // what was bound to the target before your copy.
     glBindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer);
-    glBindBuffer(GL_COPY_READ_BUFFER, pSrcBufferGL->m_GlBuffer);
-    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, SrcOffset, DstOffset, Size);
+    glBindBuffer(GL_COPY_READ_BUFFER, pSrcBufferGL->GetActiveGLBuffer());
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, pSrcBufferGL->GetActiveOffset() + SrcOffset, DstOffset, Size);
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     glBindBuffer(GL_COPY_READ_BUFFER, 0);
     glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
@@ -238,7 +252,29 @@ void BufferGLImpl :: CopyData(IDeviceContext *pContext, IBuffer *pSrcBuffer, Uin
 void BufferGLImpl :: Map(IDeviceContext *pContext, MAP_TYPE MapType, Uint32 MapFlags, PVoid &pMappedData)
 {
     TBufferBase::Map( pContext, MapType, MapFlags, pMappedData );
-    VERIFY( m_uiMapTarget == 0, "Buffer is already mapped");
+    VERIFY( m_uiMapTarget == 0 && !m_bMappedInDynamicHeap, "Buffer is already mapped");
+
+    if( m_bUseDynamicHeap && MapType == MAP_WRITE )
+    {
+        auto *pDynamicHeap = static_cast<RenderDeviceGLImpl*>( GetDevice() )->GetDynamicHeap();
+        // With MAP_FLAG_DO_NOT_SYNCHRONIZE, keep writing to the current allocation as long as it belongs
+        // to the current frame. Space allocated in an earlier frame may already have been released
+        // and handed out to another buffer, so a new allocation is made in this case.
+        if( (MapFlags & MAP_FLAG_DISCARD) != 0 || m_DynamicAllocation.GLBuffer == 0 ||
+            m_DynamicAllocation.FrameNumber != pDynamicHeap->GetCurrentFrameNumber() )
+        {
+            m_DynamicAllocation = pDynamicHeap->Allocate( m_Desc.uiSizeInBytes );
+        }
+
+        if( m_DynamicAllocation.GLBuffer != 0 )
+        {
+            // The heap is persistently and coherently mapped, so there is nothing to unmap or flush
+            pMappedData = m_DynamicAllocation.pCPUAddress;
+            m_bMappedInDynamicHeap = True;
+            return;
+        }
+        // The heap is exhausted by the current frame. Fall back to mapping the buffer itself.
+    }
 
     auto *pDeviceContextGL = ValidatedCast<DeviceContextGLImpl>(pContext);
     BufferMemoryBarrier(
@@ -322,6 +358,12 @@ void BufferGLImpl::Unmap( IDeviceContext *pContext, MAP_TYPE MapType, Uint32 Map
 {
     TBufferBase::Unmap(pContext, MapType, MapFlags);
 
+    if( m_bMappedInDynamicHeap )
+    {
+        m_bMappedInDynamicHeap = False;
+        return;
+    }
+
     glBindBuffer(m_uiMapTarget, m_GlBuffer);
     auto Result = glUnmapBuffer(m_uiMapTarget);
     // glUnmapBuffer() returns TRUE unless data values in the buffer�s data store have
@@ -54,7 +54,8 @@ namespace Diligent
         TDeviceContextBase(pRefCounters, pDeviceGL, bIsDeferred),
         m_ContextState(pDeviceGL),
         m_CommitedResourcesTentativeBarriers(0),
-        m_DefaultFBO(false)
+        m_DefaultFBO(false),
+        m_DefaultSampler(false)
     {
         m_BoundWritableTextures.reserve( 16 );
         m_BoundWritableBuffers.reserve( 16 );
@@ -174,6 +175,7 @@ namespace Diligent
         m_ContextState.Invalidate();
         m_BoundWritableTextures.clear();
         m_BoundWritableBuffers.clear();
+        m_BoundDynamicUniformBuffers.clear();
         m_bVAOIsUpToDate = false;
     }
 
@@ -318,8 +320,12 @@ namespace Diligent
 
             auto *pRenderDeviceGL = m_pDevice.RawPtr<RenderDeviceGLImpl>();
             auto CurrentNativeGLContext = m_ContextState.GetCurrentGLContext();
-            auto &FBOCache = pRenderDeviceGL->GetFBOCache(CurrentNativeGLContext);
-            const auto& FBO = FBOCache.GetFBO(NumRenderTargets, pBoundRTVs, m_pBoundDepthStencil, m_ContextState);
+            if( m_pFBOCache == nullptr || m_FBOCacheGLContext != CurrentNativeGLContext )
+            {
+                m_pFBOCache = &pRenderDeviceGL->GetFBOCache(CurrentNativeGLContext);
+                m_FBOCacheGLContext = CurrentNativeGLContext;
+            }
+            const auto& FBO = m_pFBOCache->GetFBO(NumRenderTargets, pBoundRTVs, m_pBoundDepthStencil, m_ContextState);
             // Even though the write mask only applies to writes to a framebuffer, the mask state is NOT 
             // Framebuffer state. So it is NOT part of a Framebuffer Object or the Default Framebuffer. 
             // Binding a new framebuffer will NOT affect the mask.
@@ -364,14 +370,28 @@ namespace Diligent
             m_ContextState.SetPipeline( Pipeline );
 
         size_t NumPrograms = ProgramPipelineSupported ? m_pPipelineState->GetNumShaders() : 1;
-        GLuint UniformBuffBindPoint = 0;
-        GLuint TextureIndex = 0;
+        // Uniform buffers, textures and samplers are gathered into flat tables indexed by 
+        // the binding points and texture units assigned by the pipeline state, and are
+        // then bound with as few GL calls as possible
+        auto NumUniformBindings = m_pPipelineState->GetNumUniformBindings();
+        auto NumTextureUnits = m_pPipelineState->GetNumTextureUnits();
+        m_BoundUniformBuffers.assign( NumUniformBindings, 0 );
+        m_BoundUniformBufferOffsets.assign( NumUniformBindings, 0 );
+        m_BoundUniformBufferSizes.assign( NumUniformBindings, 0 );
+        m_BoundTextureTargets.assign( NumTextureUnits, 0 );
+        m_pBoundTextures.assign( NumTextureUnits, nullptr );
+        m_pBoundSamplers.assign( NumTextureUnits, nullptr );
         m_BoundWritableTextures.clear();
         m_BoundWritableBuffers.clear();
+        m_BoundDynamicUniformBuffers.clear();
         for( size_t ProgNum = 0; ProgNum < NumPrograms; ++ProgNum )
         {
             auto *pShaderGL = static_cast<ShaderGLImpl*>(m_pPipelineState->GetShaders()[ProgNum]);
             auto &GLProgramObj = ProgramPipelineSupported ? pShaderGL->m_GlProgObj : Prog;
+            const auto &ResourceBindings = m_pPipelineState->GetProgramResourceBindings( static_cast<Uint32>(ProgNum) );
+            // This only issues GL calls when the program is used for the first time or was 
+            // last used by a pipeline state that assigned different bindings to it
+            GLProgramObj.ApplyResourceBindings( ResourceBindings.FirstStaticUniformBinding, ResourceBindings.FirstStaticTextureUnit, ProgramPipelineSupported );
 
             GLProgramResources *pDynamicResources = pShaderResBindingGL ? &pShaderResBindingGL->GetProgramResources(pShaderGL->GetDesc().ShaderType, m_pPipelineState) : nullptr;
 #ifdef VERIFY_RESOURCE_BINDINGS
@@ -386,11 +406,11 @@ namespace Diligent
                 ProgResources.dbgVerifyResourceBindings();
 #endif
                 
-                GLuint GLProgID = GLProgramObj;
+                Uint32 UniformBuffBindPoint = BindDynamicResources ? ResourceBindings.FirstDynamicUniformBinding : ResourceBindings.FirstStaticUniformBinding;
                 auto &UniformBlocks = ProgResources.GetUniformBlocks();
                 for( auto it = UniformBlocks.begin(); it != UniformBlocks.end(); ++it )
                 {
-                    for(Uint32 ArrInd = 0; ArrInd < it->pResources.size(); ++ArrInd)
+                    for(Uint32 ArrInd = 0; ArrInd < it->pResources.size(); ++ArrInd, ++UniformBuffBindPoint)
                     {
                         auto& Resource = it->pResources[ArrInd];
                         if (Resource)
@@ -401,14 +421,12 @@ namespace Diligent
                                                        // will reflect data written by shaders prior to the barrier
                                 m_ContextState);
 
-                            glBindBufferBase(GL_UNIFORM_BUFFER, UniformBuffBindPoint, pBufferOGL->m_GlBuffer);
-                            CHECK_GL_ERROR("Failed to bind uniform buffer");
-                            //glBindBufferRange(GL_UNIFORM_BUFFER, it->Index, pBufferOGL->m_GlBuffer, 0, pBufferOGL->GetDesc().uiSizeInBytes);
-
-                            glUniformBlockBinding(GLProgID, it->Index + ArrInd, UniformBuffBindPoint);
-                            CHECK_GL_ERROR("glUniformBlockBinding() failed");
-
-                            ++UniformBuffBindPoint;
+                            // Dynamic uniform buffers may live in the dynamic heap at an offset
+                            m_BoundUniformBuffers[UniformBuffBindPoint] = pBufferOGL->GetActiveGLBuffer();
+                            m_BoundUniformBufferOffsets[UniformBuffBindPoint] = static_cast<GLintptr>( pBufferOGL->GetActiveOffset() );
+                            m_BoundUniformBufferSizes[UniformBuffBindPoint] = static_cast<GLsizeiptr>( pBufferOGL->GetDesc().uiSizeInBytes );
+                            if( pBufferOGL->UsesDynamicHeap() )
+                                m_BoundDynamicUniformBuffers.emplace_back( UniformBuffBindPoint, pBufferOGL );
                         }
                         else
                         {
@@ -425,10 +443,11 @@ namespace Diligent
                     }
                 }
 
+                Uint32 TextureIndex = BindDynamicResources ? ResourceBindings.FirstDynamicTextureUnit : ResourceBindings.FirstStaticTextureUnit;
                 auto &Samplers = ProgResources.GetSamplers();
                 for( auto it = Samplers.begin(); it != Samplers.end(); ++it )
                 {
-                    for(Uint32 ArrInd = 0; ArrInd < it->pResources.size(); ++ArrInd)
+                    for(Uint32 ArrInd = 0; ArrInd < it->pResources.size(); ++ArrInd, ++TextureIndex)
                     {
                         auto &Resource = it->pResources[ArrInd];
                         if( Resource )
@@ -440,8 +459,9 @@ namespace Diligent
                                 auto *pBufViewOGL = Resource.RawPtr<BufferViewGLImpl>();
                                 auto *pBuffer = pBufViewOGL->GetBuffer();
 
-                                m_ContextState.BindTexture( TextureIndex, GL_TEXTURE_BUFFER, pBufViewOGL->GetTexBufferHandle() );
-                                m_ContextState.BindSampler( TextureIndex, GLObjectWrappers::GLSamplerObj(false) ); // Use default texture sampling parameters
+                                m_BoundTextureTargets[TextureIndex] = GL_TEXTURE_BUFFER;
+                                m_pBoundTextures[TextureIndex] = &pBufViewOGL->GetTexBufferHandle();
+                                m_pBoundSamplers[TextureIndex] = &m_DefaultSampler; // Use default texture sampling parameters
 
                                 CHECK_DYNAMIC_TYPE( BufferGLImpl, pBuffer );
                                 static_cast<BufferGLImpl*>(pBuffer)->BufferMemoryBarrier(
@@ -453,7 +473,8 @@ namespace Diligent
                             else
                             {
                                 auto *pTexViewOGL = Resource.RawPtr<TextureViewGLImpl>();
-                                m_ContextState.BindTexture( TextureIndex, pTexViewOGL->GetBindTarget(), pTexViewOGL->GetHandle() );
+                                m_BoundTextureTargets[TextureIndex] = pTexViewOGL->GetBindTarget();
+                                m_pBoundTextures[TextureIndex] = &pTexViewOGL->GetHandle();
 
                                 auto *pTexture = pTexViewOGL->GetTexture();
                                 CHECK_DYNAMIC_TYPE( TextureBaseGL, pTexture );
@@ -476,25 +497,9 @@ namespace Diligent
                             
                                 if( pSamplerGL )
                                 {
-                                    m_ContextState.BindSampler( TextureIndex, pSamplerGL->GetHandle() );
+                                    m_pBoundSamplers[TextureIndex] = &pSamplerGL->GetHandle();
                                 }
                             }
-
-                            // Texture is now bound to texture slot TextureIndex.
-                            // We now need to set the program uniform to use that slot
-                            if( ProgramPipelineSupported )
-                            {
-                                // glProgramUniform1i does not require program to be bound to the pipeline
-                                glProgramUniform1i( GLProgramObj, it->Location + ArrInd, TextureIndex );
-                            }
-                            else
-                            {
-                                // glUniform1i requires program to be bound to the pipeline
-                                glUniform1i( it->Location + ArrInd, TextureIndex );
-                            }
-                            CHECK_GL_ERROR( "Failed to bind sampler uniform to texture slot" );
-
-                            ++TextureIndex;
                         }
                         else
                         {
@@ -608,6 +613,10 @@ namespace Diligent
             }
         }
 
+        m_ContextState.BindUniformBuffers( 0, NumUniformBindings, m_BoundUniformBuffers.data(), m_BoundUniformBufferOffsets.data(), m_BoundUniformBufferSizes.data() );
+        m_ContextState.BindTextures( 0, NumTextureUnits, m_BoundTextureTargets.data(), m_pBoundTextures.data() );
+        m_ContextState.BindSamplers( 0, NumTextureUnits, m_pBoundSamplers.data() );
+
 #if GL_ARB_shader_image_load_store
         // Go through the list of textures bound as AUVs and set the required memory barriers
         for( auto pWritableTex = m_BoundWritableTextures.begin(); pWritableTex != m_BoundWritableTextures.end(); ++pWritableTex )
@@ -658,6 +667,52 @@ namespace Diligent
 #endif
     }
 
+    void DeviceContextGLImpl::BindVertexAndIndexBuffers( IBuffer *pIndexBuffer )
+    {
+        const GLObjectWrappers::GLBufferObj* pBuffers[MaxBufferSlots] = {};
+        GLintptr Offsets[MaxBufferSlots] = {};
+        GLsizei Strides[MaxBufferSlots] = {};
+
+        const auto *BufferStrides = m_pPipelineState->GetBufferStrides();
+        auto NumSlots = m_pPipelineState->GetNumBufferSlotsUsed();
+        for(Uint32 Slot = 0; Slot < NumSlots; ++Slot)
+        {
+            auto &Stream = m_VertexStreams[Slot];
+            if(Stream.pBuffer)
+            {
+                Stream.pBuffer->BufferMemoryBarrier( GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT, m_ContextState );
+                pBuffers[Slot] = &Stream.pBuffer->GetGLHandle();
+                Offsets[Slot] = Stream.Offset;
+            }
+            Strides[Slot] = BufferStrides[Slot];
+        }
+        m_ContextState.BindVertexBuffers( 0, NumSlots, pBuffers, Offsets, Strides );
+
+        if( pIndexBuffer != nullptr )
+        {
+            auto *pIndexBufferGL = ValidatedCast<BufferGLImpl>(pIndexBuffer);
+            pIndexBufferGL->BufferMemoryBarrier( GL_ELEMENT_ARRAY_BARRIER_BIT, m_ContextState );
+            m_ContextState.BindIndexBuffer( pIndexBufferGL->GetGLHandle() );
+        }
+    }
+
+    void DeviceContextGLImpl::RebindDynamicUniformBuffers()
+    {
+        for( const auto &DynamicUB : m_BoundDynamicUniformBuffers )
+        {
+            auto BindPoint = DynamicUB.first;
+            auto *pBufferOGL = DynamicUB.second;
+            auto GLBuffer = pBufferOGL->GetActiveGLBuffer();
+            auto Offset = static_cast<GLintptr>( pBufferOGL->GetActiveOffset() );
+            if( m_BoundUniformBuffers[BindPoint] != GLBuffer || m_BoundUniformBufferOffsets[BindPoint] != Offset )
+            {
+                m_BoundUniformBuffers[BindPoint] = GLBuffer;
+                m_BoundUniformBufferOffsets[BindPoint] = Offset;
+                m_ContextState.BindUniformBuffers( BindPoint, 1, &m_BoundUniformBuffers[BindPoint], &m_BoundUniformBufferOffsets[BindPoint], &m_BoundUniformBufferSizes[BindPoint] );
+            }
+        }
+    }
+
     void DeviceContextGLImpl::Draw( DrawAttribs &DrawAttribs )
     {
         if (!m_pPipelineState)
@@ -666,6 +721,8 @@ namespace Diligent
             return;
         }
 
+        RebindDynamicUniformBuffers();
+
         auto *pRenderDeviceGL = m_pDevice.RawPtr<RenderDeviceGLImpl>();
         auto CurrNativeGLContext = pRenderDeviceGL->m_GLContext.GetCurrentNativeGLContext();
         const auto& PipelineDesc = m_pPipelineState->GetDesc().GraphicsPipeline;
@@ -673,7 +730,21 @@ namespace Diligent
         {
             auto &VAOCache = pRenderDeviceGL->GetVAOCache(CurrNativeGLContext);
             IBuffer *pIndexBuffer = DrawAttribs.IsIndexed ? m_pIndexBuffer.RawPtr() : nullptr;
-            if(PipelineDesc.InputLayout.NumElements > 0 || pIndexBuffer != nullptr)
+            // With separate vertex format, the pipeline state owns a single VAO that only 
+            // describes the layout, and buffers are rebound directly without VAO cache lookup
+            const GLObjectWrappers::GLVertexArrayObj *pVertexFormatVAO = nullptr;
+            if(m_ContextState.GetContextCaps().bVertexAttribBindingSupported && 
+               (PipelineDesc.InputLayout.NumElements > 0 || pIndexBuffer != nullptr))
+            {
+                pVertexFormatVAO = m_pPipelineState->GetVertexFormatVAO(CurrNativeGLContext, m_ContextState);
+            }
+
+            if(pVertexFormatVAO != nullptr)
+            {
+                m_ContextState.BindVAO( *pVertexFormatVAO );
+                BindVertexAndIndexBuffers( pIndexBuffer );
+            }
+            else if(PipelineDesc.InputLayout.NumElements > 0 || pIndexBuffer != nullptr)
             {
                 const auto& VAO = VAOCache.GetVAO( m_pPipelineState, pIndexBuffer, m_VertexStreams, m_NumVertexStreams, m_ContextState );
                 m_ContextState.BindVAO( VAO );
@@ -830,6 +901,8 @@ namespace Diligent
     void DeviceContextGLImpl::DispatchCompute( const DispatchComputeAttribs &DispatchAttrs )
     {
 #if GL_ARB_compute_shader
+        RebindDynamicUniformBuffers();
+
         if( DispatchAttrs.pIndirectDispatchAttribs )
         {
             CHECK_DYNAMIC_TYPE( BufferGLImpl, DispatchAttrs.pIndirectDispatchAttribs );
@@ -79,7 +79,8 @@ std::size_t FBOCache::FBOCacheKeyHashFunc::operator() ( const FBOCacheKey& Key )
 }
 
 
-FBOCache::FBOCache()
+FBOCache::FBOCache(Uint32 MaxSize) :
+    m_MaxSize(MaxSize)
 {
     m_Cache.max_load_factor(0.5f);
     m_TexIdToKey.max_load_factor(0.5f);
@@ -91,17 +92,57 @@ FBOCache::~FBOCache()
     VERIFY( m_TexIdToKey.empty(), "TexIdToKey cache is not empty.");
 }
 
+void FBOCache::EraseEntry(CacheMapType::iterator It)
+{
+    const auto &Key = It->first;
+    // Remove all references to the FBO from the texture id map
+    auto RemoveTexIdRef = [&](Diligent::UniqueIdentifier TexId)
+    {
+        auto EqualRange = m_TexIdToKey.equal_range(TexId);
+        for(auto TexIt = EqualRange.first; TexIt != EqualRange.second; )
+        {
+            if( TexIt->second == Key )
+                TexIt = m_TexIdToKey.erase(TexIt);
+            else
+                ++TexIt;
+        }
+    };
+    if( Key.DSId )
+        RemoveTexIdRef(Key.DSId);
+    for( Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt )
+    {
+        if( Key.RTIds[rt] )
+            RemoveTexIdRef(Key.RTIds[rt]);
+    }
+
+    m_LRUList.erase(It->second.LRUIt);
+    m_Cache.erase(It);
+}
+
 void FBOCache::OnReleaseTexture(ITexture *pTexture)
 {
     ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
     auto *pTexGL = ValidatedCast<TextureBaseGL>( pTexture );
-    // Find all FBOs that this texture used in
+    // Find all FBOs that this texture used in. The keys must be copied 
+    // because EraseEntry() removes them from the texture id map
     auto EqualRange = m_TexIdToKey.equal_range(pTexGL->GetUniqueID());
+    std::vector<FBOCacheKey> Keys;
     for(auto It = EqualRange.first; It != EqualRange.second; ++It)
+        Keys.push_back(It->second);
+
+    for(const auto &Key : Keys)
     {
-        m_Cache.erase(It->second);
+        auto CacheIt = m_Cache.find(Key);
+        if( CacheIt != m_Cache.end() )
+            EraseEntry(CacheIt);
     }
-    m_TexIdToKey.erase(EqualRange.first, EqualRange.second);
+    VERIFY( m_TexIdToKey.find(pTexGL->GetUniqueID()) == m_TexIdToKey.end(), "All references to the texture must have been removed" );
+}
+
+FBOCache::Statistics FBOCache::GetStatistics()
+{
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    return m_Stats;
 }
 
 const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTargets, 
@@ -157,10 +198,26 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTarg
     auto It = m_Cache.find(Key);
     if( It != m_Cache.end() )
     {
-        return It->second;
+        ++m_Stats.NumHits;
+        // Move the key to the front of the LRU list
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUIt);
+        return It->second.FBO;
     }
     else
     {
+        ++m_Stats.NumMisses;
+
+        // Evict least recently used FBOs. This happens before the new FBO is created, so 
+        // the reference returned by this function stays valid until the next call.
+        // Evicted FBOs are released in the context that owns the cache.
+        while( m_MaxSize != 0 && m_Cache.size() >= m_MaxSize )
+        {
+            auto LRUIt = m_Cache.find(m_LRUList.back());
+            VERIFY_EXPR(LRUIt != m_Cache.end());
+            EraseEntry(LRUIt);
+            ++m_Stats.NumEvictions;
+        }
+
         // Create new FBO
         GLObjectWrappers::GLFrameBufferObj NewFBO(true);
 
@@ -258,7 +315,8 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTarg
             UNEXPECTED( "Framebuffer is incomplete" );
         }
 
-        auto NewElems = m_Cache.emplace( std::make_pair(Key, std::move(NewFBO)) );
+        m_LRUList.push_front(Key);
+        auto NewElems = m_Cache.emplace( std::make_pair(Key, FBOCacheEntry(std::move(NewFBO), m_LRUList.begin())) );
         // New element must be actually inserted
         VERIFY( NewElems.second, "New element was not inserted" ); 
         if( Key.DSId  )
@@ -269,7 +327,7 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO( Uint32 NumRenderTarg
                 m_TexIdToKey.insert( std::make_pair(Key.RTIds[rt], Key) );
         }
 
-        return NewElems.first->second;
+        return NewElems.first->second.FBO;
     }
 }
 
@@ -40,6 +40,11 @@ namespace Diligent
     {
         const DeviceCaps &DeviceCaps = pDeviceGL->GetDeviceCaps();
         m_Caps.bFillModeSelectionSupported = DeviceCaps.bWireframeFillSupported;
+#if GL_ARB_multi_bind
+        m_Caps.bMultiBindSupported = DeviceCaps.DevType == DeviceType::OpenGL && 
+                                     (DeviceCaps.MajorVersion > 4 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 4) ||
+                                      pDeviceGL->CheckExtension( "GL_ARB_multi_bind" ));
+#endif
 
         {
             m_Caps.m_iMaxCombinedTexUnits = 0;
@@ -53,6 +58,17 @@ namespace Diligent
             VERIFY_EXPR(m_Caps.m_iMaxDrawBuffers > 0);
         }
 
+#if GL_ARB_vertex_attrib_binding
+        if( DeviceCaps.DevType == DeviceType::OpenGL && 
+            (DeviceCaps.MajorVersion > 4 || (DeviceCaps.MajorVersion == 4 && DeviceCaps.MinorVersion >= 3) ||
+             pDeviceGL->CheckExtension( "GL_ARB_vertex_attrib_binding" )) )
+        {
+            m_Caps.bVertexAttribBindingSupported = true;
+            glGetIntegerv( GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET, &m_Caps.m_iMaxVertexAttribRelativeOffset );
+            CHECK_GL_ERROR( "Failed to get max vertex attrib relative offset" );
+        }
+#endif
+
         m_BoundTextures.reserve( m_Caps.m_iMaxCombinedTexUnits );
         m_BoundSamplers.reserve( 32 );
         m_BoundImages.reserve( 32 );
@@ -86,6 +102,8 @@ namespace Diligent
         m_GLPipelineId = -1;
         m_VAOId = -1;
         m_FBOId = -1;
+        m_BoundVertexBuffers.clear();
+        m_IndexBufferId = -1;
         
         m_BoundTextures.clear();
         m_BoundSamplers.clear();
@@ -154,6 +172,9 @@ namespace Diligent
             VERIFY( VAOHandle, "VAO Handle is zero" );
             glBindVertexArray( VAOHandle );
             CHECK_GL_ERROR( "Failed to set VAO" );
+            // Buffer bindings are stored in the VAO
+            m_BoundVertexBuffers.clear();
+            m_IndexBufferId = -1;
         }
     }
 
@@ -230,6 +251,158 @@ namespace Diligent
         }
     }
 
+    void GLContextState::BindTextures( Uint32 FirstUnit, Uint32 NumUnits, const GLenum *BindTargets, const GLObjectWrappers::GLTextureObj* const* ppTextures )
+    {
+        VERIFY( static_cast<Int32>(FirstUnit + NumUnits) <= m_Caps.m_iMaxCombinedTexUnits, "Texture unit is out of range" );
+#if GL_ARB_multi_bind
+        if( m_Caps.bMultiBindSupported )
+        {
+            m_MultiBindHandles.resize( NumUnits );
+            Uint32 RunStart = 0, RunEnd = 0;
+            for( Uint32 i = 0; i <= NumUnits; ++i )
+            {
+                bool bDirty = false;
+                if( i < NumUnits && ppTextures[i] != nullptr )
+                    bDirty = UpdateBoundObjectsArr( m_BoundTextures, FirstUnit + i, *ppTextures[i], m_MultiBindHandles[i] );
+
+                if( bDirty )
+                {
+                    if( RunStart == RunEnd )
+                        RunStart = i;
+                    RunEnd = i + 1;
+                }
+                else if( RunEnd > RunStart )
+                {
+                    // glBindTextures() binds every texture to the target it was created with
+                    glBindTextures( FirstUnit + RunStart, RunEnd - RunStart, m_MultiBindHandles.data() + RunStart );
+                    CHECK_GL_ERROR( "Failed to bind textures to slots ", FirstUnit + RunStart, "..", FirstUnit + RunEnd - 1 );
+                    RunStart = RunEnd = 0;
+                }
+            }
+            return;
+        }
+#endif
+
+        for( Uint32 i = 0; i < NumUnits; ++i )
+        {
+            if( ppTextures[i] != nullptr )
+                BindTexture( FirstUnit + i, BindTargets[i], *ppTextures[i] );
+        }
+    }
+
+    void GLContextState::BindSamplers( Uint32 FirstUnit, Uint32 NumUnits, const GLObjectWrappers::GLSamplerObj* const* ppSamplers )
+    {
+#if GL_ARB_multi_bind
+        if( m_Caps.bMultiBindSupported )
+        {
+            m_MultiBindHandles.resize( NumUnits );
+            Uint32 RunStart = 0, RunEnd = 0;
+            for( Uint32 i = 0; i <= NumUnits; ++i )
+            {
+                bool bDirty = false;
+                if( i < NumUnits && ppSamplers[i] != nullptr )
+                    bDirty = UpdateBoundObjectsArr( m_BoundSamplers, FirstUnit + i, *ppSamplers[i], m_MultiBindHandles[i] );
+
+                if( bDirty )
+                {
+                    if( RunStart == RunEnd )
+                        RunStart = i;
+                    RunEnd = i + 1;
+                }
+                else if( RunEnd > RunStart )
+                {
+                    glBindSamplers( FirstUnit + RunStart, RunEnd - RunStart, m_MultiBindHandles.data() + RunStart );
+                    CHECK_GL_ERROR( "Failed to bind samplers to slots ", FirstUnit + RunStart, "..", FirstUnit + RunEnd - 1 );
+                    RunStart = RunEnd = 0;
+                }
+            }
+            return;
+        }
+#endif
+
+        for( Uint32 i = 0; i < NumUnits; ++i )
+        {
+            if( ppSamplers[i] != nullptr )
+                BindSampler( FirstUnit + i, *ppSamplers[i] );
+        }
+    }
+
+    void GLContextState::BindVertexBuffers( Uint32 FirstSlot, Uint32 NumSlots, const GLObjectWrappers::GLBufferObj* const* ppBuffers, const GLintptr *pOffsets, const GLsizei *pStrides )
+    {
+#if GL_ARB_vertex_attrib_binding
+        if( FirstSlot + NumSlots > m_BoundVertexBuffers.size() )
+            m_BoundVertexBuffers.resize( FirstSlot + NumSlots );
+
+        m_MultiBindHandles.resize( NumSlots );
+        Uint32 FirstDirty = NumSlots, LastDirty = 0;
+        for( Uint32 i = 0; i < NumSlots; ++i )
+        {
+            auto &BoundVB = m_BoundVertexBuffers[FirstSlot + i];
+            bool bBufferChanged = ppBuffers[i] != nullptr ? 
+                UpdateBoundObject( BoundVB.BufferID, *ppBuffers[i], m_MultiBindHandles[i] ) :
+                UpdateBoundObject( BoundVB.BufferID, GLBufferObj(false), m_MultiBindHandles[i] );
+            if( bBufferChanged || BoundVB.Offset != pOffsets[i] || BoundVB.Stride != pStrides[i] )
+            {
+                BoundVB.Offset = pOffsets[i];
+                BoundVB.Stride = pStrides[i];
+                FirstDirty = std::min( FirstDirty, i );
+                LastDirty = i;
+            }
+        }
+        if( FirstDirty > LastDirty )
+            return;
+
+#   if GL_ARB_multi_bind
+        if( m_Caps.bMultiBindSupported )
+        {
+            // Slots between the first and the last changed one are rebound with the same values
+            glBindVertexBuffers( FirstSlot + FirstDirty, LastDirty - FirstDirty + 1, m_MultiBindHandles.data() + FirstDirty, pOffsets + FirstDirty, pStrides + FirstDirty );
+            CHECK_GL_ERROR( "Failed to bind vertex buffers" );
+            return;
+        }
+#   endif
+
+        for( Uint32 i = FirstDirty; i <= LastDirty; ++i )
+        {
+            glBindVertexBuffer( FirstSlot + i, m_MultiBindHandles[i], pOffsets[i], pStrides[i] );
+            CHECK_GL_ERROR( "Failed to bind vertex buffer to slot ", FirstSlot + i );
+        }
+#else
+        UNSUPPORTED( "GL_ARB_vertex_attrib_binding is not supported" );
+#endif
+    }
+
+    void GLContextState::BindIndexBuffer( const GLObjectWrappers::GLBufferObj &Buffer )
+    {
+        GLuint BufferHandle = 0;
+        if( UpdateBoundObject( m_IndexBufferId, Buffer, BufferHandle ) )
+        {
+            glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, BufferHandle );
+            CHECK_GL_ERROR( "Failed to bind index buffer" );
+        }
+    }
+
+    void GLContextState::BindUniformBuffers( Uint32 FirstBinding, Uint32 NumBindings, const GLuint *pBuffers, const GLintptr *pOffsets, const GLsizeiptr *pSizes )
+    {
+        if( NumBindings == 0 )
+            return;
+
+#if GL_ARB_multi_bind
+        if( m_Caps.bMultiBindSupported )
+        {
+            glBindBuffersRange( GL_UNIFORM_BUFFER, FirstBinding, NumBindings, pBuffers, pOffsets, pSizes );
+            CHECK_GL_ERROR( "Failed to bind uniform buffers" );
+            return;
+        }
+#endif
+
+        for( Uint32 i = 0; i < NumBindings; ++i )
+        {
+            glBindBufferRange( GL_UNIFORM_BUFFER, FirstBinding + i, pBuffers[i], pOffsets[i], pSizes[i] );
+            CHECK_GL_ERROR( "Failed to bind uniform buffer" );
+        }
+    }
+
     void GLContextState::BindImage( Uint32 Index,
         TextureViewGLImpl *pTexView,
         GLint MipLevel,
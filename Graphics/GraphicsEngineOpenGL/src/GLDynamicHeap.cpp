@@ -0,0 +1,163 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "GLDynamicHeap.h"
+
+namespace Diligent
+{
+
+static Uint32 GetUniformBufferOffsetAlignment()
+{
+    GLint Alignment = 0;
+    glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment );
+    CHECK_GL_ERROR( "Failed to get uniform buffer offset alignment" );
+    return Alignment > 0 ? static_cast<Uint32>(Alignment) : 256;
+}
+
+static size_t AlignSize(size_t Size, Uint32 Alignment)
+{
+    // GL does not require the alignment to be a power of two
+    return (Size + Alignment - 1) / Alignment * Alignment;
+}
+
+GLDynamicHeap::GLDynamicHeap(IMemoryAllocator &Allocator, Uint32 Size) :
+    m_Alignment(GetUniformBufferOffsetAlignment()),
+    m_RingBuffer(AlignSize(Size, m_Alignment), Allocator),
+    m_GlBuffer(true)
+{
+#if GL_ARB_buffer_storage
+    auto HeapSize = static_cast<GLsizeiptr>(m_RingBuffer.GetMaxSize());
+    const GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBindBuffer( GL_COPY_WRITE_BUFFER, m_GlBuffer );
+    glBufferStorage( GL_COPY_WRITE_BUFFER, HeapSize, nullptr, StorageFlags );
+    CHECK_GL_ERROR_AND_THROW( "glBufferStorage() failed" );
+    // Coherent mapping makes CPU writes visible to the GPU without explicit flushes or 
+    // GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT barriers
+    m_pCPUAddress = reinterpret_cast<Uint8*>( glMapBufferRange( GL_COPY_WRITE_BUFFER, 0, HeapSize, StorageFlags ) );
+    CHECK_GL_ERROR_AND_THROW( "glMapBufferRange() failed" );
+    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+    if( m_pCPUAddress == nullptr )
+        LOG_ERROR_AND_THROW( "Failed to persistently map dynamic heap buffer" );
+
+    LOG_INFO_MESSAGE( "GL dynamic heap created: ", HeapSize, " bytes, ", m_Alignment, "-byte alignment" );
+#else
+    LOG_ERROR_AND_THROW( "GL_ARB_buffer_storage is not supported" );
+#endif
+}
+
+GLDynamicHeap::~GLDynamicHeap()
+{
+    // The driver defers deletion of the buffer until the GPU is done with it,
+    // so there is no need to wait for outstanding frames
+    m_RingBuffer.FinishCurrentFrame(m_CurrentFrameNumber);
+    m_RingBuffer.ReleaseCompletedFrames(m_CurrentFrameNumber);
+}
+
+GLDynamicAllocation GLDynamicHeap::Allocate(Uint32 SizeInBytes)
+{
+    GLDynamicAllocation Allocation;
+    auto AlignedSize = AlignSize(SizeInBytes, m_Alignment);
+    if( AlignedSize > m_RingBuffer.GetMaxSize() )
+        return Allocation;
+
+    auto Offset = m_RingBuffer.Allocate(AlignedSize);
+    // Space allocated in the current frame may still be referenced by commands that
+    // have not been issued yet, so only wait for frames that have already been finished
+    while( Offset == RingBuffer::InvalidOffset && ReleaseCompletedFrames(true) )
+    {
+        Offset = m_RingBuffer.Allocate(AlignedSize);
+    }
+
+    if( Offset == RingBuffer::InvalidOffset )
+        return Allocation;
+
+    m_bCurrentFrameHasAllocations = true;
+    Allocation.GLBuffer    = m_GlBuffer;
+    Allocation.Offset      = Offset;
+    Allocation.Size        = AlignedSize;
+    Allocation.pCPUAddress = m_pCPUAddress + Offset;
+    Allocation.FrameNumber = m_CurrentFrameNumber;
+    return Allocation;
+}
+
+void GLDynamicHeap::FinishFrame()
+{
+    if( m_bCurrentFrameHasAllocations )
+    {
+        GLObjectWrappers::GLSyncObj FrameFence( glFenceSync(
+                GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+                0 // Flags, must be 0
+            )
+        );
+        CHECK_GL_ERROR( "Failed to create gl fence" );
+        m_RingBuffer.FinishCurrentFrame(m_CurrentFrameNumber);
+        m_FrameFences.emplace_back(m_CurrentFrameNumber, std::move(FrameFence));
+        ++m_CurrentFrameNumber;
+        m_bCurrentFrameHasAllocations = false;
+    }
+
+    ReleaseCompletedFrames(false);
+}
+
+bool GLDynamicHeap::ReleaseCompletedFrames(bool WaitForOldestFrame)
+{
+    Uint64 CompletedFrameNumber = 0;
+    while( !m_FrameFences.empty() )
+    {
+        auto &FrameFence = m_FrameFences.front();
+        GLbitfield WaitFlags = 0;
+        GLuint64 Timeout = 0;
+        if( WaitForOldestFrame && CompletedFrameNumber == 0 )
+        {
+            // Flush the command stream to guarantee that the fence is eventually signaled
+            WaitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+            Timeout = 1000000000; // 1 second, in nanoseconds
+        }
+
+        GLenum Res = GL_TIMEOUT_EXPIRED;
+        do
+        {
+            Res = glClientWaitSync( FrameFence.second, WaitFlags, Timeout );
+        }while( Res == GL_TIMEOUT_EXPIRED && Timeout != 0 );
+
+        if( Res == GL_WAIT_FAILED )
+        {
+            LOG_ERROR_MESSAGE( "Failed to wait for dynamic heap frame fence" );
+            break;
+        }
+        if( Res != GL_ALREADY_SIGNALED && Res != GL_CONDITION_SATISFIED )
+            break;
+
+        CompletedFrameNumber = FrameFence.first;
+        m_FrameFences.pop_front();
+    }
+
+    if( CompletedFrameNumber == 0 )
+        return false;
+
+    m_RingBuffer.ReleaseCompletedFrames(CompletedFrameNumber);
+    return true;
+}
+
+}
@@ -35,7 +35,9 @@ namespace Diligent
     GLProgram::GLProgram( GLProgram&& Program ):
         GLObjectWrappers::GLProgramObj( std::move( Program ) ),
         m_AllResources( std::move( Program.m_AllResources) ),
-        m_ConstantResources( std::move( Program.m_ConstantResources) )
+        m_ConstantResources( std::move( Program.m_ConstantResources) ),
+        m_FirstUniformBinding( Program.m_FirstUniformBinding ),
+        m_FirstTextureUnit( Program.m_FirstTextureUnit )
     {}
 
     void GLProgram::InitResources(RenderDeviceGLImpl* pDeviceGLImpl, 
@@ -53,6 +55,79 @@ namespace Diligent
         m_ConstantResources.Clone(m_AllResources, VarTypes, _countof(VarTypes), Owner);
     }
 
+    void GLProgram::CountResourceBindings(Uint32 &NumStaticUniformBindings, 
+                                          Uint32 &NumDynamicUniformBindings,
+                                          Uint32 &NumStaticTextureUnits,
+                                          Uint32 &NumDynamicTextureUnits)const
+    {
+        NumStaticUniformBindings = NumDynamicUniformBindings = 0;
+        NumStaticTextureUnits = NumDynamicTextureUnits = 0;
+
+        auto &UniformBlocks = m_AllResources.GetUniformBlocks();
+        for( auto ub = UniformBlocks.begin(); ub != UniformBlocks.end(); ++ub )
+        {
+            auto &Count = ub->VarType == SHADER_VARIABLE_TYPE_STATIC ? NumStaticUniformBindings : NumDynamicUniformBindings;
+            Count += static_cast<Uint32>(ub->pResources.size());
+        }
+
+        auto &Samplers = m_AllResources.GetSamplers();
+        for( auto sam = Samplers.begin(); sam != Samplers.end(); ++sam )
+        {
+            auto &Count = sam->VarType == SHADER_VARIABLE_TYPE_STATIC ? NumStaticTextureUnits : NumDynamicTextureUnits;
+            Count += static_cast<Uint32>(sam->pResources.size());
+        }
+    }
+
+    void GLProgram::ApplyResourceBindings(Uint32 FirstUniformBinding, Uint32 FirstTextureUnit, bool UseProgramUniform)
+    {
+        if( m_FirstUniformBinding == FirstUniformBinding && m_FirstTextureUnit == FirstTextureUnit )
+            return;
+
+        GLuint GLProg = static_cast<GLuint>(*this);
+        auto &UniformBlocks = m_AllResources.GetUniformBlocks();
+        auto &Samplers = m_AllResources.GetSamplers();
+        Uint32 UniformBinding = FirstUniformBinding;
+        Uint32 TextureUnit = FirstTextureUnit;
+        // Static resources are assigned first, which matches the order in which
+        // DeviceContextGLImpl::BindProgramResources() visits constant and dynamic resources
+        for( int Dynamic = 0; Dynamic < 2; ++Dynamic )
+        {
+            for( auto ub = UniformBlocks.begin(); ub != UniformBlocks.end(); ++ub )
+            {
+                if( (ub->VarType != SHADER_VARIABLE_TYPE_STATIC) != (Dynamic != 0) )
+                    continue;
+                for( Uint32 ArrInd = 0; ArrInd < ub->pResources.size(); ++ArrInd )
+                {
+                    glUniformBlockBinding( GLProg, ub->Index + ArrInd, UniformBinding++ );
+                    CHECK_GL_ERROR( "glUniformBlockBinding() failed" );
+                }
+            }
+
+            for( auto sam = Samplers.begin(); sam != Samplers.end(); ++sam )
+            {
+                if( (sam->VarType != SHADER_VARIABLE_TYPE_STATIC) != (Dynamic != 0) )
+                    continue;
+                for( Uint32 ArrInd = 0; ArrInd < sam->pResources.size(); ++ArrInd )
+                {
+                    if( UseProgramUniform )
+                    {
+                        // glProgramUniform1i does not require program to be bound to the pipeline
+                        glProgramUniform1i( GLProg, sam->Location + ArrInd, TextureUnit++ );
+                    }
+                    else
+                    {
+                        // glUniform1i requires program to be bound to the pipeline
+                        glUniform1i( sam->Location + ArrInd, TextureUnit++ );
+                    }
+                    CHECK_GL_ERROR( "Failed to bind sampler uniform to texture slot" );
+                }
+            }
+        }
+
+        m_FirstUniformBinding = FirstUniformBinding;
+        m_FirstTextureUnit = FirstTextureUnit;
+    }
+
     void GLProgram::BindConstantResources( IResourceMapping *pResourceMapping, Uint32 Flags )
     {
         if( !pResourceMapping )
@@ -0,0 +1,309 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include "GLProgramBinaryCache.h"
+#include "HashUtils.h"
+#include "DataBlobImpl.h"
+#include "FileWrapper.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Every program binary, whether it is stored in a file or in serialized cache data, starts with this header
+struct ProgramBinaryHeader
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint64 DriverHash;
+    Uint64 ProgramKey;
+    Uint32 Format;
+    Uint32 Size;
+};
+
+static constexpr Uint32 ProgramBinaryMagic   = 0x42504744; // "DGPB"
+static constexpr Uint32 ProgramBinaryVersion = 1;
+
+std::string GetGLString(GLenum Name)
+{
+    auto *Str = glGetString(Name);
+    return Str != nullptr ? reinterpret_cast<const char*>(Str) : "";
+}
+
+}
+
+GLProgramBinaryCache::GLProgramBinaryCache(const EngineGLAttribs& InitAttribs)
+{
+    if (!InitAttribs.EnableProgramBinaryCache)
+        return;
+
+    GLint NumFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+    if (glGetError() != GL_NO_ERROR || NumFormats <= 0)
+    {
+        LOG_WARNING_MESSAGE("The driver does not support program binaries. Program binary cache is disabled.");
+        return;
+    }
+    m_IsEnabled = true;
+
+    // Binaries produced by one driver are not valid for another one, or even for another version of the same driver
+    auto DriverString = GetGLString(GL_VENDOR) + '\n' + GetGLString(GL_RENDERER) + '\n' + GetGLString(GL_VERSION);
+    m_DriverHash = ComputeHash64(DriverString.data(), DriverString.length());
+
+    if (InitAttribs.ProgramBinaryCacheDir != nullptr && *InitAttribs.ProgramBinaryCacheDir != 0)
+    {
+        m_CacheDir = InitAttribs.ProgramBinaryCacheDir;
+        if (m_CacheDir.back() != '/' && m_CacheDir.back() != '\\')
+            m_CacheDir.push_back(FileSystem::GetSlashSymbol());
+    }
+
+    if (InitAttribs.pProgramBinaryCacheData != nullptr)
+    {
+        ParsePrograms(static_cast<const Uint8*>(InitAttribs.pProgramBinaryCacheData), InitAttribs.ProgramBinaryCacheDataSize, "program binary cache data", m_Programs);
+    }
+}
+
+Uint64 GLProgramBinaryCache::ComputeProgramKey(bool IsSeparable, Uint32 NumSources, const std::string* const* ppSources)const
+{
+    // The key does not depend on the driver, so that the program file is overwritten rather than
+    // orphaned when the driver is updated. The driver hash stored with the binary decides if it is stale.
+    Uint64 Key = IsSeparable ? 1 : 0;
+    for (Uint32 s = 0; s < NumSources; ++s)
+        Key = ComputeHash64(ppSources[s]->data(), ppSources[s]->length(), Key);
+    return Key;
+}
+
+std::string GLProgramBinaryCache::GetProgramFilePath(Uint64 ProgramKey)const
+{
+    std::stringstream PathSS;
+    PathSS << m_CacheDir << std::hex << std::setw(16) << std::setfill('0') << ProgramKey << ".glbin";
+    return PathSS.str();
+}
+
+void GLProgramBinaryCache::ParsePrograms(const Uint8* pData, size_t Size, const Char* SourceName, ProgramBinaryMap& Programs)const
+{
+    Uint32 NumStalePrograms = 0;
+    size_t Offset = 0;
+    while (Offset < Size)
+    {
+        ProgramBinaryHeader Header;
+        if (Offset + sizeof(Header) > Size)
+        {
+            LOG_WARNING_MESSAGE("Unexpected end of ", SourceName);
+            break;
+        }
+        memcpy(&Header, pData + Offset, sizeof(Header));
+        Offset += sizeof(Header);
+        if (Header.Magic != ProgramBinaryMagic || Header.Version != ProgramBinaryVersion || Offset + Header.Size > Size)
+        {
+            LOG_WARNING_MESSAGE("Invalid program binary found in ", SourceName);
+            break;
+        }
+
+        if (Header.DriverHash == m_DriverHash)
+        {
+            auto &Binary = Programs[Header.ProgramKey];
+            Binary.Format = Header.Format;
+            Binary.Data.assign(pData + Offset, pData + Offset + Header.Size);
+        }
+        else
+            ++NumStalePrograms;
+        Offset += Header.Size;
+    }
+
+    if (NumStalePrograms != 0)
+        LOG_INFO_MESSAGE(NumStalePrograms, " program binaries in ", SourceName, " were produced by a different driver and will be rebuilt");
+}
+
+bool GLProgramBinaryCache::LoadProgram(Uint64 ProgramKey, GLuint Program)
+{
+    if (!m_IsEnabled)
+        return false;
+
+    // The binary is copied out so that neither the file IO nor the driver call below is performed under the lock
+    ProgramBinary Binary;
+    bool Found = false;
+    {
+        ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+        auto It = m_Programs.find(ProgramKey);
+        if (It != m_Programs.end())
+        {
+            Binary = It->second;
+            Found = true;
+        }
+    }
+
+    if (!Found)
+    {
+        ProgramBinaryMap FilePrograms;
+        if (!ReadProgramFile(ProgramKey, FilePrograms))
+            return false;
+
+        auto It = FilePrograms.find(ProgramKey);
+        if (It == FilePrograms.end())
+            return false;
+        Binary = It->second;
+
+        ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+        for (auto &FileProgram : FilePrograms)
+            m_Programs.emplace(FileProgram.first, std::move(FileProgram.second));
+    }
+
+    // Errors left by previous GL calls must not be attributed to the binary, so the result is 
+    // decided by the link status alone. A rejected binary always leaves the program unlinked.
+    glProgramBinary(Program, Binary.Format, Binary.Data.data(), static_cast<GLsizei>(Binary.Data.size()));
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(Program, GL_LINK_STATUS, &IsLinked);
+    if (!IsLinked)
+    {
+        // The driver may reject the binary even if the driver strings match, e.g. when its settings have changed.
+        // The program will be linked from the source and the binary will be replaced.
+        LOG_INFO_MESSAGE("Cached program binary was rejected by the driver");
+        ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+        m_Programs.erase(ProgramKey);
+        return false;
+    }
+
+    return true;
+}
+
+bool GLProgramBinaryCache::ReadProgramFile(Uint64 ProgramKey, ProgramBinaryMap& Programs)const
+{
+    if (m_CacheDir.empty())
+        return false;
+
+    auto FilePath = GetProgramFilePath(ProgramKey);
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return false;
+
+    bool IsRead = false;
+    try
+    {
+        FileWrapper File(FilePath.c_str(), EFileAccessMode::Read);
+        if (File)
+        {
+            std::vector<Uint8> FileData(File->GetSize());
+            if (File->Read(FileData.data(), FileData.size()))
+            {
+                ParsePrograms(FileData.data(), FileData.size(), FilePath.c_str(), Programs);
+                IsRead = true;
+            }
+        }
+    }
+    catch(const std::runtime_error&)
+    {
+    }
+
+    if (IsRead)
+    {
+        if (Programs.find(ProgramKey) == Programs.end())
+        {
+            // The binary was produced by a different driver or the file is corrupted
+            std::remove(FilePath.c_str());
+            return false;
+        }
+        return true;
+    }
+    LOG_WARNING_MESSAGE("Failed to read program binary from file ", FilePath);
+    return false;
+}
+
+void GLProgramBinaryCache::PrepareForLinking(GLuint Program)const
+{
+    if (m_IsEnabled)
+        glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void GLProgramBinaryCache::StoreProgram(Uint64 ProgramKey, GLuint Program)
+{
+    if (!m_IsEnabled)
+        return;
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(Program, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (BinaryLength <= 0)
+        return;
+
+    ProgramBinary Binary;
+    Binary.Data.resize(BinaryLength);
+    GLsizei Length = 0;
+    glGetProgramBinary(Program, BinaryLength, &Length, &Binary.Format, Binary.Data.data());
+    // Length is only written on success, so it is checked instead of glGetError() that may report stale errors
+    if (Length <= 0 || Length > BinaryLength)
+    {
+        LOG_WARNING_MESSAGE("Failed to retrieve program binary");
+        return;
+    }
+    Binary.Data.resize(Length);
+
+    if (!m_CacheDir.empty())
+    {
+        ProgramBinaryHeader Header = {ProgramBinaryMagic, ProgramBinaryVersion, m_DriverHash, ProgramKey, Binary.Format, static_cast<Uint32>(Binary.Data.size())};
+        auto FilePath = GetProgramFilePath(ProgramKey);
+        try
+        {
+            FileWrapper File(FilePath.c_str(), EFileAccessMode::Overwrite);
+            if (!File || !File->Write(&Header, sizeof(Header)) || !File->Write(Binary.Data.data(), Binary.Data.size()))
+                LOG_WARNING_MESSAGE("Failed to write program binary to file ", FilePath);
+        }
+        catch(const std::runtime_error&)
+        {
+            LOG_WARNING_MESSAGE("Failed to create program binary file ", FilePath);
+        }
+    }
+
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    m_Programs[ProgramKey] = std::move(Binary);
+}
+
+void GLProgramBinaryCache::Serialize(IDataBlob** ppCacheData)
+{
+    VERIFY(ppCacheData != nullptr && *ppCacheData == nullptr, "Null pointer or overwriting existing data blob");
+
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+    size_t TotalSize = 0;
+    for (const auto &Program : m_Programs)
+        TotalSize += sizeof(ProgramBinaryHeader) + Program.second.Data.size();
+
+    auto *pCacheData = MakeNewRCObj<DataBlobImpl>()(TotalSize);
+    auto *pDst = reinterpret_cast<Uint8*>(pCacheData->GetDataPtr());
+    for (const auto &Program : m_Programs)
+    {
+        const auto &Binary = Program.second;
+        ProgramBinaryHeader Header = {ProgramBinaryMagic, ProgramBinaryVersion, m_DriverHash, Program.first, Binary.Format, static_cast<Uint32>(Binary.Data.size())};
+        memcpy(pDst, &Header, sizeof(Header));
+        pDst += sizeof(Header);
+        memcpy(pDst, Binary.Data.data(), Binary.Data.size());
+        pDst += Binary.Data.size();
+    }
+    pCacheData->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCacheData));
+}
+
+}
@@ -24,6 +24,7 @@
 #include "pch.h"
 #include "GLProgramResources.h"
 #include "RenderDeviceGLImpl.h"
+#include "StringInterner.h"
 
 namespace Diligent
 {
@@ -400,8 +401,8 @@ namespace Diligent
         {                                                               \
             auto& Arr = ResArr;                                         \
             for( auto it = Arr.begin(); it != Arr.end(); ++it )         \
-                /* HashMapStringKey will make a copy of the string*/    \
-                m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(it->Name), CGLShaderVariable(Owner, *it) ) ); \
+                /* Interned names are shared and need not be copied */  \
+                m_VariableHash.insert( std::make_pair( Diligent::HashMapStringKey(StringInterner::Intern(it->Name.c_str())), CGLShaderVariable(Owner, *it) ) ); \
         }
 
         STORE_SHADER_VARIABLES(m_UniformBlocks)
@@ -26,6 +26,8 @@
 #include "RenderDeviceGLImpl.h"
 #include "ShaderGLImpl.h"
 #include "ShaderResourceBindingGLImpl.h"
+#include "GLContextState.h"
+#include "GLTypeConversions.h"
 #include "EngineMemory.h"
 
 namespace Diligent
@@ -41,6 +43,40 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters *pRefCounters, class
     bool bIsProgramPipelineSupported = DeviceCaps.bSeparableProgramSupported;
 
     LinkGLProgram(bIsProgramPipelineSupported);
+    InitResourceBindings(bIsProgramPipelineSupported);
+}
+
+void PipelineStateGLImpl::InitResourceBindings(bool bIsProgramPipelineSupported)
+{
+    // Uniform buffer binding points and texture units are assigned once here rather than 
+    // every time resources are committed. When program pipelines are used, bindings are
+    // allocated across all programs of the pipeline in shader order.
+    Uint32 NumPrograms = bIsProgramPipelineSupported ? m_NumShaders : 1;
+    m_ResourceBindings.resize(NumPrograms);
+    for( Uint32 ProgNum = 0; ProgNum < NumPrograms; ++ProgNum )
+    {
+        auto &Prog = bIsProgramPipelineSupported ? GetShader<ShaderGLImpl>(ProgNum)->m_GlProgObj : m_GLProgram;
+        if( !static_cast<GLuint>(Prog) )
+            continue;
+
+        Uint32 NumStaticUBs = 0, NumDynamicUBs = 0, NumStaticTexUnits = 0, NumDynamicTexUnits = 0;
+        Prog.CountResourceBindings(NumStaticUBs, NumDynamicUBs, NumStaticTexUnits, NumDynamicTexUnits);
+
+        auto &Bindings = m_ResourceBindings[ProgNum];
+        Bindings.FirstStaticUniformBinding  = m_NumUniformBindings;
+        Bindings.FirstDynamicUniformBinding = m_NumUniformBindings + NumStaticUBs;
+        Bindings.FirstStaticTextureUnit     = m_NumTextureUnits;
+        Bindings.FirstDynamicTextureUnit    = m_NumTextureUnits + NumStaticTexUnits;
+        m_NumUniformBindings += NumStaticUBs + NumDynamicUBs;
+        m_NumTextureUnits    += NumStaticTexUnits + NumDynamicTexUnits;
+
+        // glProgramUniform1i() is only available along with separable programs. Otherwise the 
+        // program must be current, so the bindings are applied when resources are first committed.
+        // Separate shader programs may be shared between pipeline states with different layouts,
+        // in which case the device context reapplies the bindings when the pipeline changes.
+        if( bIsProgramPipelineSupported )
+            Prog.ApplyResourceBindings(Bindings.FirstStaticUniformBinding, Bindings.FirstStaticTextureUnit, true);
+    }
 }
 
 void PipelineStateGLImpl::LinkGLProgram(bool bIsProgramPipelineSupported)
@@ -58,42 +94,57 @@ void PipelineStateGLImpl::LinkGLProgram(bool bIsProgramPipelineSupported)
     }
     else
     {
+        auto pDeviceGL = static_cast<RenderDeviceGLImpl*>( GetDevice() );
+        auto &BinaryCache = pDeviceGL->GetProgramBinaryCache();
+
         // Create new progam
         m_GLProgram.Create();
+
+        std::vector<const std::string*> Sources(m_NumShaders);
         for( Uint32 Shader = 0; Shader < m_NumShaders; ++Shader )
+            Sources[Shader] = &GetShader<ShaderGLImpl>(Shader)->m_GLSLSource;
+        auto ProgramKey = BinaryCache.ComputeProgramKey(false, m_NumShaders, Sources.data());
+        if( !BinaryCache.LoadProgram(ProgramKey, m_GLProgram) )
         {
-            auto *pCurrShader = GetShader<ShaderGLImpl>(Shader);
-            glAttachShader( m_GLProgram, pCurrShader->m_GLShaderObj );
-            CHECK_GL_ERROR( "glAttachShader() failed" );
-        }
-        glLinkProgram( m_GLProgram );
-        CHECK_GL_ERROR( "glLinkProgram() failed" );
-        int IsLinked = GL_FALSE;
-        glGetProgramiv( m_GLProgram, GL_LINK_STATUS, (int *)&IsLinked );
-        CHECK_GL_ERROR( "glGetProgramiv() failed" );
-        if( !IsLinked )
-        {
-            int LengthWithNull = 0, Length = 0;
-            // Notice that glGetProgramiv is used to get the length for a shader program, not glGetShaderiv.
-            // The length of the info log includes a null terminator.
-            glGetProgramiv( m_GLProgram, GL_INFO_LOG_LENGTH, &LengthWithNull );
-
-            // The maxLength includes the NULL character
-            std::vector<char> shaderProgramInfoLog( LengthWithNull );
-
-            // Notice that glGetProgramInfoLog  is used, not glGetShaderInfoLog.
-            glGetProgramInfoLog( m_GLProgram, LengthWithNull, &Length, &shaderProgramInfoLog[0] );
-            VERIFY( Length == LengthWithNull-1, "Incorrect program info log len" );
-            LOG_ERROR_MESSAGE( "Failed to link shader program:\n", &shaderProgramInfoLog[0], '\n');
-            UNEXPECTED( "glLinkProgram failed" );
-        }
+            for( Uint32 Shader = 0; Shader < m_NumShaders; ++Shader )
+            {
+                auto *pCurrShader = GetShader<ShaderGLImpl>(Shader);
+                glAttachShader( m_GLProgram, pCurrShader->GetGLShaderObj() );
+                CHECK_GL_ERROR( "glAttachShader() failed" );
+            }
+            BinaryCache.PrepareForLinking( m_GLProgram );
+            glLinkProgram( m_GLProgram );
+            CHECK_GL_ERROR( "glLinkProgram() failed" );
+            int IsLinked = GL_FALSE;
+            glGetProgramiv( m_GLProgram, GL_LINK_STATUS, (int *)&IsLinked );
+            CHECK_GL_ERROR( "glGetProgramiv() failed" );
+            if( !IsLinked )
+            {
+                int LengthWithNull = 0, Length = 0;
+                // Notice that glGetProgramiv is used to get the length for a shader program, not glGetShaderiv.
+                // The length of the info log includes a null terminator.
+                glGetProgramiv( m_GLProgram, GL_INFO_LOG_LENGTH, &LengthWithNull );
+
+                // The maxLength includes the NULL character
+                std::vector<char> shaderProgramInfoLog( LengthWithNull );
+
+                // Notice that glGetProgramInfoLog  is used, not glGetShaderInfoLog.
+                glGetProgramInfoLog( m_GLProgram, LengthWithNull, &Length, &shaderProgramInfoLog[0] );
+                VERIFY( Length == LengthWithNull-1, "Incorrect program info log len" );
+                LOG_ERROR_MESSAGE( "Failed to link shader program:\n", &shaderProgramInfoLog[0], '\n');
+                UNEXPECTED( "glLinkProgram failed" );
+            }
             
-        // Detach shaders from the program object
-        for( Uint32 Shader = 0; Shader < m_NumShaders; ++Shader )
-        {
-            auto *pCurrShader = GetShader<ShaderGLImpl>(Shader);
-            glDetachShader( m_GLProgram, pCurrShader->m_GLShaderObj );
-            CHECK_GL_ERROR( "glDetachShader() failed" );
+            // Detach shaders from the program object
+            for( Uint32 Shader = 0; Shader < m_NumShaders; ++Shader )
+            {
+                auto *pCurrShader = GetShader<ShaderGLImpl>(Shader);
+                glDetachShader( m_GLProgram, pCurrShader->GetGLShaderObj() );
+                CHECK_GL_ERROR( "glDetachShader() failed" );
+            }
+
+            if( IsLinked )
+                BinaryCache.StoreProgram(ProgramKey, m_GLProgram);
         }
 
         std::vector<ShaderVariableDesc> MergedVarTypesArray;
@@ -124,7 +175,6 @@ void PipelineStateGLImpl::LinkGLProgram(bool bIsProgramPipelineSupported)
             }
         }
 
-        auto pDeviceGL = static_cast<RenderDeviceGLImpl*>( GetDevice() );
         m_GLProgram.InitResources(pDeviceGL, DefaultVarType, MergedVarTypesArray.data(), static_cast<Uint32>(MergedVarTypesArray.size()), MergedStSamArray.data(), static_cast<Uint32>(MergedStSamArray.size()), *this);
 
         m_ShaderResourceLayoutHash = m_GLProgram.GetAllResources().GetHash();
@@ -199,4 +249,69 @@ GLObjectWrappers::GLPipelineObj &PipelineStateGLImpl::GetGLProgramPipeline(GLCon
     }
 }
 
+const GLObjectWrappers::GLVertexArrayObj* PipelineStateGLImpl::GetVertexFormatVAO(GLContext::NativeGLContextType Context, GLContextState &GLContextState)
+{
+#if GL_ARB_vertex_attrib_binding
+    ThreadingTools::LockHelper Lock(m_VAOLockFlag);
+    if (!m_bVertexFormatVAOSupported)
+        return nullptr;
+
+    auto it = m_VertexFormatVAOs.find(Context);
+    if (it != m_VertexFormatVAOs.end())
+        return &it->second;
+
+    const auto &InputLayout = m_Desc.GraphicsPipeline.InputLayout;
+    const auto &Caps = GLContextState.GetContextCaps();
+    // The divisor is a property of the buffer binding, so all elements that
+    // share a buffer slot must use the same step rate
+    GLuint SlotDivisors[MaxBufferSlots] = {};
+    bool SlotUsed[MaxBufferSlots] = {};
+    for (Uint32 Elem = 0; Elem < InputLayout.NumElements; ++Elem)
+    {
+        const auto &LayoutElem = InputLayout.LayoutElements[Elem];
+        GLuint Divisor = LayoutElem.Frequency == LayoutElement::FREQUENCY_PER_INSTANCE ? LayoutElem.InstanceDataStepRate : 0;
+        if (LayoutElem.BufferSlot >= MaxBufferSlots ||
+            static_cast<GLint>(LayoutElem.RelativeOffset) > Caps.m_iMaxVertexAttribRelativeOffset ||
+            (SlotUsed[LayoutElem.BufferSlot] && SlotDivisors[LayoutElem.BufferSlot] != Divisor))
+        {
+            m_bVertexFormatVAOSupported = false;
+            return nullptr;
+        }
+        SlotUsed[LayoutElem.BufferSlot] = true;
+        SlotDivisors[LayoutElem.BufferSlot] = Divisor;
+    }
+
+    // Create new VAO
+    it = m_VertexFormatVAOs.emplace( Context, true ).first;
+    GLContextState.BindVAO( it->second );
+    for (Uint32 Elem = 0; Elem < InputLayout.NumElements; ++Elem)
+    {
+        const auto &LayoutElem = InputLayout.LayoutElements[Elem];
+        auto GlType = TypeToGLType(LayoutElem.ValueType);
+        if( !LayoutElem.IsNormalized &&
+            (LayoutElem.ValueType == VT_INT8  || 
+             LayoutElem.ValueType == VT_INT16 ||
+             LayoutElem.ValueType == VT_INT32 ||
+             LayoutElem.ValueType == VT_UINT8 || 
+             LayoutElem.ValueType == VT_UINT16||
+             LayoutElem.ValueType == VT_UINT32 ) )
+            glVertexAttribIFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.RelativeOffset);
+        else
+            glVertexAttribFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, LayoutElem.RelativeOffset);
+        glVertexAttribBinding(LayoutElem.InputIndex, LayoutElem.BufferSlot);
+        glEnableVertexAttribArray(LayoutElem.InputIndex);
+    }
+    for (Uint32 Slot = 0; Slot < MaxBufferSlots; ++Slot)
+    {
+        if (SlotUsed[Slot] && SlotDivisors[Slot] != 0)
+            glVertexBindingDivisor(Slot, SlotDivisors[Slot]);
+    }
+    CHECK_GL_ERROR("Failed to initialize vertex format VAO");
+
+    return &it->second;
+#else
+    return nullptr;
+#endif
+}
+
 }
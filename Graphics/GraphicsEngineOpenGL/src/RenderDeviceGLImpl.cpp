@@ -65,6 +65,8 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemo
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
     m_GLContext(InitAttribs, m_DeviceCaps),
+    m_ProgramBinaryCache(InitAttribs),
+    m_FBOCacheSize(InitAttribs.FBOCacheSize),
     m_TexRegionRender(this)
 {
     GLint NumExtensions = 0;
@@ -81,6 +83,18 @@ RenderDeviceGLImpl :: RenderDeviceGLImpl(IReferenceCounters *pRefCounters, IMemo
     FlagSupportedTexFormats();
     QueryDeviceCaps();
 
+#if GL_ARB_buffer_storage
+    if( InitAttribs.DynamicHeapSize != 0 )
+    {
+        bool bGL44OrAbove = m_DeviceCaps.DevType == DeviceType::OpenGL &&
+                            (m_DeviceCaps.MajorVersion >= 5 || (m_DeviceCaps.MajorVersion == 4 && m_DeviceCaps.MinorVersion >= 4) );
+        if( bGL44OrAbove || CheckExtension( "GL_ARB_buffer_storage" ) )
+            m_pDynamicHeap.reset( new GLDynamicHeap(GetRawAllocator(), InitAttribs.DynamicHeapSize) );
+        else
+            LOG_INFO_MESSAGE( "GL_ARB_buffer_storage is not supported. Dynamic buffers will be orphaned when mapped with MAP_FLAG_DISCARD" );
+    }
+#endif
+
     std::basic_string<GLubyte> glstrVendor = glGetString( GL_VENDOR );
     std::string Vendor = StrToLower(std::string(glstrVendor.begin(), glstrVendor.end()));
     LOG_INFO_MESSAGE("GPU Vendor: ", Vendor);
@@ -695,10 +709,29 @@ void RenderDeviceGLImpl :: QueryDeviceCaps()
 }
 
 
+void RenderDeviceGLImpl::GetProgramBinaryCacheData(IDataBlob **ppCacheData)
+{
+    m_ProgramBinaryCache.Serialize(ppCacheData);
+}
+
+void RenderDeviceGLImpl::GetFBOCacheStatistics(void *pNativeGLContext, FBOCacheStatistics &Stats)
+{
+    auto Context = pNativeGLContext != nullptr ? static_cast<GLContext::NativeGLContextType>(pNativeGLContext) : m_GLContext.GetCurrentNativeGLContext();
+    Stats = FBOCacheStatistics{};
+    // Do not create the cache if the engine has not rendered to the context
+    ThreadingTools::LockHelper FBOCacheLock(m_FBOCacheLockFlag);
+    auto It = m_FBOCache.find(Context);
+    if( It != m_FBOCache.end() )
+        Stats = It->second.GetStatistics();
+}
+
 FBOCache& RenderDeviceGLImpl::GetFBOCache(GLContext::NativeGLContextType Context)
 {
     ThreadingTools::LockHelper FBOCacheLock(m_FBOCacheLockFlag);
-    return m_FBOCache[Context];
+    auto It = m_FBOCache.find(Context);
+    if( It == m_FBOCache.end() )
+        It = m_FBOCache.emplace(std::piecewise_construct, std::forward_as_tuple(Context), std::forward_as_tuple(m_FBOCacheSize)).first;
+    return It->second;
 }
 
 void RenderDeviceGLImpl::OnReleaseTexture(ITexture *pTexture)
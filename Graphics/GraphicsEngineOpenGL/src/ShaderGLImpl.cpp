@@ -33,13 +33,11 @@ using namespace Diligent;
 namespace Diligent
 {
 
-ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl *pDeviceGL, const ShaderCreationAttribs &CreationAttribs, bool bIsDeviceInternal) : 
-    TShaderBase( pRefCounters, pDeviceGL, CreationAttribs.Desc, bIsDeviceInternal ),
-    m_GlProgObj(false),
-    m_GLShaderObj( false, GLObjectWrappers::GLShaderObjCreateReleaseHelper( GetGLShaderType( m_Desc.ShaderType ) ) )
+static GLObjectWrappers::GLShaderObj CompileGLShader(SHADER_TYPE        ShaderType,
+                                                    const std::string& GLSLSource,
+                                                    const Char*        Name,
+                                                    IDataBlob**        ppCompilerOutput)
 {
-    auto GLSLSource = BuildGLSLSourceString(CreationAttribs, TargetGLSLCompiler::driver);
-
     // Note: there is a simpler way to create the program:
     //m_uiShaderSeparateProg = glCreateShaderProgramv(GL_VERTEX_SHADER, _countof(ShaderStrings), ShaderStrings);
     // NOTE: glCreateShaderProgramv() is considered equivalent to both a shader compilation and a program linking 
@@ -51,7 +49,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl
     // The log can then be queried in the same way
 
     // Create empty shader object
-    auto GLShaderType = GetGLShaderType(m_Desc.ShaderType);
+    auto GLShaderType = GetGLShaderType(ShaderType);
     GLObjectWrappers::GLShaderObj ShaderObj(true, GLObjectWrappers::GLShaderObjCreateReleaseHelper(GLShaderType));
 
     // Each element in the length array may contain the length of the corresponding string 
@@ -74,7 +72,7 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl
             FullSource.append(str);
 
         std::stringstream ErrorMsgSS;
-		ErrorMsgSS << "Failed to compile shader file \""<< (CreationAttribs.Desc.Name != nullptr ? CreationAttribs.Desc.Name : "") << '\"' << std::endl;
+		ErrorMsgSS << "Failed to compile shader file \""<< (Name != nullptr ? Name : "") << '\"' << std::endl;
         int infoLogLen = 0;
         // The function glGetShaderiv() tells how many bytes to allocate; the length includes the NULL terminator. 
         glGetShaderiv(ShaderObj, GL_INFO_LOG_LENGTH, &infoLogLen);
@@ -91,14 +89,14 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl
             ErrorMsgSS << "InfoLog:" << std::endl << infoLog.data() << std::endl;
         }
 
-        if (CreationAttribs.ppCompilerOutput != nullptr)
+        if (ppCompilerOutput != nullptr)
         {
             // infoLogLen accounts for null terminator
             auto *pOutputDataBlob = MakeNewRCObj<DataBlobImpl>()(infoLogLen + FullSource.length() + 1);
             char* DataPtr = reinterpret_cast<char*>(pOutputDataBlob->GetDataPtr());
             memcpy(DataPtr, !infoLog.empty() ? infoLog.data() : nullptr, infoLogLen);
             memcpy(DataPtr + infoLogLen, FullSource.data(), FullSource.length() + 1);
-            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(CreationAttribs.ppCompilerOutput));
+            pOutputDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppCompilerOutput));
         }
         else
         {
@@ -109,6 +107,17 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl
         LOG_ERROR_AND_THROW(ErrorMsgSS.str().c_str());
     }
 
+    return ShaderObj;
+}
+
+ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl *pDeviceGL, const ShaderCreationAttribs &CreationAttribs, bool bIsDeviceInternal) : 
+    TShaderBase( pRefCounters, pDeviceGL, CreationAttribs.Desc, bIsDeviceInternal ),
+    m_GlProgObj(false),
+    m_GLShaderObj( false, GLObjectWrappers::GLShaderObjCreateReleaseHelper( GetGLShaderType( m_Desc.ShaderType ) ) )
+{
+    auto GLSLSource = BuildGLSLSourceString(CreationAttribs, TargetGLSLCompiler::driver);
+    auto &BinaryCache = pDeviceGL->GetProgramBinaryCache();
+
     auto DeviceCaps = pDeviceGL->GetDeviceCaps();
     if( DeviceCaps.bSeparableProgramSupported )
     {
@@ -116,51 +125,68 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters *pRefCounters, RenderDeviceGLImpl
 
         // GL_PROGRAM_SEPARABLE parameter must be set before linking!
         glProgramParameteri( m_GlProgObj, GL_PROGRAM_SEPARABLE, GL_TRUE );
-        glAttachShader( m_GlProgObj, ShaderObj );
-        //With separable program objects, interfaces between shader stages may
-        //involve the outputs from one program object and the inputs from a
-        //second program object. For such interfaces, it is not possible to
-        //detect mismatches at link time, because the programs are linked
-        //separately. When each such program is linked, all inputs or outputs
-        //interfacing with another program stage are treated as active. The
-        //linker will generate an executable that assumes the presence of a
-        //compatible program on the other side of the interface. If a mismatch
-        //between programs occurs, no GL error will be generated, but some or all
-        //of the inputs on the interface will be undefined.
-        glLinkProgram( m_GlProgObj );
-        CHECK_GL_ERROR( "glLinkProgram() failed" );
-        int IsLinked = GL_FALSE;
-        glGetProgramiv( m_GlProgObj, GL_LINK_STATUS, (int *)&IsLinked );
-        CHECK_GL_ERROR( "glGetProgramiv() failed" );
-        if( !IsLinked )
-        {
-            int LengthWithNull = 0, Length = 0;
-            // Notice that glGetProgramiv is used to get the length for a shader program, not glGetShaderiv.
-            // The length of the info log includes a null terminator.
-            glGetProgramiv( m_GlProgObj, GL_INFO_LOG_LENGTH, &LengthWithNull );
-
-            // The maxLength includes the NULL character
-            std::vector<char> shaderProgramInfoLog( LengthWithNull );
-
-            // Notice that glGetProgramInfoLog is used, not glGetShaderInfoLog.
-            glGetProgramInfoLog( m_GlProgObj, LengthWithNull, &Length, &shaderProgramInfoLog[0] );
-            VERIFY( Length == LengthWithNull-1, "Incorrect program info log len" );
-            LOG_ERROR_AND_THROW( "Failed to link shader program:\n", &shaderProgramInfoLog[0], '\n');
-        }
 
-        glDetachShader( m_GlProgObj, ShaderObj );
+        const std::string* Sources[] = { &GLSLSource };
+        auto ProgramKey = BinaryCache.ComputeProgramKey(true, _countof(Sources), Sources);
+        if( !BinaryCache.LoadProgram(ProgramKey, m_GlProgObj) )
+        {
+            auto ShaderObj = CompileGLShader(m_Desc.ShaderType, GLSLSource, CreationAttribs.Desc.Name, CreationAttribs.ppCompilerOutput);
+
+            glAttachShader( m_GlProgObj, ShaderObj );
+            //With separable program objects, interfaces between shader stages may
+            //involve the outputs from one program object and the inputs from a
+            //second program object. For such interfaces, it is not possible to
+            //detect mismatches at link time, because the programs are linked
+            //separately. When each such program is linked, all inputs or outputs
+            //interfacing with another program stage are treated as active. The
+            //linker will generate an executable that assumes the presence of a
+            //compatible program on the other side of the interface. If a mismatch
+            //between programs occurs, no GL error will be generated, but some or all
+            //of the inputs on the interface will be undefined.
+            BinaryCache.PrepareForLinking( m_GlProgObj );
+            glLinkProgram( m_GlProgObj );
+            CHECK_GL_ERROR( "glLinkProgram() failed" );
+            int IsLinked = GL_FALSE;
+            glGetProgramiv( m_GlProgObj, GL_LINK_STATUS, (int *)&IsLinked );
+            CHECK_GL_ERROR( "glGetProgramiv() failed" );
+            if( !IsLinked )
+            {
+                int LengthWithNull = 0, Length = 0;
+                // Notice that glGetProgramiv is used to get the length for a shader program, not glGetShaderiv.
+                // The length of the info log includes a null terminator.
+                glGetProgramiv( m_GlProgObj, GL_INFO_LOG_LENGTH, &LengthWithNull );
+
+                // The maxLength includes the NULL character
+                std::vector<char> shaderProgramInfoLog( LengthWithNull );
+
+                // Notice that glGetProgramInfoLog is used, not glGetShaderInfoLog.
+                glGetProgramInfoLog( m_GlProgObj, LengthWithNull, &Length, &shaderProgramInfoLog[0] );
+                VERIFY( Length == LengthWithNull-1, "Incorrect program info log len" );
+                LOG_ERROR_AND_THROW( "Failed to link shader program:\n", &shaderProgramInfoLog[0], '\n');
+            }
+
+            glDetachShader( m_GlProgObj, ShaderObj );
         
-        // glDeleteShader() deletes the shader immediately if it is not attached to any program 
-        // object. Otherwise, the shader is flagged for deletion and will be deleted when it is 
-        // no longer attached to any program object. If an object is flagged for deletion, its 
-        // boolean status bit DELETE_STATUS is set to true
-        ShaderObj.Release();
+            // glDeleteShader() deletes the shader immediately if it is not attached to any program 
+            // object. Otherwise, the shader is flagged for deletion and will be deleted when it is 
+            // no longer attached to any program object. If an object is flagged for deletion, its 
+            // boolean status bit DELETE_STATUS is set to true
+            ShaderObj.Release();
+
+            BinaryCache.StoreProgram(ProgramKey, m_GlProgObj);
+        }
 
         m_GlProgObj.InitResources(pDeviceGL, m_Desc.DefaultVariableType, m_Desc.VariableDesc, m_Desc.NumVariables, m_Desc.StaticSamplers, m_Desc.NumStaticSamplers, *this);
     }
+    else if( BinaryCache.IsEnabled() )
+    {
+        // The shader is only compiled if the pipeline state that uses it does not
+        // find its program in the binary cache, see GetGLShaderObj()
+        m_GLSLSource = std::move( GLSLSource );
+    }
     else
     {
-        m_GLShaderObj = std::move( ShaderObj );
+        m_GLShaderObj = CompileGLShader(m_Desc.ShaderType, GLSLSource, CreationAttribs.Desc.Name, CreationAttribs.ppCompilerOutput);
     }
 }
 
@@ -168,6 +194,16 @@ ShaderGLImpl::~ShaderGLImpl()
 {
 }
 
+const GLObjectWrappers::GLShaderObj& ShaderGLImpl::GetGLShaderObj()
+{
+    if( !m_GLShaderObj )
+    {
+        VERIFY( !m_GLSLSource.empty(), "The shader has neither been compiled nor has its source been preserved" );
+        m_GLShaderObj = CompileGLShader(m_Desc.ShaderType, m_GLSLSource, m_Desc.Name, nullptr);
+    }
+    return m_GLShaderObj;
+}
+
 IMPLEMENT_QUERY_INTERFACE( ShaderGLImpl, IID_ShaderGL, TShaderBase )
 
 void ShaderGLImpl::BindResources( IResourceMapping* pResourceMapping, Uint32 Flags )
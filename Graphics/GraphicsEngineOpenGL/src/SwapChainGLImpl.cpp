@@ -71,6 +71,10 @@ IMPLEMENT_QUERY_INTERFACE( SwapChainGLImpl, IID_SwapChainGL, TSwapChainBase )
 
 void SwapChainGLImpl::Present(Uint32 SyncInterval)
 {
+    // Fence the space used by dynamic buffers during the frame so that it can be reused
+    if( auto *pDynamicHeap = m_pRenderDevice.RawPtr<RenderDeviceGLImpl>()->GetDynamicHeap() )
+        pDynamicHeap->FinishFrame();
+
 #if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_ANDROID
     auto *pDeviceGL = m_pRenderDevice.RawPtr<RenderDeviceGLImpl>();
     auto &GLContext = pDeviceGL->m_GLContext;
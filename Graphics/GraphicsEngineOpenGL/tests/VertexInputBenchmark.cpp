@@ -0,0 +1,332 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the CPU cost of submitting draw commands when vertex buffers are bound through
+// the VAO cache and when they are bound to the pipeline's vertex format VAO with separate
+// vertex attribute binding (GL_ARB_vertex_attrib_binding). Both pipelines read the same two
+// attributes from one buffer slot; the VAO cache pipeline makes the second attribute per-instance,
+// which cannot be expressed with separate vertex format. Every draw binds a different vertex buffer.
+// The test requires an X display and an OpenGL 4.3 context and is skipped when none is available.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "RenderDeviceFactoryOpenGL.h"
+#include "RefCntAutoPtr.h"
+#include "Timer.h"
+
+// Xlib defines Bool, None and other macros that clash with engine identifiers, so it must be included last
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr Uint32 NumVertexBuffers = 64;
+static constexpr Uint32 NumDraws         = 20000;
+static constexpr Uint32 NumFrames        = 20;
+static constexpr Uint32 RenderTargetSize = 64;
+
+// Unmapped window with a current OpenGL 4.3 core context
+class GLXContextHolder
+{
+public:
+    ~GLXContextHolder()
+    {
+        if (m_Context != nullptr)
+        {
+            glXMakeCurrent(m_Display, 0, nullptr);
+            glXDestroyContext(m_Display, m_Context);
+        }
+        if (m_Window != 0)
+            XDestroyWindow(m_Display, m_Window);
+        if (m_Colormap != 0)
+            XFreeColormap(m_Display, m_Colormap);
+        if (m_Display != nullptr)
+            XCloseDisplay(m_Display);
+    }
+
+    bool Create()
+    {
+        m_Display = XOpenDisplay(nullptr);
+        if (m_Display == nullptr)
+            return false;
+
+        static const int FBConfigAttribs[] =
+        {
+            GLX_RENDER_TYPE,   GLX_RGBA_BIT,
+            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+            GLX_DOUBLEBUFFER,  True,
+            GLX_RED_SIZE,      8,
+            GLX_GREEN_SIZE,    8,
+            GLX_BLUE_SIZE,     8,
+            0
+        };
+        int NumConfigs = 0;
+        auto *pConfigs = glXChooseFBConfig(m_Display, DefaultScreen(m_Display), FBConfigAttribs, &NumConfigs);
+        if (pConfigs == nullptr || NumConfigs == 0)
+            return false;
+        auto FBConfig = pConfigs[0];
+        XFree(pConfigs);
+
+        auto *pVisualInfo = glXGetVisualFromFBConfig(m_Display, FBConfig);
+        if (pVisualInfo == nullptr)
+            return false;
+        auto RootWnd = RootWindow(m_Display, pVisualInfo->screen);
+        m_Colormap = XCreateColormap(m_Display, RootWnd, pVisualInfo->visual, AllocNone);
+        XSetWindowAttributes WndAttribs = {};
+        WndAttribs.colormap = m_Colormap;
+        m_Window = XCreateWindow(m_Display, RootWnd, 0, 0, RenderTargetSize, RenderTargetSize, 0, pVisualInfo->depth,
+                                 InputOutput, pVisualInfo->visual, CWBorderPixel | CWColormap, &WndAttribs);
+        XFree(pVisualInfo);
+        if (m_Window == 0)
+            return false;
+
+        auto glXCreateContextAttribsARB = reinterpret_cast<PFNGLXCREATECONTEXTATTRIBSARBPROC>(
+            glXGetProcAddressARB(reinterpret_cast<const GLubyte*>("glXCreateContextAttribsARB")));
+        if (glXCreateContextAttribsARB == nullptr)
+            return false;
+        static const int ContextAttribs[] =
+        {
+            GLX_CONTEXT_MAJOR_VERSION_ARB, 4,
+            GLX_CONTEXT_MINOR_VERSION_ARB, 3,
+            GLX_CONTEXT_PROFILE_MASK_ARB,  GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+            0
+        };
+        // Failure to create the context is reported through the X error handler that terminates
+        // the process by default
+        auto OldErrorHandler = XSetErrorHandler([](::Display*, XErrorEvent*){ return 0; });
+        m_Context = glXCreateContextAttribsARB(m_Display, FBConfig, nullptr, True, ContextAttribs);
+        XSync(m_Display, False);
+        XSetErrorHandler(OldErrorHandler);
+        if (m_Context == nullptr)
+            return false;
+
+        return glXMakeCurrent(m_Display, m_Window, m_Context);
+    }
+
+    ::Display* GetDisplay()const{ return m_Display; }
+    ::Window GetWindow()const{ return m_Window; }
+
+private:
+    ::Display*  m_Display  = nullptr;
+    ::Colormap  m_Colormap = 0;
+    ::Window    m_Window   = 0;
+    GLXContext  m_Context  = nullptr;
+};
+
+const char* const VSSource = R"(
+layout(location = 0) in vec4 in_Pos;
+layout(location = 1) in vec4 in_Color;
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+layout(location = 0) out vec4 out_Color;
+void main()
+{
+    gl_Position = in_Pos;
+    out_Color = in_Color;
+}
+)";
+
+const char* const PSSource = R"(
+layout(location = 0) in vec4 in_Color;
+layout(location = 0) out vec4 out_Color;
+void main()
+{
+    out_Color = in_Color;
+}
+)";
+
+class DrawBenchmark
+{
+public:
+    DrawBenchmark(IRenderDevice* pDevice, IDeviceContext* pContext) :
+        m_pContext(pContext)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Draw benchmark render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = RenderTargetSize;
+        TexDesc.Height    = RenderTargetSize;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(TexDesc, TextureData{}, &m_pRenderTarget);
+
+        ShaderCreationAttribs ShaderAttribs;
+        ShaderAttribs.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderAttribs.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderAttribs.Desc.Name       = "Draw benchmark VS";
+        ShaderAttribs.Source          = VSSource;
+        pDevice->CreateShader(ShaderAttribs, &m_pVS);
+        ShaderAttribs.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderAttribs.Desc.Name       = "Draw benchmark PS";
+        ShaderAttribs.Source          = PSSource;
+        pDevice->CreateShader(ShaderAttribs, &m_pPS);
+
+        m_pVertexFormatPSO = CreatePSO(pDevice, LayoutElement::FREQUENCY_PER_VERTEX);
+        m_pVAOCachePSO     = CreatePSO(pDevice, LayoutElement::FREQUENCY_PER_INSTANCE);
+
+        // Three vertices with position and color
+        const float Vertices[] =
+        {
+            -1, -1, 0, 1,   1, 0, 0, 1,
+             0, +1, 0, 1,   0, 1, 0, 1,
+            +1, -1, 0, 1,   0, 0, 1, 1
+        };
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Draw benchmark vertex buffer";
+        BuffDesc.uiSizeInBytes = sizeof(Vertices);
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage         = USAGE_STATIC;
+        BufferData BuffData;
+        BuffData.pData    = Vertices;
+        BuffData.DataSize = sizeof(Vertices);
+        for (auto& pBuffer : m_pVertexBuffers)
+            pDevice->CreateBuffer(BuffDesc, BuffData, &pBuffer);
+    }
+
+    bool IsInitialized()const
+    {
+        if (m_pRenderTarget == nullptr || m_pVertexFormatPSO == nullptr || m_pVAOCachePSO == nullptr)
+            return false;
+        for (const auto& pBuffer : m_pVertexBuffers)
+        {
+            if (pBuffer == nullptr)
+                return false;
+        }
+        return true;
+    }
+
+    // Returns the average time it takes to submit one draw command, in microseconds
+    double Run(bool UseVAOCache)
+    {
+        ITextureView* pRTV[] = {m_pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        m_pContext->SetRenderTargets(1, pRTV, nullptr);
+        Viewport VP(0, 0, static_cast<float>(RenderTargetSize), static_cast<float>(RenderTargetSize));
+        m_pContext->SetViewports(1, &VP, RenderTargetSize, RenderTargetSize);
+        m_pContext->SetPipelineState(UseVAOCache ? m_pVAOCachePSO : m_pVertexFormatPSO);
+        m_pContext->CommitShaderResources(nullptr, 0);
+
+        DrawAttribs Attribs;
+        Attribs.NumVertices = 3;
+        double TotalTime = 0;
+        for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            Timer timer;
+            for (Uint32 Draw = 0; Draw < NumDraws; ++Draw)
+            {
+                IBuffer* pBuffer = m_pVertexBuffers[Draw % NumVertexBuffers];
+                Uint32 Offset = 0;
+                m_pContext->SetVertexBuffers(0, 1, &pBuffer, &Offset, SET_VERTEX_BUFFERS_FLAG_RESET);
+                m_pContext->Draw(Attribs);
+            }
+            TotalTime += timer.GetElapsedTime();
+
+            // Do not let the GPU work of previous frames affect the measurements
+            m_pContext->Flush();
+            glFinish();
+        }
+        return TotalTime / (NumFrames * NumDraws) * 1e+6;
+    }
+
+private:
+    RefCntAutoPtr<IPipelineState> CreatePSO(IRenderDevice* pDevice, LayoutElement::FREQUENCY ColorFrequency)
+    {
+        PipelineStateDesc PSODesc;
+        PSODesc.Name = ColorFrequency == LayoutElement::FREQUENCY_PER_VERTEX ? "Vertex format PSO" : "VAO cache PSO";
+        auto &GraphicsPipeline = PSODesc.GraphicsPipeline;
+        GraphicsPipeline.pVS = m_pVS;
+        GraphicsPipeline.pPS = m_pPS;
+        GraphicsPipeline.NumRenderTargets = 1;
+        GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        // Elements in one buffer slot with different step rates can only be described by a VAO
+        // that references the buffer, so the second pipeline always goes through the VAO cache
+        LayoutElement Elements[] =
+        {
+            LayoutElement(0, 0, 4, VT_FLOAT32, False, 0,  32),
+            LayoutElement(1, 0, 4, VT_FLOAT32, False, 16, 32, ColorFrequency)
+        };
+        GraphicsPipeline.InputLayout.LayoutElements = Elements;
+        GraphicsPipeline.InputLayout.NumElements    = _countof(Elements);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreatePipelineState(PSODesc, &pPSO);
+        return pPSO;
+    }
+
+    IDeviceContext*        m_pContext;
+    RefCntAutoPtr<ITexture> m_pRenderTarget;
+    RefCntAutoPtr<IShader> m_pVS;
+    RefCntAutoPtr<IShader> m_pPS;
+    RefCntAutoPtr<IPipelineState> m_pVertexFormatPSO;
+    RefCntAutoPtr<IPipelineState> m_pVAOCachePSO;
+    RefCntAutoPtr<IBuffer> m_pVertexBuffers[NumVertexBuffers];
+};
+
+}
+
+int main()
+{
+    GLXContextHolder GLXContext;
+    if (!GLXContext.Create())
+    {
+        std::cout << "OpenGL 4.3 context is not available, skipping the test\n";
+        return SKIP_RETURN_CODE;
+    }
+
+    EngineGLAttribs Attribs;
+    Attribs.pNativeWndHandle = reinterpret_cast<void*>(static_cast<size_t>(GLXContext.GetWindow()));
+    Attribs.pDisplay         = GLXContext.GetDisplay();
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    GetEngineFactoryOpenGL()->AttachToActiveGLContext(Attribs, &pDevice, &pContext);
+    if (!pDevice)
+    {
+        std::cout << "Failed to attach to the OpenGL context, skipping the test\n";
+        return SKIP_RETURN_CODE;
+    }
+
+    DrawBenchmark Benchmark(pDevice, pContext);
+    if (!Benchmark.IsInitialized())
+    {
+        std::cout << "Failed to create benchmark resources\n";
+        return 1;
+    }
+
+    // Warm up both paths so that VAOs are created before the measurements
+    Benchmark.Run(false);
+    Benchmark.Run(true);
+    auto VertexFormatTime = Benchmark.Run(false);
+    auto VAOCacheTime     = Benchmark.Run(true);
+    std::cout << "Draw submission time, us per draw\n" << std::fixed << std::setprecision(3)
+              << "Vertex attrib binding: " << std::setw(8) << VertexFormatTime << '\n'
+              << "VAO cache:             " << std::setw(8) << VAOCacheTime << '\n';
+    return 0;
+}
@@ -51,7 +51,7 @@ public:
     virtual void QueryInterface( const Diligent::INTERFACE_ID& IID, IObject** ppInterface )override;
 
 	// Returns the fence value that will be signaled next time
-    virtual UINT64 GetNextFenceValue()override final { return m_NextFenceValue; }
+    virtual Uint64 GetNextFenceValue()override final { return m_NextFenceValue; }
 
 	// Executes a given command buffer
 	virtual Uint64 ExecuteCommandBuffer(VkCommandBuffer cmdBuffer)override final;
@@ -31,15 +31,18 @@
 #include "DeviceContextBase.h"
 #include "VulkanUtilities/VulkanCommandBufferPool.h"
 #include "VulkanUtilities/VulkanCommandBuffer.h"
+#include "VulkanUtilities/VulkanObjectWrappers.h"
 #include "VulkanUtilities/VulkanUploadHeap.h"
 #include "VulkanDynamicHeap.h"
 #include "ResourceReleaseQueue.h"
 #include "DescriptorPoolManager.h"
+#include "DynamicDescriptorSetCache.h"
 #include "PipelineLayout.h"
+#include "RenderPassCache.h"
 #include "GenerateMipsVkHelper.h"
-#include "BufferVKImpl.h"
-#include "TextureViewVKImpl.h"
-#include "PipelineStateVKImpl.h"
+#include "BufferVkImpl.h"
+#include "TextureViewVkImpl.h"
+#include "PipelineStateVkImpl.h"
 
 namespace Diligent
 {
@@ -55,6 +58,7 @@ public:
                         bool                                  bIsDeferred,
                         const EngineVkAttribs&                Attribs,
                         Uint32                                ContextId,
+                        COMMAND_QUEUE_TYPE                    QueueType,
                         std::shared_ptr<GenerateMipsVkHelper> GenerateMipsHelper);
     ~DeviceContextVkImpl();
     
@@ -96,6 +100,8 @@ public:
 
     virtual void ExecuteCommandList(class ICommandList* pCommandList)override final;
 
+    virtual void ExecuteCommandLists(Uint32 NumCommandLists, class ICommandList* const* ppCommandLists)override final;
+
     virtual void SignalFence(IFence* pFence, Uint64 Value)override final;
 
     void TransitionImageLayout(class TextureVkImpl &TextureVk, VkImageLayout NewLayout);
@@ -105,6 +111,10 @@ public:
     void BufferMemoryBarrier(class BufferVkImpl &BufferVk, VkAccessFlags NewAccessFlags);
     virtual void BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags)override final;
 
+    virtual void WaitForCommandQueue(COMMAND_QUEUE_TYPE QueueType)override final;
+
+    virtual Uint32 GetNumPipelineBarriersInLastFrame()const override final;
+
     void AddWaitSemaphore(VkSemaphore Semaphore, VkPipelineStageFlags WaitDstStageMask)
     {
         m_WaitSemaphores.push_back(Semaphore);
@@ -125,11 +135,12 @@ public:
 
     void CopyBufferRegion(class BufferVkImpl* pSrcBuffVk, class BufferVkImpl* pDstBuffVk, Uint64 SrcOffset, Uint64 DstOffset, Uint64 NumBytes);
     void CopyTextureRegion(class TextureVkImpl* pSrcTexture, class TextureVkImpl* pDstTexture, const VkImageCopy &CopyRegion);
-#if 0
-    void CopyTextureRegion(IBuffer* pSrcBuffer, Uint32 SrcStride, Uint32 SrcDepthStride, class TextureVkImpl* pTextureVk, Uint32 DstSubResIndex, const Box &DstBox);
-#endif
+    void CopyTextureRegion(class BufferVkImpl* pSrcBuffer, Uint32 SrcStride, Uint32 SrcDepthStride, class TextureVkImpl* pTextureVk, Uint32 MipLevel, Uint32 Slice, const Box &DstBox);
     void GenerateMips(class TextureViewVkImpl& TexView)
     {
+        VERIFY(m_QueueType == COMMAND_QUEUE_TYPE_GRAPHICS, "Mipmaps are generated with blit commands that require the graphics queue");
+        // The helper captures the layout of the texture before transitioning it
+        FlushDeferredClears();
         m_GenerateMipsHelper->GenerateMips(TexView, *this, *m_GenerateMipsSRB);
     }
 
@@ -139,6 +150,9 @@ public:
 
     Uint32 GetContextId()const{return m_ContextId;}
 
+    // Type of the queue the context records commands for
+    COMMAND_QUEUE_TYPE GetQueueType()const{return m_QueueType;}
+
     size_t GetNumCommandsInCtx()const { return m_State.NumCommands; }
 
     VulkanUtilities::VulkanCommandBuffer& GetCommandBuffer()
@@ -156,18 +170,32 @@ public:
         return m_DynamicDescriptorPool.Allocate(SetLayout);
     }
 
+    DynamicDescriptorSetCache& GetDynamicDescriptorSetCache(){return m_DynamicDescrSetCache;}
+
+    // Returns scratch space for the descriptor data written through descriptor update templates.
+    // The contents are only valid until the next call.
+    ShaderResourceCacheVk::DescriptorData* GetDescriptorDataScratch(Uint32 NumDescriptors)
+    {
+        if (m_DescriptorDataScratch.size() < NumDescriptors)
+            m_DescriptorDataScratch.resize(NumDescriptors);
+        return m_DescriptorDataScratch.data();
+    }
+
     VulkanDynamicAllocation AllocateDynamicSpace(Uint32 SizeInBytes);
 
     void ResetRenderTargets();
 
 private:
+    Uint64 Flush(Uint32 NumCommandBuffers, const VkCommandBuffer* pCommandBuffers);
     void CommitRenderPassAndFramebuffer();
+    void FlushDeferredClears();
+    void FlushDeferredClears(const TextureVkImpl& TextureVk);
     void CommitVkVertexBuffers();
     void TransitionVkVertexBuffers();
     void CommitViewports();
     void CommitScissorRects();
     
-    inline void EnsureVkCmdBuffer();
+    void EnsureVkCmdBuffer();
     inline void DisposeVkCmdBuffer(VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
     inline void DisposeCurrentCmdBuffer(Uint64 FenceValue);
     void ReleaseStaleContextResources(Uint64 SubmittedCmdBufferNumber, Uint64 SubmittedFenceValue, Uint64 CompletedFenceValue);
@@ -197,9 +225,33 @@ private:
     /// This framebuffer may or may not be currently set in the command buffer
     VkFramebuffer m_Framebuffer = VK_NULL_HANDLE;
 
+    /// Key of the render pass that matches currently bound render targets. All attachments
+    /// in this render pass use VK_ATTACHMENT_LOAD_OP_LOAD and VK_ATTACHMENT_STORE_OP_STORE.
+    RenderPassCache::RenderPassCacheKey m_RenderPassKey;
+
+    /// Clears of the bound attachments requested before the render pass has been begun.
+    /// They are performed by CommitRenderPassAndFramebuffer() through VK_ATTACHMENT_LOAD_OP_CLEAR
+    /// rather than vkCmdClearAttachments, which saves reading the previous contents of the attachments.
+    struct DeferredClearsInfo
+    {
+        /// Bit mask of the render targets to clear
+        Uint32 RTMask       = 0;
+        bool   ClearDepth   = false;
+        bool   ClearStencil = false;
+
+        /// Clear values indexed by the render pass attachment number
+        VkClearValue ClearValues[MaxRenderTargets + 1];
+
+        bool IsEmpty()const
+        {
+            return RTMask == 0 && !ClearDepth && !ClearStencil;
+        }
+    }m_DeferredClears;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     const Uint32 m_ContextId;
+    const COMMAND_QUEUE_TYPE m_QueueType;
 
     VulkanUtilities::VulkanCommandBufferPool m_CmdPool;
 
@@ -207,6 +259,17 @@ private:
     std::vector<VkSemaphore>                m_WaitSemaphores;
     std::vector<VkPipelineStageFlags>       m_WaitDstStageMasks;
     std::vector<VkSemaphore>                m_SignalSemaphores;
+    // Number of vkCmdPipelineBarrier() calls recorded by the context during the last finished frame
+    Uint32 m_NumPipelineBarriersInLastFrame = 0;
+
+    // Command buffers submitted by the last Flush()
+    std::vector<VkCommandBuffer>            m_SubmitCmdBuffers;
+
+    // Semaphores signaled by the last command lists executed on the dedicated queues that
+    // the immediate context has not waited for yet
+    VulkanUtilities::SemaphoreWrapper              m_QueueSemaphores[COMMAND_QUEUE_TYPE_NUM_TYPES];
+    // Semaphores the next submitted command buffer waits for. They are released after the submission.
+    std::vector<VulkanUtilities::SemaphoreWrapper> m_SemaphoresToRelease;
 
     // List of fences to signal next time the command context is flushed
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence> > > m_PendingFences;
@@ -216,6 +279,9 @@ private:
 
     VulkanUtilities::VulkanUploadHeap m_UploadHeap;
     DescriptorPoolManager m_DynamicDescriptorPool;
+    // Dynamic descriptor sets written in the current frame (command list for deferred contexts)
+    DynamicDescriptorSetCache m_DynamicDescrSetCache;
+    std::vector<ShaderResourceCacheVk::DescriptorData> m_DescriptorDataScratch;
 
     // Number of the command buffer currently being recorded by the context and that will
     // be submitted next
@@ -0,0 +1,115 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DynamicDescriptorSetCache class
+
+#include <unordered_map>
+#include <vector>
+#include "UniqueIdentifier.h"
+#include "DescriptorPoolManager.h"
+
+namespace Diligent
+{
+
+/// Cache of dynamic descriptor sets owned by a device context
+
+/// Every time shader resources with dynamic variables are committed, a new descriptor set must
+/// be allocated and written. The cache keeps the sets that have already been written within the
+/// current command buffer, so that committing the same objects again only requires a hash table lookup.
+/// The cache is not thread-safe and is reset every time the context submits its commands, at which 
+/// point all sets are returned to the context's dynamic descriptor pool. The number of cached sets
+/// is bounded by MaxCachedSets: when the limit is reached, the cache is reset before a new set is added.
+class DynamicDescriptorSetCache
+{
+public:
+    static constexpr size_t MaxCachedSets = 4096;
+
+    DynamicDescriptorSetCache() = default;
+
+    DynamicDescriptorSetCache             (const DynamicDescriptorSetCache&) = delete;
+    DynamicDescriptorSetCache             (DynamicDescriptorSetCache&&)      = delete;
+    DynamicDescriptorSetCache& operator = (const DynamicDescriptorSetCache&) = delete;
+    DynamicDescriptorSetCache& operator = (DynamicDescriptorSetCache&&)      = delete;
+
+    // This structure is used as the key to find descriptor set
+    struct DescriptorSetCacheKey
+    {
+        // Unique identifier of the pipeline state that defines descriptor set layout.
+        // Vulkan handles cannot be used as they may be reused after the objects are released.
+        UniqueIdentifier              PSOId = 0;
+
+        // Unique identifiers of all objects written to the descriptor set in the layout order
+        std::vector<UniqueIdentifier> ObjectIds;
+
+        bool operator == (const DescriptorSetCacheKey &rhs)const;
+        size_t GetHash()const;
+
+        void Reset(UniqueIdentifier _PSOId)
+        {
+            PSOId = _PSOId;
+            ObjectIds.clear();
+            Hash = 0;
+        }
+
+    private:
+        mutable size_t Hash = 0;
+    };
+
+    /// Returns the key object that should be used for lookups. The object is reused 
+    /// to avoid memory allocations when the same resources are committed again
+    DescriptorSetCacheKey& GetLookupKey(UniqueIdentifier PSOId)
+    {
+        m_LookupKey.Reset(PSOId);
+        return m_LookupKey;
+    }
+
+    /// Returns the descriptor set that was written for the key, or VK_NULL_HANDLE if there is none
+    VkDescriptorSet Find(const DescriptorSetCacheKey& Key)const;
+
+    /// Adds new descriptor set to the cache. The set must have been completely written
+    /// and must never be updated afterwards as it may be in use by the GPU.
+    /// If the cache is full, all previously cached sets are released first.
+    VkDescriptorSet Add(const DescriptorSetCacheKey& Key, DescriptorPoolAllocation&& Allocation);
+
+    /// Releases all descriptor sets to the parent descriptor pool.
+    void Reset();
+
+    size_t GetSize()const{return m_Cache.size();}
+
+private:
+    struct DescriptorSetCacheKeyHash
+    {
+        std::size_t operator() (const DescriptorSetCacheKey& Key)const
+        {
+            return Key.GetHash();
+        }
+    };
+
+    DescriptorSetCacheKey m_LookupKey;
+    std::unordered_map<DescriptorSetCacheKey, DescriptorPoolAllocation, DescriptorSetCacheKeyHash> m_Cache;
+};
+
+}
@@ -82,6 +82,14 @@ public:
         return m_LayoutMgr.GetDescriptorSet(SHADER_VARIABLE_TYPE_DYNAMIC).VkLayout;
     }
 
+    // Returns the template that writes all descriptors of the dynamic descriptor set from the data laid out 
+    // in resource cache order (see ShaderResourceCacheVk::DescriptorData), or VK_NULL_HANDLE if descriptor 
+    // update templates are not supported by the device
+    VkDescriptorUpdateTemplateKHR GetDynamicDescriptorUpdateTemplate()const
+    {
+        return m_LayoutMgr.GetDescriptorSet(SHADER_VARIABLE_TYPE_DYNAMIC).VkUpdateTemplate;
+    }
+
     struct DescriptorSetBindInfo
     {
         std::vector<VkDescriptorSet> vkSets;
@@ -149,11 +157,13 @@ private:
             uint16_t                                    NumLayoutBindings     = 0;
             VkDescriptorSetLayoutBinding*               pBindings             = nullptr;
             VulkanUtilities::DescriptorSetLayoutWrapper VkLayout;
+            VulkanUtilities::DescriptorUpdateTemplateWrapper VkUpdateTemplate;
             
             ~DescriptorSetLayout();
             void AddBinding(const VkDescriptorSetLayoutBinding& Binding, IMemoryAllocator& MemAllocator);
             void Finalize(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, IMemoryAllocator& MemAllocator, VkDescriptorSetLayoutBinding* pNewBindings);
             void Release(RenderDeviceVkImpl* pRenderDeviceVk, IMemoryAllocator& MemAllocator);
+            void CreateUpdateTemplate(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
 
             bool operator == (const DescriptorSetLayout& rhs)const;
             bool operator != (const DescriptorSetLayout& rhs)const{return !(*this == rhs);}
@@ -97,7 +97,13 @@ public:
                                                           Uint32                                                   SampleCount,
                                                           std::array<VkAttachmentDescription, MaxRenderTargets+1>& Attachments,
                                                           std::array<VkAttachmentReference,   MaxRenderTargets+1>& AttachmentReferences,
-                                                          VkSubpassDescription&                                    SubpassDesc);
+                                                          VkSubpassDescription&                                    SubpassDesc,
+                                                          const VkAttachmentLoadOp                                 RTVLoadOps[]   = nullptr,
+                                                          const VkAttachmentStoreOp                                RTVStoreOps[]  = nullptr,
+                                                          VkAttachmentLoadOp                                       DSVLoadOp      = VK_ATTACHMENT_LOAD_OP_LOAD,
+                                                          VkAttachmentStoreOp                                      DSVStoreOp     = VK_ATTACHMENT_STORE_OP_STORE,
+                                                          VkAttachmentLoadOp                                       StencilLoadOp  = VK_ATTACHMENT_LOAD_OP_LOAD,
+                                                          VkAttachmentStoreOp                                      StencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE);
 
 
 private:
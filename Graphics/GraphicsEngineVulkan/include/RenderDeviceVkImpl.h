@@ -26,6 +26,7 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <deque>
 
 #include "RenderDeviceVk.h"
 #include "RenderDeviceBase.h"
@@ -45,6 +46,7 @@
 #include "CommandPoolManager.h"
 #include "ResourceReleaseQueue.h"
 #include "VulkanDynamicHeap.h"
+#include "ResourceUploadBatcher.h"
 
 /// Namespace for the Direct3D11 implementation of the graphics engine
 namespace Diligent
@@ -60,6 +62,8 @@ public:
                         IMemoryAllocator&       RawMemAllocator, 
                         const EngineVkAttribs&  CreationAttribs, 
                         ICommandQueueVk*        pCmdQueue, 
+                        ICommandQueueVk*        pComputeQueue, 
+                        ICommandQueueVk*        pTransferQueue, 
                         std::shared_ptr<VulkanUtilities::VulkanInstance>        Instance,
                         std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice>  PhysicalDevice,
                         std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>   LogicalDevice,
@@ -88,6 +92,8 @@ public:
 
     virtual void CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, IBuffer** ppBuffer)override final;
 
+    virtual void GetPipelineCacheData(IDataBlob** ppData)override final;
+
     Uint64 GetCompletedFenceValue();
 	virtual Uint64 GetNextFenceValue() override final
     {
@@ -98,15 +104,41 @@ public:
     virtual Bool IsFenceSignaled(Uint64 FenceValue) override final;
 
     ICommandQueueVk *GetCmdQueue(){return m_pCommandQueue;}
+    // Returns the queue of the given type, or the graphics queue if the device has no such queue
+    ICommandQueueVk *GetCmdQueue(COMMAND_QUEUE_TYPE QueueType)
+    {
+        return HasDedicatedQueue(QueueType) ? m_pDedicatedQueues[QueueType].RawPtr() : m_pCommandQueue.RawPtr();
+    }
+    bool HasDedicatedQueue(COMMAND_QUEUE_TYPE QueueType)const
+    {
+        return QueueType != COMMAND_QUEUE_TYPE_GRAPHICS && static_cast<bool>(m_pDedicatedQueues[QueueType]);
+    }
+    // Indices of all queue families used by the device
+    const std::vector<uint32_t>& GetQueueFamilyIndices()const{return m_QueueFamilyIndices;}
+    // Writes unique indices of the queue families of the queues in CommandQueueFlags (see COMMAND_QUEUE_FLAGS) 
+    // to pFamilyIndices, which must have room for COMMAND_QUEUE_TYPE_NUM_TYPES elements, and returns the
+    // number of indices. Queues that the device has not created are replaced by the graphics queue.
+    Uint32 GetQueueFamilyIndices(Uint32 CommandQueueFlags, uint32_t* pFamilyIndices);
     
     // Idles GPU and returns fence value that was signaled
 	Uint64 IdleGPU(bool ReleaseStaleObjects);
     // pImmediateCtx parameter is only used to make sure the command buffer is submitted from the immediate context
     // The method returns fence value associated with the submitted command buffer
     Uint64 ExecuteCommandBuffer(const VkSubmitInfo &SubmitInfo, class DeviceContextVkImpl* pImmediateCtx, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence> > >* pSignalFences);
+    // Submits command buffer to the dedicated compute or transfer queue. Work on the dedicated queue 
+    // is associated with the graphics queue fence value returned by the method: the value is not 
+    // reported as completed until the command buffer is complete.
+    Uint64 ExecuteCommandBuffer(COMMAND_QUEUE_TYPE QueueType, const VkSubmitInfo &SubmitInfo, class DeviceContextVkImpl* pImmediateCtx);
 
     void AllocateTransientCmdPool(VulkanUtilities::CommandPoolWrapper& CmdPool, VkCommandBuffer& vkCmdBuff, const Char* DebugPoolName = nullptr);
     void ExecuteAndDisposeTransientCmdBuff(VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
+    // Returns command pool whose command buffer has been submitted with the given fence value
+    void DisposeTransientCmdPool(VulkanUtilities::CommandPoolWrapper&& CmdPool, Uint64 FenceValue);
+
+    // Initial data of buffers and textures is uploaded through the batcher
+    ResourceUploadBatcher& GetUploadBatcher(){return m_UploadBatcher;}
+    // Submits pending resource uploads for execution
+    void FlushUploadBatch();
 
     template<typename ObjectType>
     void SafeReleaseVkObject(ObjectType&& Object)
@@ -124,7 +156,9 @@ public:
 
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance()const{return m_VulkanInstance;}
     const VulkanUtilities::VulkanPhysicalDevice& GetPhysicalDevice(){return *m_PhysicalDevice;}
+    const EngineVkAttribs& GetEngineAttribs()const{return m_EngineAttribs;}
     const VulkanUtilities::VulkanLogicalDevice&  GetLogicalDevice() {return *m_LogicalVkDevice;}
+    VkPipelineCache   GetVkPipelineCache(){return m_PipelineCache;}
     FramebufferCache& GetFramebufferCache(){return m_FramebufferCache;}
     RenderPassCache&  GetRenderPassCache(){return m_RenderPassCache;}
 
@@ -149,9 +183,28 @@ private:
     std::shared_ptr<VulkanUtilities::VulkanInstance>        m_VulkanInstance;
     std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice>  m_PhysicalDevice;
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>   m_LogicalVkDevice;
+
+    // Pipeline cache used to create all pipelines. Pipeline caches are internally
+    // synchronized, so the cache can be used by multiple threads simultaneously.
+    VulkanUtilities::PipelineCacheWrapper m_PipelineCache;
     
     std::mutex                      m_CmdQueueMutex;
     RefCntAutoPtr<ICommandQueueVk>  m_pCommandQueue;
+    // Queues from dedicated compute and transfer families, indexed by queue type. 
+    // The graphics queue is m_pCommandQueue.
+    RefCntAutoPtr<ICommandQueueVk>  m_pDedicatedQueues[COMMAND_QUEUE_TYPE_NUM_TYPES];
+    std::vector<uint32_t>           m_QueueFamilyIndices;
+
+    // Command buffers submitted to the dedicated queues that may not have been completed yet,
+    // in the order of submission
+    struct DedicatedQueueSubmission
+    {
+        Uint64             FenceValue;      // Graphics queue fence value the submission is associated with
+        COMMAND_QUEUE_TYPE QueueType;
+        Uint64             QueueFenceValue; // Fence value of the dedicated queue
+    };
+    std::mutex                           m_DedicatedQueueSubmissionsMtx;
+    std::deque<DedicatedQueueSubmission> m_DedicatedQueueSubmissions;
 
     EngineVkAttribs m_EngineAttribs;
 
@@ -199,6 +252,8 @@ private:
     ResourceReleaseQueue<DynamicStaleResourceWrapper> m_ReleaseQueue;
 
     VulkanRingBuffer m_DynamicHeapRingBuffer;
+
+    ResourceUploadBatcher m_UploadBatcher;
 };
 
 }
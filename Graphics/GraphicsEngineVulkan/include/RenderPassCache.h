@@ -57,8 +57,18 @@ public:
         RenderPassCacheKey() : 
             NumRenderTargets(0),
             SampleCount     (0),
-            DSVFormat       (TEX_FORMAT_UNKNOWN)
-        {}
+            DSVFormat       (TEX_FORMAT_UNKNOWN),
+            DSVLoadOp       (VK_ATTACHMENT_LOAD_OP_LOAD),
+            StencilLoadOp   (VK_ATTACHMENT_LOAD_OP_LOAD),
+            DSVStoreOp      (VK_ATTACHMENT_STORE_OP_STORE),
+            StencilStoreOp  (VK_ATTACHMENT_STORE_OP_STORE)
+        {
+            for(Uint32 rt=0; rt < MaxRenderTargets; ++rt)
+            {
+                RTVLoadOps [rt] = VK_ATTACHMENT_LOAD_OP_LOAD;
+                RTVStoreOps[rt] = VK_ATTACHMENT_STORE_OP_STORE;
+            }
+        }
 
         RenderPassCacheKey(Uint32               _NumRenderTargets, 
                            Uint32               _SampleCount,
@@ -66,12 +76,20 @@ public:
                            TEXTURE_FORMAT       _DSVFormat) : 
             NumRenderTargets( static_cast<decltype(NumRenderTargets)>(_NumRenderTargets) ),
             SampleCount     ( static_cast<decltype(SampleCount)>     (_SampleCount) ),
-            DSVFormat       ( _DSVFormat )
+            DSVFormat       ( _DSVFormat ),
+            DSVLoadOp       (VK_ATTACHMENT_LOAD_OP_LOAD),
+            StencilLoadOp   (VK_ATTACHMENT_LOAD_OP_LOAD),
+            DSVStoreOp      (VK_ATTACHMENT_STORE_OP_STORE),
+            StencilStoreOp  (VK_ATTACHMENT_STORE_OP_STORE)
         {
             VERIFY_EXPR(_NumRenderTargets <= std::numeric_limits<decltype(NumRenderTargets)>::max());
             VERIFY_EXPR(_SampleCount <= std::numeric_limits<decltype(SampleCount)>::max());
             for(Uint32 rt=0; rt < NumRenderTargets; ++rt)
-                RTVFormats[rt] = _RTVFormats[rt];
+            {
+                RTVFormats [rt] = _RTVFormats[rt];
+                RTVLoadOps [rt] = VK_ATTACHMENT_LOAD_OP_LOAD;
+                RTVStoreOps[rt] = VK_ATTACHMENT_STORE_OP_STORE;
+            }
         }
         // Default memeber initialization is intentionally omitted
         Uint8           NumRenderTargets;
@@ -79,18 +97,33 @@ public:
         TEXTURE_FORMAT  DSVFormat;
         TEXTURE_FORMAT  RTVFormats[MaxRenderTargets];
 
+        // Render passes that only differ in load and store operations are compatible (7.2), 
+        // so the same framebuffers and pipelines can be used with all of them
+        VkAttachmentLoadOp  DSVLoadOp;
+        VkAttachmentLoadOp  StencilLoadOp;
+        VkAttachmentStoreOp DSVStoreOp;
+        VkAttachmentStoreOp StencilStoreOp;
+        VkAttachmentLoadOp  RTVLoadOps [MaxRenderTargets];
+        VkAttachmentStoreOp RTVStoreOps[MaxRenderTargets];
+
         bool operator == (const RenderPassCacheKey &rhs)const
         {
             if (GetHash()        != rhs.GetHash()        ||
                 NumRenderTargets != rhs.NumRenderTargets ||
                 SampleCount      != rhs.SampleCount      ||
-                DSVFormat        != rhs.DSVFormat)
+                DSVFormat        != rhs.DSVFormat        ||
+                DSVLoadOp        != rhs.DSVLoadOp        ||
+                StencilLoadOp    != rhs.StencilLoadOp    ||
+                DSVStoreOp       != rhs.DSVStoreOp       ||
+                StencilStoreOp   != rhs.StencilStoreOp)
             {
                 return false;
             }
 
             for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                if (RTVFormats[rt] != rhs.RTVFormats[rt])
+                if (RTVFormats [rt] != rhs.RTVFormats [rt] ||
+                    RTVLoadOps [rt] != rhs.RTVLoadOps [rt] ||
+                    RTVStoreOps[rt] != rhs.RTVStoreOps[rt])
                     return false;
 
             return true;
@@ -100,9 +133,9 @@ public:
         {
             if(Hash == 0)
             {
-                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat);
+                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat, DSVLoadOp, StencilLoadOp, DSVStoreOp, StencilStoreOp);
                 for(Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                    HashCombine(Hash, RTVFormats[rt]);
+                    HashCombine(Hash, RTVFormats[rt], RTVLoadOps[rt], RTVStoreOps[rt]);
             }
             return Hash;
         }
@@ -0,0 +1,166 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResourceUploadBatcher class
+
+#include <mutex>
+#include <condition_variable>
+#include "vulkan.h"
+#include "RingBuffer.h"
+#include "CommandQueueVk.h"
+#include "VulkanUtilities/VulkanObjectWrappers.h"
+#include "VulkanUtilities/VulkanMemoryManager.h"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Records initial data uploads of buffers and textures into a shared command buffer
+
+/// Staging space is suballocated from a persistently mapped ring buffer, and copy commands
+/// from all resources created since the last submission are recorded into a single command 
+/// buffer. The batch is submitted before any other command buffer is submitted to the queue, 
+/// or when the amount of staged data exceeds the batch size limit. Resources may be created 
+/// by multiple threads simultaneously: staging space is reserved under the batch lock, but the 
+/// data is written without holding it. The lock is only taken again to record commands into
+/// the shared command buffer. The batch is not submitted until all uploads that reserved space
+/// in it have recorded their commands.
+///
+///  Lock order: RenderDeviceVkImpl command queue mutex -> upload batch mutex
+class ResourceUploadBatcher
+{
+public:
+    ResourceUploadBatcher(IMemoryAllocator&   Allocator, 
+                          RenderDeviceVkImpl& DeviceVk, 
+                          Uint32              RingBufferSize,
+                          Uint32              MaxBatchSize);
+    ~ResourceUploadBatcher();
+
+    ResourceUploadBatcher            (const ResourceUploadBatcher&) = delete;
+    ResourceUploadBatcher            (ResourceUploadBatcher&&)      = delete;
+    ResourceUploadBatcher& operator= (const ResourceUploadBatcher&) = delete;
+    ResourceUploadBatcher& operator= (ResourceUploadBatcher&&)      = delete;
+
+    /// Single upload recorded into the current batch. While the object is alive, 
+    /// the batch cannot be submitted.
+    class Upload
+    {
+    public:
+        Upload(Upload&& rhs)noexcept;
+        Upload            (const Upload&) = delete;
+        Upload& operator= (const Upload&) = delete;
+        Upload& operator= (Upload&&)      = delete;
+        ~Upload();
+
+        // Staging buffer and the offset of the staging space reserved for this upload.
+        // The memory is host-coherent; host writes are made visible to the device when
+        // the batch is submitted. The data should be written before the command buffer 
+        // is locked so that other threads are not blocked by the copy.
+        VkBuffer        GetStagingBuffer()  const{return m_vkStagingBuffer;}
+        VkDeviceSize    GetStagingOffset()  const{return m_StagingOffset;}
+        Uint8*          GetStagingData()    const{return m_pStagingData;}
+
+        // Locks the batch and returns the command buffer to record upload commands to. The batch
+        // stays locked until the upload is destroyed. Commands MUST be recorded outside of a render pass.
+        VkCommandBuffer LockCmdBuffer();
+
+    private:
+        friend class ResourceUploadBatcher;
+        Upload(ResourceUploadBatcher& Batcher);
+
+        ResourceUploadBatcher*       m_pBatcher = nullptr;
+        std::unique_lock<std::mutex> m_Lock;
+        VkCommandBuffer              m_vkCmdBuff       = VK_NULL_HANDLE;
+        VkBuffer                     m_vkStagingBuffer = VK_NULL_HANDLE;
+        VkDeviceSize                 m_StagingOffset   = 0;
+        Uint8*                       m_pStagingData    = nullptr;
+
+        // Dedicated staging resources used when the data does not fit into the ring buffer
+        VulkanUtilities::BufferWrapper          m_DedicatedStagingBuffer;
+        VulkanUtilities::VulkanMemoryAllocation m_DedicatedStagingMemory;
+    };
+
+    /// Begins new upload that requires StagingDataSize bytes of staging space (may be zero)
+    Upload BeginUpload(size_t StagingDataSize, const char* DebugName);
+
+    /// Locks the batch. The device keeps the batch locked from the moment the pending batch is 
+    /// submitted until the command buffer number is incremented. This guarantees that the staging
+    /// buffers and resources referenced by the next batch are never released with the number of 
+    /// the command buffer that has already been submitted.
+    std::unique_lock<std::mutex> LockBatch()
+    {
+        return std::unique_lock<std::mutex>{m_BatchMtx};
+    }
+
+    /// Submits the pending batch to the command queue. The method MUST only be called 
+    /// by the device while the command queue is locked, which guarantees that the batch 
+    /// is executed before any command buffer submitted afterwards.
+    /// Returns the fence value associated with the batch, or 0 if there was nothing to submit.
+    /// If there are uploads that have reserved space in the batch, but have not recorded their 
+    /// commands yet, the method releases the batch lock and waits until they are done.
+    Uint64 SubmitPendingBatch(ICommandQueueVk& CmdQueue, std::unique_lock<std::mutex>& BatchLock);
+
+    /// Releases staging space used by the batches that have been completed by the GPU
+    void ReleaseCompletedBatches(Uint64 CompletedFenceValue);
+
+    void Destroy();
+
+private:
+    void EnsureCommandBuffer();
+    bool AllocateStagingSpace(size_t Size, Upload& NewUpload);
+    void AllocateDedicatedStagingBuffer(size_t Size, const char* DebugName, Upload& NewUpload);
+    void EndUpload(Upload& FinishedUpload);
+
+    RenderDeviceVkImpl& m_DeviceVk;
+
+    // Protects everything below
+    std::mutex  m_BatchMtx;
+    RingBuffer  m_RingBuffer;
+
+    VulkanUtilities::BufferWrapper       m_VkBuffer;
+    VulkanUtilities::DeviceMemoryWrapper m_BufferMemory;
+    Uint8*                               m_CPUAddress = nullptr;
+    const VkDeviceSize                   m_Alignment;
+
+    VulkanUtilities::CommandPoolWrapper  m_CmdPool;
+    VkCommandBuffer                      m_vkCmdBuff = VK_NULL_HANDLE;
+
+    // Number of uploads that reserved space in the current batch and are still alive
+    Uint32                  m_NumActiveUploads = 0;
+    std::condition_variable m_UploadsFinishedCV;
+
+    const size_t m_MaxBatchSize;
+    size_t       m_CurrBatchSize      = 0;
+    Uint32       m_CurrBatchUploads   = 0;
+
+    // Statistics
+    Uint64       m_TotalUploads       = 0;
+    Uint64       m_TotalBatches       = 0;
+    Uint64       m_DedicatedStagingBuffers = 0;
+};
+
+}
@@ -51,6 +51,7 @@
 
 #include "DescriptorPoolManager.h"
 #include "SPIRVShaderResources.h"
+#include "UniqueIdentifier.h"
 
 namespace Diligent
 {
@@ -106,6 +107,19 @@ public:
         VkDescriptorImageInfo  GetImageDescriptorWriteInfo  (bool IsImmutableSampler)const;
         VkBufferView           GetBufferViewWriteInfo       ()                       const;
         VkDescriptorImageInfo  GetSamplerDescriptorWriteInfo()                       const;
+
+        // Appends unique identifiers of all objects whose Vulkan handles are written to the descriptor
+        void GetDescriptorObjectIds(std::vector<UniqueIdentifier>& Ids)const;
+    };
+
+    // Raw descriptor data consumed by descriptor update templates. Descriptor data for the resource 
+    // at offset CacheOffset in the descriptor set is stored at the same offset in the array, 
+    // so the data is laid out exactly like the cached resources
+    union DescriptorData
+    {
+        VkDescriptorImageInfo  ImageInfo;
+        VkDescriptorBufferInfo BufferInfo;
+        VkBufferView           TexelBufferView;
     };
 
     // sizeof(DescriptorSet) == 40 (x64, msvc, Release)
@@ -234,6 +234,15 @@ public:
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet)const;
 
+    // Writes descriptor data of all dynamic resources to the array laid out in descriptor set cache order. 
+    // The array is then used to update the dynamic descriptor set with the descriptor update template
+    void GetDynamicDescriptorData(const ShaderResourceCacheVk&           ResourceCache,
+                                  ShaderResourceCacheVk::DescriptorData* pDescriptorData)const;
+
+    // Appends unique identifiers of the objects that CommitDynamicResources() writes to the descriptor set
+    void GetDynamicResourceObjectIds(const ShaderResourceCacheVk&   ResourceCache,
+                                     std::vector<UniqueIdentifier>& Ids)const;
+
     const Char* GetShaderName()const;
 
     const VkResource& GetResource(SHADER_VARIABLE_TYPE VarType, Uint32 r)const
@@ -24,8 +24,9 @@
 #pragma once
 
 #include <mutex>
-#include "Vulkan.h"
-#include "RingBuffer.h"
+#include <atomic>
+#include "vulkan.h"
+#include "ConcurrentRingBuffer.h"
 #include "VulkanUtilities/VulkanLogicalDevice.h"
 #include "VulkanUtilities/VulkanObjectWrappers.h"
 
@@ -33,7 +34,8 @@ namespace Diligent
 {
 
 // Vulkand dynamic heap implementation consists of a single ring buffer and a number of dynamic heaps,
-// one per context. Every dynamic heap suballocates chunk of memory from the global ring buffer. Within
+// one per context. Every dynamic heap suballocates chunk of memory from the global ring buffer. Chunks
+// are allocated from the ring buffer without locking, and only frame retirement is serialized. Within
 // every chunk, memory is allocated in simple lock-free linear fashion:
 //   
 //  | <----------------------frame 0---------------------------->|<-----------------frame 1-------------->
@@ -118,19 +120,20 @@ private:
     friend class VulkanDynamicHeap;
 
     static constexpr const Uint32 MinAlignment = 1024;
-    RingBuffer::OffsetType Allocate(size_t SizeInBytes);
+    ConcurrentRingBuffer::OffsetType Allocate(size_t SizeInBytes);
 
-    std::mutex          m_RingBuffMtx;
-    RingBuffer          m_RingBuffer;
-    RenderDeviceVkImpl& m_DeviceVk;
+    // Serializes frame retirement. Allocations from the ring buffer do not take the lock
+    std::mutex           m_FramesMtx;
+    ConcurrentRingBuffer m_RingBuffer;
+    RenderDeviceVkImpl&  m_DeviceVk;
 
     VulkanUtilities::BufferWrapper       m_VkBuffer;
     VulkanUtilities::DeviceMemoryWrapper m_BufferMemory;
     Uint8*                               m_CPUAddress;
     const VkDeviceSize                   m_DefaultAlignment;
-    RingBuffer::OffsetType               m_TotalPeakSize    = 0;
-    RingBuffer::OffsetType               m_CurrentFrameSize = 0;
-    RingBuffer::OffsetType               m_FramePeakSize    = 0;
+    std::atomic<ConcurrentRingBuffer::OffsetType> m_TotalPeakSize   {0};
+    std::atomic<ConcurrentRingBuffer::OffsetType> m_CurrentFrameSize{0};
+    std::atomic<ConcurrentRingBuffer::OffsetType> m_FramePeakSize   {0};
 };
 
 
@@ -154,7 +157,7 @@ public:
 
     void Reset()
     {
-        m_CurrOffset = RingBuffer::InvalidOffset;
+        m_CurrOffset = ConcurrentRingBuffer::InvalidOffset;
         m_AvailableSize     = 0;
 
         m_CurrAllocatedSize = 0;
@@ -165,7 +168,8 @@ private:
     VulkanRingBuffer& m_ParentRingBuffer;
     const std::string m_HeapName;
 
-    RingBuffer::OffsetType m_CurrOffset = RingBuffer::InvalidOffset;
+    // Current chunk suballocated from the parent ring buffer
+    ConcurrentRingBuffer::OffsetType m_CurrOffset = ConcurrentRingBuffer::InvalidOffset;
     const Uint32 m_PagSize;
     Uint32 m_AvailableSize     = 0;
 
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <vector>
 #include "vulkan.h"
 #include "DebugUtilities.h"
 
@@ -31,7 +32,11 @@ namespace VulkanUtilities
     class VulkanCommandBuffer
     {
     public:
-        VulkanCommandBuffer()noexcept{}
+        // Stages that are not supported by the queue the command buffer is submitted to are
+        // removed from the barriers along with the corresponding access flags
+        explicit VulkanCommandBuffer(VkPipelineStageFlags SupportedStages = AllPipelineStages)noexcept :
+            m_SupportedStages(SupportedStages)
+        {}
         VulkanCommandBuffer             (const VulkanCommandBuffer&) = delete;
         VulkanCommandBuffer             (VulkanCommandBuffer&&)      = delete;
         VulkanCommandBuffer& operator = (const VulkanCommandBuffer&) = delete;
@@ -43,6 +48,7 @@ namespace VulkanUtilities
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
             VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
+            FlushBarriers();
             vkCmdClearColorImage(
                 m_VkCmdBuffer,
                 Image,
@@ -61,6 +67,7 @@ namespace VulkanUtilities
                     (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT|VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
                    "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_DEPTH_BIT or VK_IMAGE_ASPECT_STENCIL_BIT(17.1)");
 
+            FlushBarriers();
             vkCmdClearDepthStencilImage(
                 m_VkCmdBuffer,
                 Image,
@@ -130,6 +137,7 @@ namespace VulkanUtilities
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
             VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
+            FlushBarriers();
             vkCmdDispatch(m_VkCmdBuffer, GroupCountX, GroupCountY, GroupCountZ);
         }
 
@@ -139,14 +147,23 @@ namespace VulkanUtilities
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
             VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
+            FlushBarriers();
             vkCmdDispatchIndirect(m_VkCmdBuffer, Buffer, Offset);
         }
 
-        void BeginRenderPass(VkRenderPass RenderPass, VkFramebuffer Framebuffer, uint32_t FramebufferWidth, uint32_t FramebufferHeight)
+        void BeginRenderPass(VkRenderPass        RenderPass,
+                             VkFramebuffer       Framebuffer,
+                             uint32_t            FramebufferWidth,
+                             uint32_t            FramebufferHeight,
+                             uint32_t            ClearValueCount = 0,
+                             const VkClearValue* pClearValues    = nullptr)
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
             VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
 
+            // Barriers cannot be recorded inside a render pass, so all pending barriers must be
+            // flushed before it begins. Draw commands therefore never need to flush barriers.
+            FlushBarriers();
             if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
             {
                 VkRenderPassBeginInfo BeginInfo;
@@ -156,8 +173,8 @@ namespace VulkanUtilities
                 BeginInfo.framebuffer = Framebuffer;
                 // The render area MUST be contained within the framebuffer dimensions (7.4)
                 BeginInfo.renderArea = {{0,0}, { FramebufferWidth, FramebufferHeight }};
-                BeginInfo.clearValueCount = 0;
-                BeginInfo.pClearValues = nullptr; // an array of VkClearValue structures that contains clear values for 
+                BeginInfo.clearValueCount = ClearValueCount;
+                BeginInfo.pClearValues = pClearValues; // an array of VkClearValue structures that contains clear values for 
                                                   // each attachment, if the attachment uses a loadOp value of VK_ATTACHMENT_LOAD_OP_CLEAR 
                                                   // or if the attachment has a depth/stencil format and uses a stencilLoadOp value of 
                                                   // VK_ATTACHMENT_LOAD_OP_CLEAR. The array is indexed by attachment number. Only elements 
@@ -190,11 +207,13 @@ namespace VulkanUtilities
         void EndCommandBuffer()
         {
             VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            FlushBarriers();
             vkEndCommandBuffer(m_VkCmdBuffer);
         }
 
         void Reset()
         {
+            VERIFY(m_ImageBarriers.empty() && m_BufferBarriers.empty(), "Resetting command buffer with pending barriers");
             m_VkCmdBuffer = VK_NULL_HANDLE;
             m_State = StateCache{};
         }
@@ -265,54 +284,41 @@ namespace VulkanUtilities
             vkCmdBindVertexBuffers(m_VkCmdBuffer, firstBinding, bindingCount, pBuffers, pOffsets);
         }
 
+        static constexpr VkPipelineStageFlags AllPipelineStages = VK_PIPELINE_STAGE_FLAG_BITS_MAX_ENUM;
+
         static void TransitionImageLayout(VkCommandBuffer                CmdBuffer,
                                           VkImage                        Image, 
                                           VkImageLayout                  OldLayout,
                                           VkImageLayout                  NewLayout,
                                           const VkImageSubresourceRange& SubresRange, 
-                                          VkPipelineStageFlags           SrcStages  = 0, 
-                                          VkPipelineStageFlags           DestStages = 0);
+                                          VkPipelineStageFlags           SrcStages       = 0, 
+                                          VkPipelineStageFlags           DestStages      = 0,
+                                          VkPipelineStageFlags           SupportedStages = AllPipelineStages);
 
+        // The barrier is not recorded immediately, but is added to the list of pending barriers that
+        // are recorded by a single vkCmdPipelineBarrier() call before the next command that needs them
         void TransitionImageLayout(VkImage                        Image, 
                                    VkImageLayout                  OldLayout,
                                    VkImageLayout                  NewLayout,
                                    const VkImageSubresourceRange& SubresRange,
                                    VkPipelineStageFlags           SrcStages  = 0, 
-                                   VkPipelineStageFlags           DestStages = 0)
-        {
-            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-            if (m_State.RenderPass  != VK_NULL_HANDLE)
-            {
-                // Image layout transitions within a render pass execute
-                // dependencies between attachments
-                EndRenderPass();
-            }
-            TransitionImageLayout(m_VkCmdBuffer, Image, OldLayout, NewLayout, SubresRange, SrcStages, DestStages);
-        }
+                                   VkPipelineStageFlags           DestStages = 0);
 
 
         static void BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                         VkBuffer             Buffer, 
                                         VkAccessFlags        srcAccessMask,
                                         VkAccessFlags        dstAccessMask,
-                                        VkPipelineStageFlags SrcStages  = 0,
-                                        VkPipelineStageFlags DestStages = 0);
+                                        VkPipelineStageFlags SrcStages       = 0,
+                                        VkPipelineStageFlags DestStages      = 0,
+                                        VkPipelineStageFlags SupportedStages = AllPipelineStages);
 
+        // Same as TransitionImageLayout(), the barrier is added to the list of pending barriers
         void BufferMemoryBarrier(VkBuffer             Buffer, 
                                  VkAccessFlags        srcAccessMask,
                                  VkAccessFlags        dstAccessMask,
                                  VkPipelineStageFlags SrcStages  = 0,
-                                 VkPipelineStageFlags DestStages = 0)
-        {
-            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-            if (m_State.RenderPass  != VK_NULL_HANDLE)
-            {
-                // Image layout transitions within a render pass execute
-                // dependencies between attachments
-                EndRenderPass();
-            }
-            BufferMemoryBarrier(m_VkCmdBuffer, Buffer, srcAccessMask, dstAccessMask, SrcStages, DestStages);
-        }
+                                 VkPipelineStageFlags DestStages = 0);
 
         void BindDescriptorSets(VkPipelineBindPoint     pipelineBindPoint,
                                 VkPipelineLayout        layout,
@@ -337,6 +343,7 @@ namespace VulkanUtilities
                 // Copy buffer operation must be performed outside of render pass.
                 EndRenderPass();
             }
+            FlushBarriers();
             vkCmdCopyBuffer(m_VkCmdBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
         }
                                           
@@ -354,13 +361,33 @@ namespace VulkanUtilities
                 EndRenderPass();
             }
 
+            FlushBarriers();
             vkCmdCopyImage(m_VkCmdBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount, pRegions);
         }
 
+        void CopyBufferToImage(VkBuffer                 srcBuffer,
+                               VkImage                  dstImage,
+                               VkImageLayout            dstImageLayout,
+                               uint32_t                 regionCount,
+                               const VkBufferImageCopy* pRegions)
+        {
+            VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+            if (m_State.RenderPass  != VK_NULL_HANDLE)
+            {
+                // Copy operations must be performed outside of render pass.
+                EndRenderPass();
+            }
+
+            FlushBarriers();
+            vkCmdCopyBufferToImage(m_VkCmdBuffer, srcBuffer, dstImage, dstImageLayout, regionCount, pRegions);
+        }
+
+        // Records all pending barriers with a single vkCmdPipelineBarrier() call
         void FlushBarriers();
 
         void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer)
         {
+            VERIFY(m_ImageBarriers.empty() && m_BufferBarriers.empty(), "Replacing command buffer with pending barriers");
             m_VkCmdBuffer = VkCmdBuffer;
         }
         VkCommandBuffer GetVkCmdBuffer()const{return m_VkCmdBuffer;}
@@ -380,8 +407,20 @@ namespace VulkanUtilities
 
         const StateCache& GetState()const{return m_State;}
 
+        // Returns the number of vkCmdPipelineBarrier() calls recorded since the counter was last reset
+        uint32_t GetNumPipelineBarriers()const{return m_NumPipelineBarriers;}
+        void ResetNumPipelineBarriers(){m_NumPipelineBarriers = 0;}
+
     private:
         StateCache m_State;
         VkCommandBuffer m_VkCmdBuffer = VK_NULL_HANDLE;
+        const VkPipelineStageFlags m_SupportedStages;
+
+        // Pending barriers and the union of their stage masks
+        std::vector<VkImageMemoryBarrier>  m_ImageBarriers;
+        std::vector<VkBufferMemoryBarrier> m_BufferBarriers;
+        VkPipelineStageFlags m_PendingSrcStages  = 0;
+        VkPipelineStageFlags m_PendingDestStages = 0;
+        uint32_t m_NumPipelineBarriers = 0;
     };
 }
@@ -82,6 +82,8 @@ namespace VulkanUtilities
 	void SetSemaphoreName           (VkDevice device, VkSemaphore           semaphore,           const char * name);
 	void SetFenceName               (VkDevice device, VkFence               fence,               const char * name);
 	void SetEventName               (VkDevice device, VkEvent               _event,              const char * name);
+    void SetPipelineCacheName       (VkDevice device, VkPipelineCache       pipelineCache,       const char * name);
+    void SetDescriptorUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name);
 
     void SetVulkanObjectName(VkDevice device, VkCommandPool         cmdPool,             const char * name);
     void SetVulkanObjectName(VkDevice device, VkCommandBuffer       cmdBuffer,           const char * name);
@@ -103,6 +105,8 @@ namespace VulkanUtilities
     void SetVulkanObjectName(VkDevice device, VkSemaphore           semaphore,           const char * name);
     void SetVulkanObjectName(VkDevice device, VkFence               fence,               const char * name);
     void SetVulkanObjectName(VkDevice device, VkEvent               _event,              const char * name);
+    void SetVulkanObjectName(VkDevice device, VkPipelineCache       pipelineCache,       const char * name);
+    void SetVulkanObjectName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name);
 
     const char* VkResultToString       (VkResult         errorCode);
     const char* VkAccessFlagBitToString(VkAccessFlagBits Bit);
@@ -38,6 +38,7 @@ namespace VulkanUtilities
         VulkanInstance& operator = (VulkanInstance&&)      = delete;
 
         static std::shared_ptr<VulkanInstance> Create(bool                   EnableValidation, 
+                                                      bool                   EnableSurface,
                                                       uint32_t               GlobalExtensionCount, 
                                                       const char* const*     ppGlobalExtensionNames,
                                                       VkAllocationCallbacks* pVkAllocator);
@@ -61,6 +62,7 @@ namespace VulkanUtilities
 
     private:
         VulkanInstance(bool                   EnableValidation, 
+                       bool                   EnableSurface,
                        uint32_t               GlobalExtensionCount, 
                        const char* const*     ppGlobalExtensionNames,
                        VkAllocationCallbacks* pVkAllocator);
@@ -80,6 +80,8 @@ namespace VulkanUtilities
         DescriptorPoolWrapper CreateDescriptorPool(const VkDescriptorPoolCreateInfo &DescrPoolCI,   const char* DebugName = "")const;
         DescriptorSetLayoutWrapper CreateDescriptorSetLayout(const VkDescriptorSetLayoutCreateInfo &LayoutCI, const char* DebugName = "")const;
         SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo &SemaphoreCI, const char* DebugName = "")const;
+        PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo &PipelineCacheCI, const char* DebugName = "")const;
+        DescriptorUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfoKHR &TemplateCI, const char* DebugName = "")const;
         
         VkCommandBuffer     AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo &AllocInfo, const char* DebugName = "")const;
         VkDescriptorSet     AllocateVkDescriptorSet(const VkDescriptorSetAllocateInfo &AllocInfo, const char* DebugName = "")const;
@@ -100,6 +102,8 @@ namespace VulkanUtilities
         void ReleaseVulkanObject(DescriptorPoolWrapper&& DescriptorPool)const;
         void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout)const;
         void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore)const;
+        void ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache)const;
+        void ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate)const;
 
         void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set)const;
 
@@ -119,10 +123,23 @@ namespace VulkanUtilities
                                   const VkWriteDescriptorSet*   pDescriptorWrites,
                                   uint32_t                      descriptorCopyCount,
                                   const VkCopyDescriptorSet*    pDescriptorCopies)const;
+
+        // Descriptor update templates are only available when VK_KHR_descriptor_update_template
+        // extension was enabled when the device was created
+        bool IsDescriptorUpdateTemplateSupported()const
+        {
+            return m_vkUpdateDescriptorSetWithTemplate != nullptr;
+        }
+
+        void UpdateDescriptorSetWithTemplate(VkDescriptorSet               descriptorSet,
+                                             VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate,
+                                             const void*                   pData)const;
         
         VkResult ResetCommandPool(VkCommandPool             vkCmdPool,
                                   VkCommandPoolResetFlags   flags = 0)const;
 
+        VkResult GetPipelineCacheData(VkPipelineCache pipelineCache, size_t* pDataSize, void* pData)const;
+
     private:
         VulkanLogicalDevice(VkPhysicalDevice vkPhysicalDevice, 
                             const VkDeviceCreateInfo &DeviceCI, 
@@ -137,5 +154,9 @@ namespace VulkanUtilities
 
         VkDevice m_VkDevice = VK_NULL_HANDLE;
         const VkAllocationCallbacks* const m_VkAllocator; 
+
+        PFN_vkCreateDescriptorUpdateTemplateKHR  m_vkCreateDescriptorUpdateTemplate  = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR m_vkDestroyDescriptorUpdateTemplate = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR m_vkUpdateDescriptorSetWithTemplate = nullptr;
     };
 }
@@ -28,8 +28,11 @@
 #include <unordered_map>
 #include <atomic>
 #include <string>
+#include <memory>
 #include "MemoryAllocator.h"
+#include "STDAllocator.h"
 #include "VariableSizeAllocationsManager.h"
+#include "TLSFAllocationsManager.h"
 #include "VulkanUtilities/VulkanPhysicalDevice.h"
 #include "VulkanUtilities/VulkanLogicalDevice.h"
 #include "VulkanUtilities/VulkanObjectWrappers.h"
@@ -47,31 +50,31 @@ struct VulkanMemoryAllocation
     VulkanMemoryAllocation            (const VulkanMemoryAllocation&) = delete;
     VulkanMemoryAllocation& operator= (const VulkanMemoryAllocation&) = delete;
 
-	VulkanMemoryAllocation(VulkanMemoryPage* _Page, size_t _UnalignedOffset, size_t _Size)noexcept : 
-        Page           (_Page), 
-        UnalignedOffset(_UnalignedOffset), 
-        Size           (_Size)
+	VulkanMemoryAllocation(VulkanMemoryPage* _Page, size_t _Offset, size_t _Size)noexcept : 
+        Page  (_Page), 
+        Offset(_Offset), 
+        Size  (_Size)
     {}
     
     VulkanMemoryAllocation(VulkanMemoryAllocation&& rhs)noexcept :
-        Page           (rhs.Page), 
-        UnalignedOffset(rhs.UnalignedOffset),
-        Size           (rhs.Size)
+        Page  (rhs.Page), 
+        Offset(rhs.Offset),
+        Size  (rhs.Size)
     {
-        rhs.Page            = nullptr;
-        rhs.UnalignedOffset = 0;
-        rhs.Size            = 0;
+        rhs.Page   = nullptr;
+        rhs.Offset = 0;
+        rhs.Size   = 0;
     }
 
     VulkanMemoryAllocation& operator= (VulkanMemoryAllocation&& rhs)noexcept
     {
-        Page            = rhs.Page;
-        UnalignedOffset = rhs.UnalignedOffset;
-        Size            = rhs.Size;
+        Page   = rhs.Page;
+        Offset = rhs.Offset;
+        Size   = rhs.Size;
 
-        rhs.Page            = nullptr;
-        rhs.UnalignedOffset = 0;
-        rhs.Size            = 0;
+        rhs.Page   = nullptr;
+        rhs.Offset = 0;
+        rhs.Size   = 0;
 
         return *this;
     }
@@ -80,9 +83,9 @@ struct VulkanMemoryAllocation
     // The allocation must not be in use by the GPU.
     ~VulkanMemoryAllocation();
     
-    VulkanMemoryPage* Page             = nullptr;	// Memory page that contains this allocation
-	size_t            UnalignedOffset  = 0;         // Unaligned offset from the start of the memory
-	size_t            Size             = 0;	        // Reserved size of this allocation
+    VulkanMemoryPage* Page   = nullptr; // Memory page that contains this allocation
+    size_t            Offset = 0;       // Aligned offset from the start of the memory
+    size_t            Size   = 0;       // Reserved size of this allocation
 };
 
 class VulkanMemoryPage
@@ -97,6 +100,7 @@ public:
     VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
         m_ParentMemoryMgr (rhs.m_ParentMemoryMgr),
         m_AllocationMgr   (std::move(rhs.m_AllocationMgr)),
+        m_TLSFAllocationMgr(std::move(rhs.m_TLSFAllocationMgr)),
         m_VkMemory        (std::move(rhs.m_VkMemory)),
         m_CPUMemory       (rhs.m_CPUMemory)
     {
@@ -107,12 +111,12 @@ public:
     VulkanMemoryPage& operator= (VulkanMemoryPage&)       = delete;
     VulkanMemoryPage& operator= (VulkanMemoryPage&& rhs)  = delete;
 
-    bool IsEmpty()const{return m_AllocationMgr.IsEmpty();}
-    bool IsFull() const{return m_AllocationMgr.IsFull();}
-    VkDeviceSize GetPageSize()const{return m_AllocationMgr.GetMaxSize();}
-    VkDeviceSize GetUsedSize()const{return m_AllocationMgr.GetUsedSize();}
+    bool IsEmpty()const{return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->IsEmpty() : m_AllocationMgr->IsEmpty();}
+    bool IsFull() const{return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->IsFull()  : m_AllocationMgr->IsFull();}
+    VkDeviceSize GetPageSize()const{return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->GetMaxSize()  : m_AllocationMgr->GetMaxSize();}
+    VkDeviceSize GetUsedSize()const{return m_TLSFAllocationMgr ? m_TLSFAllocationMgr->GetUsedSize() : m_AllocationMgr->GetUsedSize();}
 
-    VulkanMemoryAllocation Allocate(VkDeviceSize size);
+    VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
     VkDeviceMemory GetVkMemory()const{return m_VkMemory;}
     void* GetCPUMemory()const{return m_CPUMemory;}
@@ -125,7 +129,10 @@ private:
 
     VulkanMemoryManager&                     m_ParentMemoryMgr;
     std::mutex                               m_Mutex;
-    Diligent::VariableSizeAllocationsManager m_AllocationMgr;
+    // Free space of the page is managed by one of the two managers, depending on the
+    // parent memory manager settings. Only that manager is created, the other one is null.
+    std::unique_ptr<Diligent::VariableSizeAllocationsManager, Diligent::STDDeleterRawMem<Diligent::VariableSizeAllocationsManager>> m_AllocationMgr;
+    std::unique_ptr<Diligent::TLSFAllocationsManager,         Diligent::STDDeleterRawMem<Diligent::TLSFAllocationsManager>>         m_TLSFAllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
 };
@@ -140,7 +147,8 @@ public:
                         VkDeviceSize                 DeviceLocalPageSize,
                         VkDeviceSize                 HostVisiblePageSize,
                         VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) : 
+                        VkDeviceSize                 HostVisibleReserveSize,
+                        bool                         UseTLSFAllocator = false) : 
         m_MgrName            (std::move(MgrName)),
         m_LogicalDevice      (LogicalDevice),
         m_PhysicalDevice     (PhysicalDevice),
@@ -148,7 +156,8 @@ public:
         m_DeviceLocalPageSize(DeviceLocalPageSize),
         m_HostVisiblePageSize(HostVisiblePageSize),
         m_DeviceLocalReserveSize(DeviceLocalReserveSize),
-        m_HostVisibleReserveSize(HostVisibleReserveSize)
+        m_HostVisibleReserveSize(HostVisibleReserveSize),
+        m_UseTLSFAllocator      (UseTLSFAllocator)
     {}
 
     // We have to write this constructor because on msvc default
@@ -165,6 +174,7 @@ public:
         m_HostVisiblePageSize    (rhs.m_HostVisiblePageSize),
         m_DeviceLocalReserveSize (rhs.m_DeviceLocalReserveSize),
         m_HostVisibleReserveSize (rhs.m_HostVisibleReserveSize),
+        m_UseTLSFAllocator       (rhs.m_UseTLSFAllocator),
     
         //m_CurrUsedSize      (rhs.m_CurrUsedSize),
         m_PeakUsedSize      (rhs.m_PeakUsedSize),
@@ -205,6 +215,8 @@ protected:
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
+    // Whether pages use two-level segregated fit allocations manager instead of the map-based one
+    const bool         m_UseTLSFAllocator;
     
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
 
@@ -40,6 +40,11 @@ namespace VulkanUtilities
         static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice vkDevice);
 
         uint32_t FindQueueFamily(VkQueueFlags QueueFlags)const;
+        // Returns the index of a queue family that supports QueueFlags, but none of ExcludedFlags,
+        // or InvalidQueueFamilyIndex if there is no such family
+        uint32_t FindDedicatedQueueFamily(VkQueueFlags QueueFlags, VkQueueFlags ExcludedFlags)const;
+        const VkQueueFamilyProperties& GetQueueFamilyProperties(uint32_t FamilyIndex)const{return m_QueueFamilyProperties[FamilyIndex];}
+        static constexpr uint32_t InvalidQueueFamilyIndex = static_cast<uint32_t>(-1);
         VkPhysicalDevice GetVkDeviceHandle()const{return m_VkDevice;}
         bool IsExtensionSupported(const char* ExtensionName)const;
         bool CheckPresentSupport(uint32_t queueFamilyIndex, VkSurfaceKHR VkSurface)const;
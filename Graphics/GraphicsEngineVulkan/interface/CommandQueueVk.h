@@ -41,7 +41,7 @@ class ICommandQueueVk : public Diligent::IObject
 {
 public:
 	/// Returns the fence value that will be signaled next time
-	virtual UINT64 GetNextFenceValue() = 0;
+	virtual Uint64 GetNextFenceValue() = 0;
 
 	/// Executes a given command buffer
 
@@ -51,6 +51,39 @@ public:
     /// \param [in] pBuffer - Buffer to transition
     /// \param [in] NewAccessFlags - Access flags to set for the buffer
     virtual void BufferMemoryBarrier(IBuffer *pBuffer, VkAccessFlags NewAccessFlags) = 0;
+
+    /// Makes the commands of the immediate context wait until all command lists previously
+    /// executed on the dedicated queue of the given type are complete
+
+    /// \param [in] QueueType - Type of the queue to wait for.
+    /// \remarks Command lists recorded by deferred contexts that target a dedicated compute or transfer 
+    ///          queue are submitted to that queue by ExecuteCommandList() and start after the work 
+    ///          previously submitted by the immediate context is complete. The graphics queue, however,
+    ///          does not wait for them, so that they can overlap subsequent graphics work. The application 
+    ///          must call this method before the immediate context uses the results of such command lists.
+    ///          The wait applies to the entire command buffer being recorded by the context, so commands
+    ///          recorded before the call only overlap the dedicated queue work if the context is flushed first.
+    ///          The method may only be called for the immediate context.
+    virtual void WaitForCommandQueue(COMMAND_QUEUE_TYPE QueueType) = 0;
+
+    /// Executes several command lists
+
+    /// \param [in] NumCommandLists - Number of command lists to execute.
+    /// \param [in] ppCommandLists - Pointer to the array of command lists.
+    /// \remarks The method is equivalent to calling ExecuteCommandList() for every command list in the 
+    ///          array, but the commands recorded by the immediate context and all command lists for the 
+    ///          graphics queue are submitted with a single vkQueueSubmit() call. Command lists for every
+    ///          dedicated queue are submitted to that queue with one more call.
+    ///          The method may only be called for the immediate context.
+    virtual void ExecuteCommandLists(Uint32 NumCommandLists, class ICommandList* const* ppCommandLists) = 0;
+
+    /// Returns the number of pipeline barrier commands recorded by the context during the last finished frame
+
+    /// \remarks Buffer and image barriers required by the context commands are accumulated and recorded by 
+    ///          a single vkCmdPipelineBarrier() call before the next command that depends on them, such as
+    ///          draw, dispatch, copy, clear or render pass begin. The counter is updated when the frame is
+    ///          finished by IRenderDeviceVk::FinishFrame() or ISwapChain::Present().
+    virtual Uint32 GetNumPipelineBarriersInLastFrame()const = 0;
 };
 
 }
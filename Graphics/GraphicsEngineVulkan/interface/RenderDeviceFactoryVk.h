@@ -36,6 +36,21 @@
 #   include "../../../Common/interface/StringTools.h"
 #endif
 
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+
+#   define API_QUALIFIER
+
+#elif PLATFORM_ANDROID || PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_IOS
+
+#   if ENGINE_DLL
+        // https://gcc.gnu.org/wiki/Visibility
+#       define API_QUALIFIER __attribute__((visibility("default")))
+#   else
+#       define API_QUALIFIER
+#   endif
+
+#endif
+
 namespace Diligent
 {
 
@@ -63,7 +78,7 @@ namespace Diligent
     };
 
 
-#if ENGINE_DLL
+#if ENGINE_DLL && (PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS)
 
     typedef IEngineFactoryVk* (*GetEngineFactoryVkType)();
 
@@ -115,6 +130,7 @@ namespace Diligent
     }
 #else
 
+    API_QUALIFIER
     IEngineFactoryVk* GetEngineFactoryVk();
 
 #endif
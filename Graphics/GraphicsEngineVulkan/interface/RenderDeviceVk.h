@@ -83,6 +83,15 @@ public:
     ///        destroy it once released. The application must not destroy Vulkan buffer while it is 
     ///        in use by the engine.
     virtual void CreateBufferFromVulkanResource(VkBuffer vkBuffer, const BufferDesc& BuffDesc, IBuffer** ppBuffer) = 0;
+
+    /// Returns the contents of the pipeline cache used to create all pipelines
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the
+    ///                       data blob will be stored. The function calls AddRef(),
+    ///                       so that the new object will contain one reference.
+    /// \note  The data can be saved to disk and provided through EngineVkAttribs::pPipelineCacheData
+    ///        the next time the device is initialized to reduce pipeline creation time.
+    virtual void GetPipelineCacheData(IDataBlob** ppData) = 0;
 };
 
 }
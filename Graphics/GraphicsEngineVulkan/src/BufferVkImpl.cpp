@@ -137,6 +137,17 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
         VkBuffCI.queueFamilyIndexCount = 0; // number of entries in the pQueueFamilyIndices array
         VkBuffCI.pQueueFamilyIndices = nullptr; // list of queue families that will access this buffer 
                                                 // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
+        // Initial data is uploaded by the graphics queue
+        uint32_t QueueFamilyIndices[COMMAND_QUEUE_TYPE_NUM_TYPES];
+        auto NumQueueFamilies = pRenderDeviceVk->GetQueueFamilyIndices(m_Desc.CommandQueueFlags | COMMAND_QUEUE_FLAG_GRAPHICS, QueueFamilyIndices);
+        if (NumQueueFamilies > 1)
+        {
+            // The engine does not transfer queue family ownership, so buffers 
+            // accessed by several queue families must be shared between them
+            VkBuffCI.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            VkBuffCI.queueFamilyIndexCount = NumQueueFamilies;
+            VkBuffCI.pQueueFamilyIndices = QueueFamilyIndices;
+        }
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
@@ -144,14 +155,22 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
 
         VkMemoryPropertyFlags BufferMemoryFlags = 0;
         if (m_Desc.Usage == USAGE_CPU_ACCESSIBLE)
-            BufferMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        {
+            // Host-visible pages are persistently mapped by the memory manager. Cached memory only 
+            // benefits buffers that are read by the CPU and is not available on every device
+            BufferMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            if (m_Desc.CPUAccessFlags == CPU_ACCESS_READ)
+                BufferMemoryFlags |= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        }
         else
             BufferMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
         m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, BufferMemoryFlags);
+        if (m_MemoryAllocation.Page == nullptr)
+            LOG_ERROR_AND_THROW("Failed to allocate memory for buffer '", m_Desc.Name, '\'');
 
-        VERIFY( (MemReqs.alignment & (MemReqs.alignment-1)) == 0, "Alignment is not power of 2!");
-        auto AlignedOffset = (m_MemoryAllocation.UnalignedOffset + (MemReqs.alignment-1)) & ~(MemReqs.alignment-1);
+        auto AlignedOffset = m_MemoryAllocation.Offset;
+        VERIFY_EXPR(AlignedOffset % MemReqs.alignment == 0);
         auto Memory = m_MemoryAllocation.Page->GetVkMemory();
         auto err = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, AlignedOffset);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
@@ -159,76 +178,23 @@ BufferVkImpl :: BufferVkImpl(IReferenceCounters*        pRefCounters,
         bool bInitializeBuffer = (BuffData.pData != nullptr && BuffData.DataSize > 0);
         if( bInitializeBuffer )
         {
-            VkBufferCreateInfo VkStaginBuffCI = VkBuffCI;
-            VkStaginBuffCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-            std::string StagingBufferName = "Staging buffer for '";
-            StagingBufferName += m_Desc.Name;
-            StagingBufferName += '\'';
-            VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
-
-            VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-
-            // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges 
-            // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-            // to the host (10.2)
-            auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-            auto StagingBufferMemory = StagingMemoryAllocation.Page->GetVkMemory();
-            auto AlignedStagingMemOffset = (StagingMemoryAllocation.UnalignedOffset + (StagingBufferMemReqs.alignment-1)) & ~(StagingBufferMemReqs.alignment-1);
-
-            auto *StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-            if (StagingData == nullptr)
-                LOG_BUFFER_ERROR_AND_THROW("Failed to allocate staging data");
-            memcpy(StagingData + AlignedStagingMemOffset, BuffData.pData, BuffData.DataSize);
-            
-            err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
-
-            VulkanUtilities::CommandPoolWrapper CmdPool;
-            VkCommandBuffer vkCmdBuff;
-            pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
-            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT);
+            // The copy is recorded into the shared upload batch that is submitted before the next
+            // command buffer, so that creating many resources does not require as many submits
+            VERIFY(BuffData.DataSize <= VkBuffCI.size, "Initial data size exceeds the buffer size");
+            auto Upload = pRenderDeviceVk->GetUploadBatcher().BeginUpload(BuffData.DataSize, m_Desc.Name);
+            memcpy(Upload.GetStagingData(), BuffData.pData, BuffData.DataSize);
+            auto vkCmdBuff = Upload.LockCmdBuffer();
+
             m_AccessFlags = VK_ACCESS_TRANSFER_WRITE_BIT;
             VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, m_AccessFlags);
 
             // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-            // as copy will be the only command in the cmd buffer
+            // as the upload batch never contains render passes
             VkBufferCopy BuffCopy = {};
-            BuffCopy.srcOffset = 0;
+            BuffCopy.srcOffset = Upload.GetStagingOffset();
             BuffCopy.dstOffset = 0;
-            BuffCopy.size = VkBuffCI.size;
-            vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
-
-	        pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(vkCmdBuff, std::move(CmdPool));
-
-
-            // After command buffer is submitted, safe-release staging resources. This strategy
-            // is little overconservative as the resources will only be released after the 
-            // first command buffer submitted through the immediate context is complete
-
-            // Next Cmd Buff| Next Fence |               This Thread                      |           Immediate Context
-            //              |            |                                                |
-            //      N       |     F      |                                                |
-            //              |            |                                                |
-            //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
-            //              |            |  - SubmittedCmdBuffNumber = N                  |
-            //              |            |  - SubmittedFenceValue = F                     |
-            //     N+1 -  - | -  F+1  -  |                                                |  
-            //              |            |  Release(StagingBuffer)                        |
-            //              |            |  - {N+1, StagingBuffer} -> Stale Objects       |
-            //              |            |                                                |
-            //              |            |                                                |
-            //              |            |                                                | ExecuteCommandBuffer()                                      
-            //              |            |                                                | - SubmittedCmdBuffNumber = N+1
-            //              |            |                                                | - SubmittedFenceValue = F+1
-            //     N+2 -  - | -  F+2  -  |  -   -   -   -   -   -   -   -   -   -   -   - | 
-            //              |            |                                                | - DiscardStaleVkObjects(N+1, F+1)  
-            //              |            |                                                |   - {F+1, StagingBuffer} -> Release Queue 
-            //              |            |                                                | 
-
-            pRenderDeviceVk->SafeReleaseVkObject(std::move(StagingBuffer));
-            pRenderDeviceVk->SafeReleaseVkObject(std::move(StagingMemoryAllocation));
+            BuffCopy.size = BuffData.DataSize;
+            vkCmdCopyBuffer(vkCmdBuff, Upload.GetStagingBuffer(), m_VulkanBuffer, 1, &BuffCopy);
         }
         else
         {
@@ -310,16 +276,13 @@ void BufferVkImpl :: Map(IDeviceContext* pContext, MAP_TYPE MapType, Uint32 MapF
     {
         if (m_Desc.Usage == USAGE_CPU_ACCESSIBLE)
         {
-            LOG_ERROR("Not implemented");
-            UNSUPPORTED("Not implemented");
-#if 0
-            VERIFY(m_pVkResource != nullptr, "USAGE_CPU_ACCESSIBLE buffer mapped for writing must intialize Vk resource");
-            if (MapFlags & MAP_FLAG_DISCARD)
-            {
-                
-            }
-            m_pVkResource->Map(0, nullptr, &pMappedData);
-#endif
+            // Staging memory is host-coherent and stays mapped for the lifetime of the buffer.
+            // It is the application's responsibility to not overwrite the data that is still 
+            // in use by the GPU
+            VERIFY(m_MemoryAllocation.Page != nullptr, "USAGE_CPU_ACCESSIBLE buffer mapped for writing must have memory allocation");
+            auto* CPUAddress = reinterpret_cast<Uint8*>(m_MemoryAllocation.Page->GetCPUMemory());
+            VERIFY(CPUAddress != nullptr, "Staging buffer memory is expected to be host-visible");
+            pMappedData = CPUAddress + m_MemoryAllocation.Offset;
         }
         else if (m_Desc.Usage == USAGE_DYNAMIC)
         {
@@ -406,12 +369,8 @@ void BufferVkImpl::Unmap( IDeviceContext* pContext, MAP_TYPE MapType, Uint32 Map
     {
         if (m_Desc.Usage == USAGE_CPU_ACCESSIBLE)
         {
-            LOG_ERROR("This map type is not yet supported");
-            UNSUPPORTED("This map type is not yet supported");
-#if 0
-            VERIFY(m_pVkResource != nullptr, "USAGE_CPU_ACCESSIBLE buffer mapped for writing must intialize Vk resource");
-            m_pVkResource->Unmap(0, nullptr);
-#endif
+            // Host writes to coherent memory do not need to be flushed and are made visible 
+            // to the device when the command buffer is submitted
         }
         else if (m_Desc.Usage == USAGE_DYNAMIC)
         {
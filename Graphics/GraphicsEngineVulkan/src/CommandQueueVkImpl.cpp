@@ -63,7 +63,7 @@ Uint64 CommandQueueVkImpl::ExecuteCommandBuffer(const VkSubmitInfo& SubmitInfo)
     VERIFY(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
 
     // We must atomically place the (value, fence) pair into the deque
-    auto FenceValue = m_NextFenceValue;
+    Uint64 FenceValue = m_NextFenceValue;
     m_pFence->AddPendingFence(std::move(vkFence), FenceValue);
 
     // Increment the value
@@ -58,21 +58,42 @@ namespace Diligent
             return "Dynamic heap of immediate context";
     }
 
+    // Pipeline stages supported by the queues of the given type (6.1.2)
+    static VkPipelineStageFlags GetSupportedPipelineStages(COMMAND_QUEUE_TYPE QueueType)
+    {
+        static constexpr VkPipelineStageFlags TransferStages = 
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT    |
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_HOST_BIT           |
+            VK_PIPELINE_STAGE_TRANSFER_BIT       |
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+        switch (QueueType)
+        {
+            case COMMAND_QUEUE_TYPE_COMPUTE:  return TransferStages | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+            case COMMAND_QUEUE_TYPE_TRANSFER: return TransferStages;
+            default:                          return VulkanUtilities::VulkanCommandBuffer::AllPipelineStages;
+        }
+    }
+
     DeviceContextVkImpl::DeviceContextVkImpl( IReferenceCounters*                   pRefCounters, 
                                               RenderDeviceVkImpl*                   pDeviceVkImpl, 
                                               bool                                  bIsDeferred, 
                                               const EngineVkAttribs&                Attribs, 
                                               Uint32                                ContextId,
+                                              COMMAND_QUEUE_TYPE                    QueueType,
                                               std::shared_ptr<GenerateMipsVkHelper> GenerateMipsHelper) :
         TDeviceContextBase{pRefCounters, pDeviceVkImpl, bIsDeferred},
+        m_CommandBuffer{GetSupportedPipelineStages(QueueType)},
         m_NumCommandsToFlush{bIsDeferred ? std::numeric_limits<decltype(m_NumCommandsToFlush)>::max() : Attribs.NumCommandsToFlushCmdBuffer},
         m_CmdListAllocator{ GetRawAllocator(), sizeof(CommandListVkImpl), 64 },
         m_ContextId{ContextId},
+        m_QueueType{QueueType},
         // Command pools for deferred contexts must be thread safe because finished command buffers are executed and released from another thread
         m_CmdPool
         {
             pDeviceVkImpl->GetLogicalDevice().GetSharedPtr(),
-            pDeviceVkImpl->GetCmdQueue()->GetQueueFamilyIndex(),
+            pDeviceVkImpl->GetCmdQueue(QueueType)->GetQueueFamilyIndex(),
             VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, 
             bIsDeferred
         },
@@ -115,6 +136,7 @@ namespace Diligent
         },
         m_GenerateMipsHelper(std::move(GenerateMipsHelper))
     {
+        VERIFY(m_QueueType == COMMAND_QUEUE_TYPE_GRAPHICS || bIsDeferred, "Immediate context must use the graphics queue");
         m_GenerateMipsHelper->CreateSRB(&m_GenerateMipsSRB);
     }
 
@@ -127,6 +149,9 @@ namespace Diligent
                                 "There are outstanding commands in the immediate context being destroyed, which indicates the context has not been Flush()'ed.",
                               " This is unexpected and may result in synchronization errors");
 
+        // Return cached dynamic descriptor sets to the pool so that they are discarded by Flush()
+        m_DynamicDescrSetCache.Reset();
+
         if (!m_bIsDeferred)
         {
             // There should be no outstanding commands, but we need to call Flush to discard all stale
@@ -134,6 +159,13 @@ namespace Diligent
             Flush();
         }
 
+        // Semaphores signaled by the dedicated queues that have never been waited for
+        for (auto& Semaphore : m_QueueSemaphores)
+        {
+            if (Semaphore != VK_NULL_HANDLE)
+                pDeviceVkImpl->SafeReleaseVkObject(std::move(Semaphore));
+        }
+
         // We must now wait for GPU to finish so that we can safely destroy all context resources.
         // We need to idle when destroying deferred contexts as well since some resources may still be in use.
         pDeviceVkImpl->IdleGPU(true);
@@ -156,7 +188,7 @@ namespace Diligent
 
     IMPLEMENT_QUERY_INTERFACE( DeviceContextVkImpl, IID_DeviceContextVk, TDeviceContextBase )
     
-    inline void DeviceContextVkImpl::EnsureVkCmdBuffer()
+    void DeviceContextVkImpl::EnsureVkCmdBuffer()
     {
         // Make sure that the number of commands in the context is at least one,
         // so that the context cannot be disposed by Flush()
@@ -236,7 +268,8 @@ namespace Diligent
             {
                 m_CommandBuffer.SetStencilReference(m_StencilRef);
                 m_CommandBuffer.SetBlendConstants(m_BlendFactors);
-                CommitRenderPassAndFramebuffer();
+                // Render pass is not committed here, so that clears issued after the pipeline 
+                // state is set can still be performed by the render pass. Draw commands commit it.
                 CommitViewports();
             }
 
@@ -285,7 +318,7 @@ namespace Diligent
 
     void DeviceContextVkImpl::TransitionVkVertexBuffers()
     {
-        for ( UINT Buff = 0; Buff < m_NumVertexStreams; ++Buff )
+        for ( Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff )
         {
             auto& CurrStream = m_VertexStreams[Buff];
             VERIFY( CurrStream.pBuffer, "Attempting to bind a null buffer for rendering" );
@@ -306,7 +339,7 @@ namespace Diligent
         VkDeviceSize Offsets[MaxBufferSlots];
         VERIFY( m_NumVertexStreams <= MaxBufferSlots, "Too many buffers are being set" );
         bool DynamicBufferPresent = false;
-        for ( UINT slot = 0; slot < m_NumVertexStreams; ++slot )
+        for ( Uint32 slot = 0; slot < m_NumVertexStreams; ++slot )
         {
             auto& CurrStream = m_VertexStreams[slot];
             VERIFY( CurrStream.pBuffer, "Attempting to bind a null buffer for rendering" );
@@ -390,6 +423,11 @@ namespace Diligent
             LOG_ERROR("No graphics pipeline state is bound");
             return;
         }
+        if (m_QueueType != COMMAND_QUEUE_TYPE_GRAPHICS)
+        {
+            LOG_ERROR("Draw commands can only be recorded by contexts that use the graphics queue");
+            return;
+        }
 #endif
 
         EnsureVkCmdBuffer();
@@ -496,10 +534,19 @@ namespace Diligent
             LOG_ERROR("No compute pipeline state is bound");
             return;
         }
+        if (m_QueueType == COMMAND_QUEUE_TYPE_TRANSFER)
+        {
+            LOG_ERROR("Dispatch commands cannot be recorded by contexts that use the transfer queue");
+            return;
+        }
 #endif
 
         EnsureVkCmdBuffer();
 
+        // Compute shader may access render targets through unordered access views,
+        // so deferred clears must be performed first
+        FlushDeferredClears();
+
         // Dispatch commands must be executed outside of render pass
         if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
             m_CommandBuffer.EndRenderPass();
@@ -544,6 +591,7 @@ namespace Diligent
 
     void DeviceContextVkImpl::ClearDepthStencil( ITextureView* pView, Uint32 ClearFlags, float fDepth, Uint8 Stencil )
     {
+        VERIFY(m_QueueType == COMMAND_QUEUE_TYPE_GRAPHICS, "Depth-stencil clears can only be recorded by contexts that use the graphics queue");
         ITextureViewVk* pVkDSV = nullptr;
         if ( pView != nullptr )
         {
@@ -575,9 +623,26 @@ namespace Diligent
         const auto& ViewDesc = pVkDSV->GetDesc();
         VERIFY(ViewDesc.TextureDim != RESOURCE_DIM_TEX_3D, "Depth-stencil view of a 3D texture should've been created as 2D texture array view");
 
-        if (pVkDSV == m_pBoundDepthStencil)
+        if (pVkDSV == m_pBoundDepthStencil && m_CommandBuffer.GetState().Framebuffer != m_Framebuffer)
         {
-            // Render pass may not be currently committed
+            // Render pass has not been begun yet. Defer the clear and perform it with 
+            // VK_ATTACHMENT_LOAD_OP_CLEAR when the render pass is committed. 
+            // Depth-stencil buffer is always attachment 0
+            VERIFY_EXPR(m_RenderPass != VK_NULL_HANDLE && m_Framebuffer != VK_NULL_HANDLE);
+            if (ClearFlags & CLEAR_DEPTH_FLAG)
+            {
+                m_DeferredClears.ClearDepth = true;
+                m_DeferredClears.ClearValues[0].depthStencil.depth = fDepth;
+            }
+            if (ClearFlags & CLEAR_STENCIL_FLAG)
+            {
+                m_DeferredClears.ClearStencil = true;
+                m_DeferredClears.ClearValues[0].depthStencil.stencil = Stencil;
+            }
+        }
+        else if (pVkDSV == m_pBoundDepthStencil)
+        {
+            // Render pass is currently committed
             VERIFY_EXPR(m_RenderPass != VK_NULL_HANDLE && m_Framebuffer != VK_NULL_HANDLE);
             CommitRenderPassAndFramebuffer();
 
@@ -655,6 +720,7 @@ namespace Diligent
 
     void DeviceContextVkImpl::ClearRenderTarget( ITextureView *pView, const float *RGBA )
     {
+        VERIFY(m_QueueType == COMMAND_QUEUE_TYPE_GRAPHICS, "Render target clears can only be recorded by contexts that use the graphics queue");
         ITextureViewVk* pVkRTV = nullptr;
         if ( pView != nullptr )
         {
@@ -702,9 +768,19 @@ namespace Diligent
             }
         }
         
-        if (attachmentIndex != InvalidAttachmentIndex)
+        if (attachmentIndex != InvalidAttachmentIndex && m_CommandBuffer.GetState().Framebuffer != m_Framebuffer)
         {
-            // Render pass may not be currently committed
+            // Render pass has not been begun yet. Defer the clear and perform it with 
+            // VK_ATTACHMENT_LOAD_OP_CLEAR when the render pass is committed.
+            // Clear values are indexed by the render pass attachment number (7.4)
+            VERIFY_EXPR(m_RenderPass != VK_NULL_HANDLE && m_Framebuffer != VK_NULL_HANDLE);
+            m_DeferredClears.RTMask |= 1 << attachmentIndex;
+            auto ClearValueInd = attachmentIndex + (m_pBoundDepthStencil ? 1 : 0);
+            m_DeferredClears.ClearValues[ClearValueInd].color = ClearValueToVkClearValue(RGBA, ViewDesc.Format);
+        }
+        else if (attachmentIndex != InvalidAttachmentIndex)
+        {
+            // Render pass is currently committed
             VERIFY_EXPR(m_RenderPass != VK_NULL_HANDLE && m_Framebuffer != VK_NULL_HANDLE);
             CommitRenderPassAndFramebuffer();
 
@@ -756,10 +832,15 @@ namespace Diligent
 
     void DeviceContextVkImpl::FinishFrame(Uint64 CompletedFenceValue)
     {
+        // Descriptor sets go back to the pool and will be discarded when the next command buffer is submitted
+        m_DynamicDescrSetCache.Reset();
         m_ReleaseQueue.Purge(CompletedFenceValue);
         m_UploadHeap.ShrinkMemory();
         m_DynamicDescriptorPool.ReleaseStaleAllocations(CompletedFenceValue);
         m_DynamicHeap.Reset();
+
+        m_NumPipelineBarriersInLastFrame = m_CommandBuffer.GetNumPipelineBarriers();
+        m_CommandBuffer.ResetNumPipelineBarriers();
     }
 
     void DeviceContextVkImpl::ReleaseStaleContextResources(Uint64 SubmittedCmdBufferNumber, Uint64 SubmittedFenceValue, Uint64 CompletedFenceValue)
@@ -781,6 +862,14 @@ namespace Diligent
         }
 #endif
 
+        Flush(0, nullptr);
+    }
+
+    Uint64 DeviceContextVkImpl::Flush(Uint32 NumCommandBuffers, const VkCommandBuffer* pCommandBuffers)
+    {
+        VERIFY(!m_bIsDeferred, "Only immediate contexts can be flushed");
+
+        m_SubmitCmdBuffers.clear();
         VkSubmitInfo SubmitInfo = {};
         SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         SubmitInfo.pNext = nullptr;
@@ -792,6 +881,8 @@ namespace Diligent
             VERIFY(!m_bIsDeferred, "Deferred contexts cannot execute command lists directly");
             if (m_State.NumCommands != 0)
             {
+                FlushDeferredClears();
+
                 if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
                 {
                     m_CommandBuffer.EndRenderPass();
@@ -800,11 +891,15 @@ namespace Diligent
                 m_CommandBuffer.FlushBarriers();
                 m_CommandBuffer.EndCommandBuffer();
                 
-                SubmitInfo.commandBufferCount = 1;
-                SubmitInfo.pCommandBuffers = &vkCmdBuff;
+                m_SubmitCmdBuffers.push_back(vkCmdBuff);
             }
         }
 
+        // Command buffers from the command lists are executed after the commands recorded by this context
+        m_SubmitCmdBuffers.insert(m_SubmitCmdBuffers.end(), pCommandBuffers, pCommandBuffers + NumCommandBuffers);
+        SubmitInfo.commandBufferCount = static_cast<uint32_t>(m_SubmitCmdBuffers.size());
+        SubmitInfo.pCommandBuffers = SubmitInfo.commandBufferCount != 0 ? m_SubmitCmdBuffers.data() : nullptr;
+
         SubmitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_WaitSemaphores.size());
         VERIFY_EXPR(m_WaitSemaphores.size() == m_WaitDstStageMasks.size());
         SubmitInfo.pWaitSemaphores = SubmitInfo.waitSemaphoreCount != 0 ? m_WaitSemaphores.data() : nullptr;
@@ -820,14 +915,21 @@ namespace Diligent
         m_WaitDstStageMasks.clear();
         m_SignalSemaphores.clear();
         m_PendingFences.clear();
+        for (auto& Semaphore : m_SemaphoresToRelease)
+            pDeviceVkImpl->SafeReleaseVkObject(std::move(Semaphore));
+        m_SemaphoresToRelease.clear();
 
         if (vkCmdBuff != VK_NULL_HANDLE)
         {
             DisposeCurrentCmdBuffer(SubmittedFenceValue);
         }
 
+        // Cached descriptor sets are disposed with the fence value of this submission, so
+        // that the cache does not grow without bound when the app never calls FinishFrame()
+        m_DynamicDescrSetCache.Reset();
+
         // Release temporary resources that were used by this context while recording the last command buffer
-        auto SubmittedCmdBuffNumber = m_NextCmdBuffNumber;
+        Int64 SubmittedCmdBuffNumber = m_NextCmdBuffNumber;
         Atomics::AtomicIncrement(m_NextCmdBuffNumber);
         auto CompletedFenceValue = pDeviceVkImpl->GetCompletedFenceValue();
         ReleaseStaleContextResources(SubmittedCmdBuffNumber, SubmittedFenceValue, CompletedFenceValue);
@@ -836,6 +938,8 @@ namespace Diligent
         m_DescrSetBindInfo.Reset();
         m_CommandBuffer.Reset();
         m_pPipelineState = nullptr;
+
+        return SubmittedFenceValue;
     }
 
     void DeviceContextVkImpl::SetVertexBuffers( Uint32 StartSlot, Uint32 NumBuffersSet, IBuffer **ppBuffers, Uint32 *pOffsets, Uint32 Flags )
@@ -853,6 +957,7 @@ namespace Diligent
         m_State = ContextState{};
         m_RenderPass = VK_NULL_HANDLE;
         m_Framebuffer = VK_NULL_HANDLE;
+        m_DeferredClears = DeferredClearsInfo{};
         m_DescrSetBindInfo.Reset();
         VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unifinished render pass");
         m_CommandBuffer.Reset();
@@ -965,6 +1070,11 @@ namespace Diligent
             if (m_Framebuffer != VK_NULL_HANDLE)
             {
                 VERIFY_EXPR(m_RenderPass != VK_NULL_HANDLE);
+
+                // Reset deferred clears before transitioning the attachments as TransitionImageLayout() flushes them
+                auto DeferredClears = m_DeferredClears;
+                m_DeferredClears = DeferredClearsInfo{};
+
                 if (m_pBoundDepthStencil)
                 {
                     auto* pDSVVk = m_pBoundDepthStencil.RawPtr<TextureViewVkImpl>();
@@ -981,13 +1091,80 @@ namespace Diligent
                         TransitionImageLayout(pRenderTarget, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
                     }
                 }
-                m_CommandBuffer.BeginRenderPass(m_RenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight);
+
+                if (DeferredClears.IsEmpty())
+                {
+                    m_CommandBuffer.BeginRenderPass(m_RenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight);
+                }
+                else
+                {
+                    // Render passes that only differ in load operations are compatible (7.2), so the framebuffer
+                    // created for m_RenderPass as well as all pipelines can be used with the clearing render pass.
+                    // Construct new key rather than copy m_RenderPassKey as the latter caches its hash
+                    RenderPassCache::RenderPassCacheKey ClearPassKey(m_RenderPassKey.NumRenderTargets, m_RenderPassKey.SampleCount,
+                                                                     m_RenderPassKey.RTVFormats, m_RenderPassKey.DSVFormat);
+                    Uint32 ClearValueCount = 0;
+                    if (DeferredClears.ClearDepth)
+                    {
+                        ClearPassKey.DSVLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+                        ClearValueCount = 1;
+                    }
+                    if (DeferredClears.ClearStencil)
+                    {
+                        ClearPassKey.StencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+                        ClearValueCount = 1;
+                    }
+                    Uint32 FirstRTAttachment = m_RenderPassKey.DSVFormat != TEX_FORMAT_UNKNOWN ? 1 : 0;
+                    for (Uint32 rt=0; rt < m_RenderPassKey.NumRenderTargets; ++rt)
+                    {
+                        if (DeferredClears.RTMask & (1 << rt))
+                        {
+                            ClearPassKey.RTVLoadOps[rt] = VK_ATTACHMENT_LOAD_OP_CLEAR;
+                            ClearValueCount = FirstRTAttachment + rt + 1;
+                        }
+                    }
+
+                    auto& RPCache = m_pDevice.RawPtr<RenderDeviceVkImpl>()->GetRenderPassCache();
+                    auto ClearRenderPass = RPCache.GetRenderPass(ClearPassKey);
+                    m_CommandBuffer.BeginRenderPass(ClearRenderPass, m_Framebuffer, m_FramebufferWidth, m_FramebufferHeight, 
+                                                    ClearValueCount, DeferredClears.ClearValues);
+                }
             }
         }
     }
 
+    void DeviceContextVkImpl::FlushDeferredClears()
+    {
+        if (!m_DeferredClears.IsEmpty())
+        {
+            // Begin the render pass that performs the clears
+            CommitRenderPassAndFramebuffer();
+            VERIFY_EXPR(m_DeferredClears.IsEmpty());
+        }
+    }
+
+    void DeviceContextVkImpl::FlushDeferredClears(const TextureVkImpl& TextureVk)
+    {
+        if (m_DeferredClears.IsEmpty())
+            return;
+
+        // Only flush the clears if the texture is one of the attachments
+        bool IsAttachment = m_pBoundDepthStencil && m_pBoundDepthStencil->GetTexture() == &TextureVk;
+        for (Uint32 rt=0; rt < m_NumBoundRenderTargets && !IsAttachment; ++rt)
+        {
+            if (ITextureView* pRTV = m_pBoundRenderTargets[rt])
+                IsAttachment = pRTV->GetTexture() == &TextureVk;
+        }
+
+        if (IsAttachment)
+            CommitRenderPassAndFramebuffer();
+    }
+
     void DeviceContextVkImpl::SetRenderTargets( Uint32 NumRenderTargets, ITextureView *ppRenderTargets[], ITextureView *pDepthStencil )
     {
+        // Clears of the currently bound render targets must be performed before they are unbound
+        FlushDeferredClears();
+
         if ( TDeviceContextBase::SetRenderTargets( NumRenderTargets, ppRenderTargets, pDepthStencil ) )
         {
             FramebufferCache::FramebufferCacheKey FBKey;
@@ -1034,6 +1211,7 @@ namespace Diligent
             auto& RPCache = pDeviceVkImpl->GetRenderPassCache();
 
             m_RenderPass = RPCache.GetRenderPass(RenderPassKey);
+            m_RenderPassKey = RenderPassKey;
             FBKey.Pass = m_RenderPass;
             m_Framebuffer = FBCache.GetFramebuffer(FBKey, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
 
@@ -1041,12 +1219,13 @@ namespace Diligent
             SetViewports(1, nullptr, 0, 0);
         }
 
-        EnsureVkCmdBuffer();
-        CommitRenderPassAndFramebuffer();
+        // Render pass is committed by the first draw command, so that clears issued before 
+        // it can be performed by the render pass through VK_ATTACHMENT_LOAD_OP_CLEAR
     }
 
     void DeviceContextVkImpl::ResetRenderTargets()
     {
+        FlushDeferredClears();
         TDeviceContextBase::ResetRenderTargets();
         m_RenderPass  = VK_NULL_HANDLE;
         m_Framebuffer = VK_NULL_HANDLE;
@@ -1088,8 +1267,8 @@ namespace Diligent
         VERIFY_EXPR( static_cast<size_t>(NumBytes) == NumBytes );
         auto TmpSpace = m_UploadHeap.Allocate(static_cast<size_t>(NumBytes));
         auto CPUAddress = TmpSpace.MemAllocation.Page->GetCPUMemory();
-	    memcpy(reinterpret_cast<Uint8*>(CPUAddress) + TmpSpace.MemAllocation.UnalignedOffset, pData, static_cast<size_t>(NumBytes));
-        UpdateBufferRegion(pBuffVk, DstOffset, NumBytes, TmpSpace.vkBuffer, TmpSpace.MemAllocation.UnalignedOffset);
+	    memcpy(reinterpret_cast<Uint8*>(CPUAddress) + TmpSpace.MemAllocation.Offset, pData, static_cast<size_t>(NumBytes));
+        UpdateBufferRegion(pBuffVk, DstOffset, NumBytes, TmpSpace.vkBuffer, TmpSpace.MemAllocation.Offset);
         // The allocation will stay in the queue until the command buffer from this context is submitted
         // to the queue. We cannot use the device's release queue as other contexts may interfer with
         // the release order
@@ -1124,6 +1303,9 @@ namespace Diligent
     void DeviceContextVkImpl::CopyTextureRegion(TextureVkImpl *pSrcTexture, TextureVkImpl *pDstTexture, const VkImageCopy &CopyRegion)
     {
         EnsureVkCmdBuffer();
+        // Layouts are checked below, so deferred clears must be flushed first
+        FlushDeferredClears(*pSrcTexture);
+        FlushDeferredClears(*pDstTexture);
         if (pSrcTexture->GetLayout() != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
         {
             TransitionImageLayout(*pSrcTexture, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
@@ -1138,76 +1320,73 @@ namespace Diligent
         ++m_State.NumCommands;
     }
 
-#if 0
-    void DeviceContextVkImpl::CopyTextureRegion(IBuffer *pSrcBuffer, Uint32 SrcStride, Uint32 SrcDepthStride, class TextureVkImpl *pTextureVk, Uint32 DstSubResIndex, const Box &DstBox)
+    void DeviceContextVkImpl::CopyTextureRegion(BufferVkImpl *pSrcBuffer, Uint32 SrcStride, Uint32 SrcDepthStride, TextureVkImpl *pTextureVk, Uint32 MipLevel, Uint32 Slice, const Box &DstBox)
     {
-        auto *pBufferVk = ValidatedCast<BufferVkImpl>(pSrcBuffer);
         const auto& TexDesc = pTextureVk->GetDesc();
-        VERIFY(pBufferVk->GetState() == Vk_RESOURCE_STATE_GENERIC_READ, "Staging buffer is expected to always be in Vk_RESOURCE_STATE_GENERIC_READ state");
-
-        auto *pCmdCtx = RequestCmdContext();
-        auto *pCmdList = pCmdCtx->GetCommandList();
-        auto TextureState = pTextureVk->GetState();
-        Vk_RESOURCE_BARRIER BarrierDesc;
-		BarrierDesc.Type = Vk_RESOURCE_BARRIER_TYPE_TRANSITION;
-		BarrierDesc.Transition.pResource = pTextureVk->GetVkResource();
-		BarrierDesc.Transition.Subresource = DstSubResIndex;
-		BarrierDesc.Transition.StateBefore = TextureState;
-		BarrierDesc.Transition.StateAfter = Vk_RESOURCE_STATE_COPY_DEST;
-        BarrierDesc.Flags = Vk_RESOURCE_BARRIER_FLAG_NONE;
-        bool StateTransitionRequired = (TextureState & Vk_RESOURCE_STATE_COPY_DEST) != Vk_RESOURCE_STATE_COPY_DEST;
-	    if (StateTransitionRequired)
-            pCmdList->ResourceBarrier(1, &BarrierDesc);
-
-        Vk_TEXTURE_COPY_LOCATION DstLocation;
-        DstLocation.Type = Vk_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-        DstLocation.pResource = pTextureVk->GetVkResource();
-        DstLocation.SubresourceIndex = static_cast<UINT>(DstSubResIndex);
-
-        Vk_TEXTURE_COPY_LOCATION SrcLocation;
-        SrcLocation.Type = Vk_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-        SrcLocation.pResource = pBufferVk->GetVkResource();
-        Vk_PLACED_SUBRESOURCE_FOOTPRINT &Footpring = SrcLocation.PlacedFootprint;
-        Footpring.Offset = 0;
-        Footpring.Footprint.Width = static_cast<UINT>(DstBox.MaxX - DstBox.MinX);
-        Footpring.Footprint.Height = static_cast<UINT>(DstBox.MaxY - DstBox.MinY);
-        Footpring.Footprint.Depth = static_cast<UINT>(DstBox.MaxZ - DstBox.MinZ); // Depth cannot be 0
-        Footpring.Footprint.Format = TexFormatToDXGI_Format(TexDesc.Format);
-
-        Footpring.Footprint.RowPitch = static_cast<UINT>(SrcStride);
-        VERIFY(Footpring.Footprint.RowPitch * Footpring.Footprint.Height * Footpring.Footprint.Depth <= pBufferVk->GetDesc().uiSizeInBytes, "Buffer is not large enough");
-        VERIFY(SrcDepthStride == 0 || static_cast<UINT>(SrcDepthStride) == Footpring.Footprint.RowPitch * Footpring.Footprint.Height, "Depth stride must be equal to the size 2D level");
-
-        Vk_BOX VkSrcBox;
-        VkSrcBox.left    = 0;
-        VkSrcBox.right   = Footpring.Footprint.Width;
-        VkSrcBox.top     = 0;
-        VkSrcBox.bottom  = Footpring.Footprint.Height;
-        VkSrcBox.front   = 0;
-        VkSrcBox.back    = Footpring.Footprint.Depth;
-        pCmdCtx->GetCommandList()->CopyTextureRegion( &DstLocation, 
-            static_cast<UINT>( DstBox.MinX ), 
-            static_cast<UINT>( DstBox.MinY ), 
-            static_cast<UINT>( DstBox.MinZ ),
-            &SrcLocation, &VkSrcBox);
+        const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+        VERIFY(FmtAttribs.ComponentType != COMPONENT_TYPE_DEPTH_STENCIL, "Only single aspect bit must be specified when copying texture data");
+        VERIFY(pSrcBuffer->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers cannot be used as copy sources for textures");
 
-        ++m_State.NumCommands;
+        EnsureVkCmdBuffer();
+        // Layout is checked below, so deferred clears must be flushed first
+        FlushDeferredClears(*pTextureVk);
+        if (!pSrcBuffer->CheckAccessFlags(VK_ACCESS_TRANSFER_READ_BIT))
+        {
+            BufferMemoryBarrier(*pSrcBuffer, VK_ACCESS_TRANSFER_READ_BIT);
+        }
+        if (pTextureVk->GetLayout() != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+        {
+            TransitionImageLayout(*pTextureVk, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        }
 
-        if (StateTransitionRequired)
+        // bufferRowLength and bufferImageHeight are specified in texels rather than in bytes.
+        // For block-compression formats, they must be multiples of the block size (18.4)
+        // For block-compression formats, this is the size of the compressed block
+        auto TexelSize = GetTexelBlockSize(FmtAttribs);
+        Uint32 BlockWidth  = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? FmtAttribs.BlockWidth  : 1;
+        Uint32 BlockHeight = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? FmtAttribs.BlockHeight : 1;
+        VERIFY(SrcStride % TexelSize == 0, "Source stride must be a multiple of the texel size");
+        VERIFY(SrcDepthStride % SrcStride == 0, "Source depth stride must be a multiple of the stride");
+
+        VkBufferImageCopy CopyRegion;
+        CopyRegion.bufferOffset      = 0;
+        CopyRegion.bufferRowLength   = SrcStride / TexelSize * BlockWidth;
+        CopyRegion.bufferImageHeight = SrcDepthStride / SrcStride * BlockHeight; // Zero means tightly packed
+        CopyRegion.imageSubresource.aspectMask = FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+        CopyRegion.imageSubresource.mipLevel = MipLevel;
+        CopyRegion.imageSubresource.baseArrayLayer = Slice;
+        CopyRegion.imageSubresource.layerCount = 1;
+        CopyRegion.imageOffset = VkOffset3D{static_cast<int32_t>(DstBox.MinX), static_cast<int32_t>(DstBox.MinY), static_cast<int32_t>(DstBox.MinZ)};
+        // For block-compression formats, the extent is still specified in texels (18.4.1)
+        CopyRegion.imageExtent = VkExtent3D{DstBox.MaxX - DstBox.MinX, DstBox.MaxY - DstBox.MinY, std::max(DstBox.MaxZ - DstBox.MinZ, 1u)};
+#ifdef _DEBUG
         {
-            std::swap(BarrierDesc.Transition.StateBefore, BarrierDesc.Transition.StateAfter);
-            pCmdList->ResourceBarrier(1, &BarrierDesc);
+            auto RowsInBlocks = (CopyRegion.imageExtent.height + BlockHeight - 1) / BlockHeight;
+            auto RequiredSize = SrcStride * (RowsInBlocks - 1) + (CopyRegion.imageExtent.width + BlockWidth - 1) / BlockWidth * TexelSize;
+            if (CopyRegion.imageExtent.depth > 1)
+                RequiredSize += SrcDepthStride * (CopyRegion.imageExtent.depth - 1);
+            VERIFY(RequiredSize <= pSrcBuffer->GetDesc().uiSizeInBytes, "Source buffer is not large enough");
         }
-    }
 #endif
 
+        // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+        m_CommandBuffer.CopyBufferToImage(pSrcBuffer->GetVkBuffer(), pTextureVk->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &CopyRegion);
+        ++m_State.NumCommands;
+    }
+
     void DeviceContextVkImpl::FinishCommandList(class ICommandList **ppCommandList)
     {
+        FlushDeferredClears();
+
+        // Descriptor sets written by this command list will be discarded when it is executed
+        m_DynamicDescrSetCache.Reset();
+
         if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
         {
             m_CommandBuffer.EndRenderPass();
         }
 
+        m_CommandBuffer.FlushBarriers();
         auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
         auto err = vkEndCommandBuffer(vkCmdBuff);
         VERIFY(err == VK_SUCCESS, "Failed to end command buffer");
@@ -1231,6 +1410,11 @@ namespace Diligent
     }
 
     void DeviceContextVkImpl::ExecuteCommandList(class ICommandList *pCommandList)
+    {
+        ExecuteCommandLists(1, &pCommandList);
+    }
+
+    void DeviceContextVkImpl::ExecuteCommandLists(Uint32 NumCommandLists, class ICommandList* const* ppCommandLists)
     {
         if (m_bIsDeferred)
         {
@@ -1238,7 +1422,10 @@ namespace Diligent
             return;
         }
 
-        // First execute commands in this context
+        // Commands recorded by this context are submitted first, followed by the command lists.
+        // All command buffers for the graphics queue are submitted with a single vkQueueSubmit() call, 
+        // and the queue fence is signaled once. Command lists for every dedicated queue are 
+        // submitted to that queue with one more call.
         
         // Note that not discarding resources when flushing the context does not help in case of multiple 
         // deferred contexts, and resources must not be released until the command list is executed via 
@@ -1251,39 +1438,106 @@ namespace Diligent
         //              |            | Release(ResourceX)             | Draw(ResourceY)                |
         //              |            | - {N, ResourceX} -> Stale Objs | Release(ResourceY)             |
         //              |            |                                | - {N, ResourceY} -> Stale Objs |
-        //              |            |                                |                                |  ExecuteCmdList(CmdList1)
+        //              |            |                                |                                |  ExecuteCmdLists(CmdList1, CmdList2)
         //              |            |                                |                                |  {F, ResourceX}-> Release queue
         //              |            |                                |                                |  {F, ResourceY}-> Release queue
         //     N+1      |    F+1     |                                |                                |
-        //              |            |                                |                                |  ExecuteCmdList(CmdList2)
-        //              |            |                                |                                |  - ResourceY is in release queue
         //              |            |                                |                                |
-        Flush();
-        
-        InvalidateState();
+        if (NumCommandLists == 0)
+            return;
+        VERIFY_EXPR(ppCommandLists != nullptr);
+
+        struct ClosedCommandList
+        {
+            VkCommandBuffer               vkCmdBuff = VK_NULL_HANDLE;
+            RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+            Uint64                        DeferredCtxCmdBuffNumber = 0;
+        };
+        std::vector<ClosedCommandList> CmdLists[COMMAND_QUEUE_TYPE_NUM_TYPES];
+        for (Uint32 i = 0; i < NumCommandLists; ++i)
+        {
+            CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(ppCommandLists[i]);
+            ClosedCommandList CmdList;
+            pCmdListVk->Close(CmdList.vkCmdBuff, CmdList.pDeferredCtx, CmdList.DeferredCtxCmdBuffNumber);
+            VERIFY(CmdList.vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+            VERIFY_EXPR(CmdList.pDeferredCtx);
+            auto QueueType = CmdList.pDeferredCtx.RawPtr<DeviceContextVkImpl>()->GetQueueType();
+            CmdLists[QueueType].emplace_back(std::move(CmdList));
+        }
 
-        CommandListVkImpl* pCmdListVk = ValidatedCast<CommandListVkImpl>(pCommandList);
-        VkCommandBuffer vkCmdBuff = VK_NULL_HANDLE;
-        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
-        Uint64 DeferredCtxCmdBuffNumber = 0;
-        pCmdListVk->Close(vkCmdBuff, pDeferredCtx, DeferredCtxCmdBuffNumber);
-        VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
-        VERIFY_EXPR(pDeferredCtx);
-        VkSubmitInfo SubmitInfo = {};
-        SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        SubmitInfo.commandBufferCount = 1;
-        SubmitInfo.pCommandBuffers = &vkCmdBuff;
         auto pDeviceVkImpl = m_pDevice.RawPtr<RenderDeviceVkImpl>();
-        VERIFY_EXPR(m_PendingFences.empty());
-        auto SubmittedFenceValue = pDeviceVkImpl->ExecuteCommandBuffer(SubmitInfo, this, nullptr);
-
-        auto pDeferredCtxVkImpl = pDeferredCtx.RawPtr<DeviceContextVkImpl>();
-        // It is OK to dispose command buffer from another thread. We are not going to
-        // record any commands and only need to add the buffer to the queue
-        pDeferredCtxVkImpl->DisposeVkCmdBuffer(vkCmdBuff, SubmittedFenceValue);
-        // We can now release all temporary resources in the deferred context associated with the submitted command list
+        const auto& LogicalDevice = pDeviceVkImpl->GetLogicalDevice();
+        VkSemaphoreCreateInfo SemaphoreCI = {};
+        SemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        // Command lists for the dedicated queues may read the results of or overwrite resources used by 
+        // the work submitted to the graphics queue, so they wait until that work is complete.
+        // The graphics queue only waits for the dedicated queues in WaitForCommandQueue().
+        VulkanUtilities::SemaphoreWrapper GraphicsSemaphores[COMMAND_QUEUE_TYPE_NUM_TYPES];
+        for (Uint32 QueueType = COMMAND_QUEUE_TYPE_GRAPHICS + 1; QueueType < COMMAND_QUEUE_TYPE_NUM_TYPES; ++QueueType)
+        {
+            if (!CmdLists[QueueType].empty())
+            {
+                GraphicsSemaphores[QueueType] = LogicalDevice.CreateSemaphore(SemaphoreCI, "Graphics queue semaphore");
+                AddSignalSemaphore(GraphicsSemaphores[QueueType]);
+            }
+        }
+
+        std::vector<VkCommandBuffer> vkCmdBuffs;
+        vkCmdBuffs.reserve(NumCommandLists);
+        for (const auto& CmdList : CmdLists[COMMAND_QUEUE_TYPE_GRAPHICS])
+            vkCmdBuffs.push_back(CmdList.vkCmdBuff);
+        auto GraphicsFenceValue = Flush(static_cast<Uint32>(vkCmdBuffs.size()), vkCmdBuffs.data());
+        InvalidateState();
+
+        Uint64 SubmittedFenceValues[COMMAND_QUEUE_TYPE_NUM_TYPES] = {};
+        SubmittedFenceValues[COMMAND_QUEUE_TYPE_GRAPHICS] = GraphicsFenceValue;
+        for (Uint32 q = COMMAND_QUEUE_TYPE_GRAPHICS + 1; q < COMMAND_QUEUE_TYPE_NUM_TYPES; ++q)
+        {
+            const auto QueueType = static_cast<COMMAND_QUEUE_TYPE>(q);
+            if (CmdLists[QueueType].empty())
+                continue;
+
+            vkCmdBuffs.clear();
+            for (const auto& CmdList : CmdLists[QueueType])
+                vkCmdBuffs.push_back(CmdList.vkCmdBuff);
+
+            auto QueueSemaphore = LogicalDevice.CreateSemaphore(SemaphoreCI, QueueType == COMMAND_QUEUE_TYPE_COMPUTE ? "Compute queue semaphore" : "Transfer queue semaphore");
+            VkSemaphore WaitSemaphore = GraphicsSemaphores[QueueType];
+            VkSemaphore SignalSemaphore = QueueSemaphore;
+            VkPipelineStageFlags WaitDstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            VkSubmitInfo SubmitInfo = {};
+            SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            SubmitInfo.commandBufferCount   = static_cast<uint32_t>(vkCmdBuffs.size());
+            SubmitInfo.pCommandBuffers      = vkCmdBuffs.data();
+            SubmitInfo.waitSemaphoreCount   = 1;
+            SubmitInfo.pWaitSemaphores      = &WaitSemaphore;
+            SubmitInfo.pWaitDstStageMask    = &WaitDstStageMask;
+            SubmitInfo.signalSemaphoreCount = 1;
+            SubmitInfo.pSignalSemaphores    = &SignalSemaphore;
+            SubmittedFenceValues[QueueType] = pDeviceVkImpl->ExecuteCommandBuffer(QueueType, SubmitInfo, this);
+
+            pDeviceVkImpl->SafeReleaseVkObject(std::move(GraphicsSemaphores[QueueType]));
+            // Waiting for the last submission to the queue also waits for all previous ones
+            auto& LastQueueSemaphore = m_QueueSemaphores[QueueType];
+            if (LastQueueSemaphore != VK_NULL_HANDLE)
+                pDeviceVkImpl->SafeReleaseVkObject(std::move(LastQueueSemaphore));
+            LastQueueSemaphore = std::move(QueueSemaphore);
+        }
+
         auto CompletedFenceValue = pDeviceVkImpl->GetCompletedFenceValue();
-        pDeferredCtxVkImpl->ReleaseStaleContextResources(DeferredCtxCmdBuffNumber, SubmittedFenceValue, CompletedFenceValue);
+        for (Uint32 QueueType = 0; QueueType < COMMAND_QUEUE_TYPE_NUM_TYPES; ++QueueType)
+        {
+            for (auto& CmdList : CmdLists[QueueType])
+            {
+                auto pDeferredCtxVkImpl = CmdList.pDeferredCtx.RawPtr<DeviceContextVkImpl>();
+                // It is OK to dispose command buffer from another thread. We are not going to
+                // record any commands and only need to add the buffer to the queue
+                pDeferredCtxVkImpl->DisposeVkCmdBuffer(CmdList.vkCmdBuff, SubmittedFenceValues[QueueType]);
+                // We can now release all temporary resources in the deferred context associated with the submitted command list
+                pDeferredCtxVkImpl->ReleaseStaleContextResources(CmdList.DeferredCtxCmdBuffNumber, SubmittedFenceValues[QueueType], CompletedFenceValue);
+            }
+        }
         
         m_ReleaseQueue.Purge(CompletedFenceValue);
     }
@@ -1294,10 +1548,32 @@ namespace Diligent
         m_PendingFences.emplace_back( std::make_pair(Value, pFence) );
     };
 
+    void DeviceContextVkImpl::WaitForCommandQueue(COMMAND_QUEUE_TYPE QueueType)
+    {
+        if (m_bIsDeferred)
+        {
+            LOG_ERROR("Only immediate context can wait for command queues");
+            return;
+        }
+
+        VERIFY(QueueType < COMMAND_QUEUE_TYPE_NUM_TYPES, "Invalid queue type");
+        // Command lists for the graphics queue, as well as for the queues that the device does not
+        // have, are executed in the graphics queue and need no synchronization
+        auto& QueueSemaphore = m_QueueSemaphores[QueueType];
+        if (QueueSemaphore == VK_NULL_HANDLE)
+            return;
+
+        // The semaphore is waited for by the command buffer currently being recorded
+        AddWaitSemaphore(QueueSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        m_SemaphoresToRelease.emplace_back(std::move(QueueSemaphore));
+    }
+
     void DeviceContextVkImpl::TransitionImageLayout(ITexture *pTexture, VkImageLayout NewLayout)
     {
         VERIFY_EXPR(pTexture != nullptr);
         auto pTextureVk = ValidatedCast<TextureVkImpl>(pTexture);
+        // Deferred clear may change the layout of the texture
+        FlushDeferredClears(*pTextureVk);
         if (pTextureVk->GetLayout() != NewLayout)
         {
             TransitionImageLayout(*pTextureVk, NewLayout);
@@ -1306,6 +1582,7 @@ namespace Diligent
 
     void DeviceContextVkImpl::TransitionImageLayout(TextureVkImpl& TextureVk, VkImageLayout NewLayout)
     {
+        FlushDeferredClears(TextureVk);
         VERIFY(TextureVk.GetLayout() != NewLayout, "The texture is already transitioned to correct layout");
         EnsureVkCmdBuffer();
         
@@ -1334,12 +1611,18 @@ namespace Diligent
 
     void DeviceContextVkImpl::TransitionImageLayout(TextureVkImpl &TextureVk, VkImageLayout OldLayout, VkImageLayout NewLayout, const VkImageSubresourceRange& SubresRange)
     {
+        FlushDeferredClears(TextureVk);
         VERIFY(TextureVk.GetLayout() != NewLayout, "The texture is already transitioned to correct layout");
         EnsureVkCmdBuffer();
         auto vkImg = TextureVk.GetVkImage();
         m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, SubresRange);
     }
 
+    Uint32 DeviceContextVkImpl::GetNumPipelineBarriersInLastFrame()const
+    {
+        return m_NumPipelineBarriersInLastFrame;
+    }
+
     void DeviceContextVkImpl::BufferMemoryBarrier(IBuffer *pBuffer, VkAccessFlags NewAccessFlags)
     {
         VERIFY_EXPR(pBuffer != nullptr);
@@ -1366,7 +1649,7 @@ namespace Diligent
     {
         VERIFY(m_UploadAllocations.find(pBuffer) == m_UploadAllocations.end(), "Upload space has already been allocated for this buffer");
         auto UploadAllocation = m_UploadHeap.Allocate(NumBytes);
-        auto *CPUAddress = reinterpret_cast<Uint8*>(UploadAllocation.MemAllocation.Page->GetCPUMemory()) + UploadAllocation.MemAllocation.UnalignedOffset;
+        auto *CPUAddress = reinterpret_cast<Uint8*>(UploadAllocation.MemAllocation.Page->GetCPUMemory()) + UploadAllocation.MemAllocation.Offset;
         m_UploadAllocations.emplace(pBuffer, std::move(UploadAllocation));
         return CPUAddress;
     }
@@ -1377,7 +1660,7 @@ namespace Diligent
         if (it != m_UploadAllocations.end())
         {
             VERIFY_EXPR(pBuffer->GetDesc().uiSizeInBytes <= it->second.MemAllocation.Size);
-            UpdateBufferRegion(pBuffer, 0, pBuffer->GetDesc().uiSizeInBytes, it->second.vkBuffer, it->second.MemAllocation.UnalignedOffset);
+            UpdateBufferRegion(pBuffer, 0, pBuffer->GetDesc().uiSizeInBytes, it->second.vkBuffer, it->second.MemAllocation.Offset);
             // The allocation will stay in the queue until the command buffer from this context is submitted
             // to the queue. We cannot use the device's release queue as other contexts may interfer with
             // the release order
@@ -0,0 +1,76 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "DynamicDescriptorSetCache.h"
+#include "HashUtils.h"
+
+namespace Diligent
+{
+
+bool DynamicDescriptorSetCache::DescriptorSetCacheKey::operator == (const DescriptorSetCacheKey &rhs)const
+{
+    return GetHash()  == rhs.GetHash() &&
+           PSOId      == rhs.PSOId     &&
+           ObjectIds  == rhs.ObjectIds;
+}
+
+size_t DynamicDescriptorSetCache::DescriptorSetCacheKey::GetHash()const
+{
+    if(Hash == 0)
+    {
+        Hash = ComputeHash(PSOId, ObjectIds.size());
+        for(auto Id : ObjectIds)
+            HashCombine(Hash, Id);
+    }
+    return Hash;
+}
+
+VkDescriptorSet DynamicDescriptorSetCache::Find(const DescriptorSetCacheKey& Key)const
+{
+    auto it = m_Cache.find(Key);
+    return it != m_Cache.end() ? it->second.GetVkDescriptorSet() : VK_NULL_HANDLE;
+}
+
+VkDescriptorSet DynamicDescriptorSetCache::Add(const DescriptorSetCacheKey& Key, DescriptorPoolAllocation&& Allocation)
+{
+    VERIFY(m_Cache.find(Key) == m_Cache.end(), "Descriptor set with the same key is already in the cache");
+    if (m_Cache.size() >= MaxCachedSets)
+    {
+        // Released sets may still be referenced by the command buffer being recorded, but they 
+        // will only be returned to the pool after the GPU is done with it
+        Reset();
+    }
+    auto vkDescrSet = Allocation.GetVkDescriptorSet();
+    m_Cache.emplace(Key, std::move(Allocation));
+    return vkDescrSet;
+}
+
+void DynamicDescriptorSetCache::Reset()
+{
+    // Allocations are returned to the parent pool, which keeps them 
+    // until the GPU is done with the last command buffer that used them
+    m_Cache.clear();
+}
+
+}
@@ -183,9 +183,58 @@ void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Finalize(c
     pBindings = pNewBindings;
 }
 
+void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::CreateUpdateTemplate(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+{
+    // Bindings are allocated sequentially and every binding occupies descriptorCount consecutive slots 
+    // in the resource cache (see AllocateResourceSlot()). Descriptor data is laid out in the same order, 
+    // so every binding maps to a single template entry
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> Entries;
+    Entries.reserve(NumLayoutBindings);
+    uint32_t CacheOffset = 0;
+    for (uint32_t b=0; b < NumLayoutBindings; ++b)
+    {
+        const auto& Binding = pBindings[b];
+        VERIFY(Binding.binding == b, "Bindings are expected to be allocated sequentially");
+        // Atomic counters are never written, and immutable samplers cannot be updated (13.2.1)
+        bool SkipBinding = Binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+                           (Binding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER && Binding.pImmutableSamplers != nullptr);
+        if (!SkipBinding)
+        {
+            VkDescriptorUpdateTemplateEntryKHR Entry = {};
+            Entry.dstBinding      = Binding.binding;
+            Entry.dstArrayElement = 0;
+            Entry.descriptorCount = Binding.descriptorCount;
+            Entry.descriptorType  = Binding.descriptorType;
+            Entry.offset          = CacheOffset * sizeof(ShaderResourceCacheVk::DescriptorData);
+            Entry.stride          = sizeof(ShaderResourceCacheVk::DescriptorData);
+            Entries.push_back(Entry);
+        }
+        CacheOffset += Binding.descriptorCount;
+    }
+    VERIFY_EXPR(CacheOffset == TotalDescriptors);
+    if (Entries.empty())
+        return;
+
+    VkDescriptorUpdateTemplateCreateInfoKHR TemplateCI = {};
+    TemplateCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+    TemplateCI.pNext = nullptr;
+    TemplateCI.flags = 0; // reserved for future use
+    TemplateCI.descriptorUpdateEntryCount = static_cast<uint32_t>(Entries.size());
+    TemplateCI.pDescriptorUpdateEntries = Entries.data();
+    TemplateCI.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    TemplateCI.descriptorSetLayout = VkLayout;
+    // The remaining members are ignored for VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET templates
+    TemplateCI.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    TemplateCI.pipelineLayout = VK_NULL_HANDLE;
+    TemplateCI.set = 0;
+    VkUpdateTemplate = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI);
+}
+
 void PipelineLayout::DescriptorSetLayoutManager::DescriptorSetLayout::Release(RenderDeviceVkImpl *pRenderDeviceVk, IMemoryAllocator &MemAllocator)
 {
     pRenderDeviceVk->SafeReleaseVkObject(std::move(VkLayout));
+    if (VkUpdateTemplate != VK_NULL_HANDLE)
+        pRenderDeviceVk->SafeReleaseVkObject(std::move(VkUpdateTemplate));
     for (uint32_t b=0; b < NumLayoutBindings; ++b)
     {
         if (pBindings[b].pImmutableSamplers != nullptr)
@@ -258,6 +307,12 @@ void PipelineLayout::DescriptorSetLayoutManager::Finalize(const VulkanUtilities:
             ActiveDescrSetLayouts[Layout.SetIndex] = Layout.VkLayout;
         }
     }
+
+    // Static and mutable descriptors are written one variable at a time when resources are bound,
+    // so the template is only needed for the dynamic set that is fully written at every commit
+    auto& DynamicSetLayout = GetDescriptorSet(SHADER_VARIABLE_TYPE_DYNAMIC);
+    if (DynamicSetLayout.SetIndex >= 0 && LogicalDevice.IsDescriptorUpdateTemplateSupported())
+        DynamicSetLayout.CreateUpdateTemplate(LogicalDevice);
     VERIFY_EXPR(BindingOffset == TotalBindings);
     VERIFY_EXPR(m_ActiveSets == 0 && ActiveDescrSetLayouts[0] == VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE ||
                 m_ActiveSets == 1 && ActiveDescrSetLayouts[0] != VK_NULL_HANDLE && ActiveDescrSetLayouts[1] == VK_NULL_HANDLE ||
@@ -42,7 +42,13 @@ VkRenderPassCreateInfo PipelineStateVkImpl::GetRenderPassCreateInfo(
         Uint32                                                   SampleCount,
         std::array<VkAttachmentDescription, MaxRenderTargets+1>& Attachments,
         std::array<VkAttachmentReference,   MaxRenderTargets+1>& AttachmentReferences,
-        VkSubpassDescription&                                    SubpassDesc)
+        VkSubpassDescription&                                    SubpassDesc,
+        const VkAttachmentLoadOp                                 RTVLoadOps[],
+        const VkAttachmentStoreOp                                RTVStoreOps[],
+        VkAttachmentLoadOp                                       DSVLoadOp,
+        VkAttachmentStoreOp                                      DSVStoreOp,
+        VkAttachmentLoadOp                                       StencilLoadOp,
+        VkAttachmentStoreOp                                      StencilStoreOp)
 {
     VERIFY_EXPR(NumRenderTargets <= MaxRenderTargets);
 
@@ -62,14 +68,17 @@ VkRenderPassCreateInfo PipelineStateVkImpl::GetRenderPassCreateInfo(
         DepthAttachment.flags = 0; // Allowed value VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT
         DepthAttachment.format = TexFormatToVkFormat(DSVFormat);
         DepthAttachment.samples = SampleCountFlags;
-        DepthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD; // previous contents of the image within the render area 
-                                                             // will be preserved. For attachments with a depth/stencil format, 
-                                                             // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT.
-        DepthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE; // the contents generated during the render pass and within the render 
-                                                                // area are written to memory. For attachments with a depth/stencil format,
-                                                                // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT. 
-        DepthAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
-        DepthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+        DepthAttachment.loadOp = DSVLoadOp; // LOAD: previous contents of the image within the render area 
+                                            // will be preserved. For attachments with a depth/stencil format, 
+                                            // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT.
+                                            // CLEAR: the contents within the render area will be cleared to a uniform
+                                            // value specified when the render pass instance is begun. This uses
+                                            // the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT.
+        DepthAttachment.storeOp = DSVStoreOp; // STORE: the contents generated during the render pass and within the render 
+                                              // area are written to memory. For attachments with a depth/stencil format,
+                                              // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT. 
+        DepthAttachment.stencilLoadOp  = StencilLoadOp;
+        DepthAttachment.stencilStoreOp = StencilStoreOp;
         DepthAttachment.initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
         DepthAttachment.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
@@ -88,12 +97,17 @@ VkRenderPassCreateInfo PipelineStateVkImpl::GetRenderPassCreateInfo(
         ColorAttachment.flags = 0; // Allowed value VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT
         ColorAttachment.format = TexFormatToVkFormat(RTVFormats[rt]);
         ColorAttachment.samples = SampleCountFlags;
-        ColorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD; // previous contents of the image within the render area 
-                                                             // will be preserved. For attachments with a depth/stencil format, 
-                                                             // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_READ_BIT.
-        ColorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE; // the contents generated during the render pass and within the render
-                                                                // area are written to memory. For attachments with a color format,
-                                                                // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT. 
+        ColorAttachment.loadOp = RTVLoadOps != nullptr ? RTVLoadOps[rt] : VK_ATTACHMENT_LOAD_OP_LOAD;
+                                    // LOAD: previous contents of the image within the render area 
+                                    // will be preserved. For attachments with a color format, 
+                                    // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_READ_BIT.
+                                    // CLEAR: the contents within the render area will be cleared to a uniform
+                                    // value specified when the render pass instance is begun. This uses
+                                    // the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT.
+        ColorAttachment.storeOp = RTVStoreOps != nullptr ? RTVStoreOps[rt] : VK_ATTACHMENT_STORE_OP_STORE;
+                                    // STORE: the contents generated during the render pass and within the render
+                                    // area are written to memory. For attachments with a color format,
+                                    // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT. 
         ColorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
         ColorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
         ColorAttachment.initialLayout  = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
@@ -225,7 +239,7 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
         PipelineCI.stage = ShaderStages[0];
         PipelineCI.layout = m_PipelineLayout.GetVkPipelineLayout();
         
-        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        m_Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), m_Desc.Name);
     }
     else
     {
@@ -374,7 +388,7 @@ PipelineStateVkImpl :: PipelineStateVkImpl(IReferenceCounters*      pRefCounters
         PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
         PipelineCI.basePipelineIndex = 0; // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, m_Desc.Name);
+        m_Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, pDeviceVk->GetVkPipelineCache(), m_Desc.Name);
     }
 
     m_HasStaticResources = false;
@@ -552,26 +566,58 @@ void PipelineStateVkImpl::CommitAndTransitionShaderResources(IShaderResourceBind
 #endif
         }
 
-        DescriptorPoolAllocation DynamicDescrSetAllocation;
+        VkDescriptorSet vkDynamicDescrSet = VK_NULL_HANDLE;
         auto DynamicDescriptorSetVkLayout = m_PipelineLayout.GetDynamicDescriptorSetVkLayout();
         if (DynamicDescriptorSetVkLayout != VK_NULL_HANDLE)
         {
-            // Allocate vulkan descriptor set for dynamic resources
-            DynamicDescrSetAllocation = pCtxVkImpl->AllocateDynamicDescriptorSet(DynamicDescriptorSetVkLayout);
-            // Commit all dynamic resource descriptors
+            // Descriptor set that has already been written with the same objects in this frame can be reused
+            auto& DynamicDescrSetCache = pCtxVkImpl->GetDynamicDescriptorSetCache();
+            auto& CacheKey = DynamicDescrSetCache.GetLookupKey(GetUniqueID());
             for (Uint32 s=0; s < m_NumShaders; ++s)
             {
                 const auto& Layout = m_ShaderResourceLayouts[s];
                 if (Layout.GetResourceCount(SHADER_VARIABLE_TYPE_DYNAMIC) != 0)
-                    Layout.CommitDynamicResources(ResourceCache, DynamicDescrSetAllocation.GetVkDescriptorSet());
+                    Layout.GetDynamicResourceObjectIds(ResourceCache, CacheKey.ObjectIds);
+            }
+
+            vkDynamicDescrSet = DynamicDescrSetCache.Find(CacheKey);
+            if (vkDynamicDescrSet == VK_NULL_HANDLE)
+            {
+                // Allocate vulkan descriptor set for dynamic resources
+                auto DynamicDescrSetAllocation = pCtxVkImpl->AllocateDynamicDescriptorSet(DynamicDescriptorSetVkLayout);
+                auto vkUpdateTemplate = m_PipelineLayout.GetDynamicDescriptorUpdateTemplate();
+                if (vkUpdateTemplate != VK_NULL_HANDLE)
+                {
+                    // Gather descriptor data of all shader stages in resource cache order and 
+                    // write the entire set with a single call
+                    auto* pDescriptorData = pCtxVkImpl->GetDescriptorDataScratch(m_PipelineLayout.GetTotalDescriptors(SHADER_VARIABLE_TYPE_DYNAMIC));
+                    for (Uint32 s=0; s < m_NumShaders; ++s)
+                    {
+                        const auto& Layout = m_ShaderResourceLayouts[s];
+                        if (Layout.GetResourceCount(SHADER_VARIABLE_TYPE_DYNAMIC) != 0)
+                            Layout.GetDynamicDescriptorData(ResourceCache, pDescriptorData);
+                    }
+                    m_pDevice->GetLogicalDevice().UpdateDescriptorSetWithTemplate(DynamicDescrSetAllocation.GetVkDescriptorSet(), vkUpdateTemplate, pDescriptorData);
+                }
+                else
+                {
+                    // Commit all dynamic resource descriptors
+                    for (Uint32 s=0; s < m_NumShaders; ++s)
+                    {
+                        const auto& Layout = m_ShaderResourceLayouts[s];
+                        if (Layout.GetResourceCount(SHADER_VARIABLE_TYPE_DYNAMIC) != 0)
+                            Layout.CommitDynamicResources(ResourceCache, DynamicDescrSetAllocation.GetVkDescriptorSet());
+                    }
+                }
+                // The allocation is kept by the cache until the end of the frame, after which it goes back to 
+                // the context's dynamic descriptor pool. It will stay there until the next command buffer is 
+                // submitted, at which point it will be discarded and actually released later
+                vkDynamicDescrSet = DynamicDescrSetCache.Add(CacheKey, std::move(DynamicDescrSetAllocation));
             }
         }
         // Prepare descriptor sets, and also bind them if there are no dynamic descriptors
         VERIFY_EXPR(pDescrSetBindInfo != nullptr);
-        m_PipelineLayout.PrepareDescriptorSets(pCtxVkImpl, m_Desc.IsComputePipeline, ResourceCache, *pDescrSetBindInfo, DynamicDescrSetAllocation.GetVkDescriptorSet());
-        // Dynamic descriptor set allocation automatically goes back to the context's dynamic descriptor pool. 
-        // release queue. It will stay there until the next command list is executed, at which point it will be discarded
-        // and actually released later
+        m_PipelineLayout.PrepareDescriptorSets(pCtxVkImpl, m_Desc.IsComputePipeline, ResourceCache, *pDescrSetBindInfo, vkDynamicDescrSet);
     }
     else
     {
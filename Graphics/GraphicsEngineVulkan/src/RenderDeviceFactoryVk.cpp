@@ -56,6 +56,8 @@ public:
                               std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice,
                               std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice,
                               ICommandQueueVk*       pCommandQueue,
+                              ICommandQueueVk*       pComputeQueue,
+                              ICommandQueueVk*       pTransferQueue,
                               const EngineVkAttribs& EngineAttribs, 
                               IRenderDevice**        ppDevice, 
                               IDeviceContext**       ppContexts,
@@ -70,7 +72,9 @@ public:
 
 /// Creates render device and device contexts for Vulkan backend
 
-/// \param [in] CreationAttribs - Engine creation attributes.
+/// \param [in] CreationAttribs - Engine creation attributes. If CreationAttribs.Headless is true,
+///                              the device is created without presentation support and 
+///                              requires no surface or swap chain.
 /// \param [out] ppDevice - Address of the memory location where pointer to 
 ///                         the created device will be written
 /// \param [out] ppContexts - Address of the memory location where pointers to 
@@ -118,6 +122,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk( const EngineVkAttribs& Crea
     {
         auto Instance = VulkanUtilities::VulkanInstance::Create(
             CreationAttribs.EnableValidation, 
+            !CreationAttribs.Headless,
             CreationAttribs.GlobalExtensionCount, 
             CreationAttribs.ppGlobalExtensionNames,
             reinterpret_cast<VkAllocationCallbacks*>(CreationAttribs.pVkAllocator));
@@ -140,6 +145,45 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk( const EngineVkAttribs& Crea
         QueueInfo.queueCount = 1;
         const float defaultQueuePriority = 1.0f; // Ask for highest priority for our queue. (range [0,1])
         QueueInfo.pQueuePriorities = &defaultQueuePriority;
+        std::vector<VkDeviceQueueCreateInfo> QueueInfos = {QueueInfo};
+
+        // Dedicated queues let streaming uploads and asynchronous compute overlap graphics work
+        // instead of being serialized with it in the graphics queue
+        uint32_t ComputeQueueFamilyIndex  = VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex;
+        uint32_t TransferQueueFamilyIndex = VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex;
+        if (CreationAttribs.EnableComputeQueue)
+        {
+            ComputeQueueFamilyIndex = PhysicalDevice->FindDedicatedQueueFamily(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+            if (ComputeQueueFamilyIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex)
+            {
+                QueueInfo.queueFamilyIndex = ComputeQueueFamilyIndex;
+                QueueInfos.push_back(QueueInfo);
+            }
+            else
+                LOG_INFO_MESSAGE("The device exposes no dedicated compute queue family. Compute contexts will use the graphics queue");
+        }
+        if (CreationAttribs.EnableTransferQueue)
+        {
+            TransferQueueFamilyIndex = PhysicalDevice->FindDedicatedQueueFamily(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+            if (TransferQueueFamilyIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex)
+            {
+                // Transfer-only queues may restrict the granularity of image copies, which 
+                // partial texture updates cannot generally satisfy
+                const auto& Granularity = PhysicalDevice->GetQueueFamilyProperties(TransferQueueFamilyIndex).minImageTransferGranularity;
+                if (Granularity.width == 1 && Granularity.height == 1 && Granularity.depth == 1)
+                {
+                    QueueInfo.queueFamilyIndex = TransferQueueFamilyIndex;
+                    QueueInfos.push_back(QueueInfo);
+                }
+                else
+                {
+                    LOG_INFO_MESSAGE("Dedicated transfer queue family requires image transfer granularity (", Granularity.width, ", ", Granularity.height, ", ", Granularity.depth, ") and will not be used");
+                    TransferQueueFamilyIndex = VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex;
+                }
+            }
+            else
+                LOG_INFO_MESSAGE("The device exposes no dedicated transfer queue family. Transfer contexts will use the graphics queue");
+        }
 
         VkDeviceCreateInfo DeviceCreateInfo = {};
         DeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -147,8 +191,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk( const EngineVkAttribs& Crea
         // https://www.khronos.org/registry/vulkan/specs/1.0/html/vkspec.html#extended-functionality-device-layer-deprecation
         DeviceCreateInfo.enabledLayerCount = 0; // Deprecated and ignored.
         DeviceCreateInfo.ppEnabledLayerNames = nullptr; // Deprecated and ignored
-        DeviceCreateInfo.queueCreateInfoCount = 1;
-        DeviceCreateInfo.pQueueCreateInfos = &QueueInfo;
+        DeviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(QueueInfos.size());
+        DeviceCreateInfo.pQueueCreateInfos = QueueInfos.data();
         VkPhysicalDeviceFeatures DeviceFeatures = {};
         DeviceFeatures.depthBiasClamp                    = CreationAttribs.EnabledFeatures.depthBiasClamp                    ? VK_TRUE : VK_FALSE;
         DeviceFeatures.fillModeNonSolid                  = CreationAttribs.EnabledFeatures.fillModeNonSolid                  ? VK_TRUE : VK_FALSE;
@@ -169,14 +213,23 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk( const EngineVkAttribs& Crea
 
         std::vector<const char*> DeviceExtensions = 
         { 
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME, 
             VK_KHR_MAINTENANCE1_EXTENSION_NAME // To allow negative viewport height
         };
+        // Headless devices never present, so the swap chain extension is not required
+        if (!CreationAttribs.Headless)
+        {
+            DeviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
         const bool DebugMarkersSupported = PhysicalDevice->IsExtensionSupported(VK_EXT_DEBUG_MARKER_EXTENSION_NAME);
         if (DebugMarkersSupported && CreationAttribs.EnableValidation)
         {
             DeviceExtensions.push_back(VK_EXT_DEBUG_MARKER_EXTENSION_NAME);
         }
+        // Descriptor update templates allow writing all dynamic descriptors of a set with a single call
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+        {
+            DeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+        }
 
         DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         DeviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(DeviceExtensions.size());
@@ -190,19 +243,32 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk( const EngineVkAttribs& Crea
         auto vkPhysicalDevice = PhysicalDevice->GetVkDeviceHandle();
         auto LogicalDevice = VulkanUtilities::VulkanLogicalDevice::Create(vkPhysicalDevice, DeviceCreateInfo, vkAllocator, DebugMarkersSupported && CreationAttribs.EnableValidation);
 
-        RefCntAutoPtr<CommandQueueVkImpl> pCmdQueueVk;
+        RefCntAutoPtr<CommandQueueVkImpl> pCmdQueueVk, pComputeQueueVk, pTransferQueueVk;
         auto &RawMemAllocator = GetRawAllocator();
-        pCmdQueueVk = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, QueueInfo.queueFamilyIndex);
-
-        AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, pCmdQueueVk, CreationAttribs, ppDevice, ppContexts, NumDeferredContexts);
+        pCmdQueueVk = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, QueueInfos[0].queueFamilyIndex);
+        if (ComputeQueueFamilyIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex)
+            pComputeQueueVk = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, ComputeQueueFamilyIndex);
+        if (TransferQueueFamilyIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidQueueFamilyIndex)
+            pTransferQueueVk = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, TransferQueueFamilyIndex);
+
+        AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, pCmdQueueVk, pComputeQueueVk, pTransferQueueVk, CreationAttribs, ppDevice, ppContexts, NumDeferredContexts);
+        if (*ppDevice == nullptr)
+            return;
 
-        FenceDesc Desc;
-        Desc.Name = "Command queue fence";
-        // Render device owns command queue that in turn owns the fence, so it is an internal device object
+        // Render device owns command queues that in turn own the fences, so they are internal device objects
         bool IsDeviceInternal = true;
         auto* pRenderDeviceVk = ValidatedCast<RenderDeviceVkImpl>(*ppDevice);
-        RefCntAutoPtr<FenceVkImpl> pFenceVk( NEW_RC_OBJ(RawMemAllocator, "FenceVkImpl instance", FenceVkImpl)(pRenderDeviceVk, Desc, IsDeviceInternal) );
-        pCmdQueueVk->SetFence(std::move(pFenceVk));
+        CommandQueueVkImpl* Queues[] = {pCmdQueueVk, pComputeQueueVk, pTransferQueueVk};
+        const Char* FenceNames[] = {"Command queue fence", "Compute queue fence", "Transfer queue fence"};
+        for (size_t q = 0; q < _countof(Queues); ++q)
+        {
+            if (Queues[q] == nullptr)
+                continue;
+            FenceDesc Desc;
+            Desc.Name = FenceNames[q];
+            RefCntAutoPtr<FenceVkImpl> pFenceVk( NEW_RC_OBJ(RawMemAllocator, "FenceVkImpl instance", FenceVkImpl)(pRenderDeviceVk, Desc, IsDeviceInternal) );
+            Queues[q]->SetFence(std::move(pFenceVk));
+        }
     }
     catch(std::runtime_error& )
     {
@@ -216,6 +282,8 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk( const EngineVkAttribs& Crea
 /// \param [in] PhysicalDevice - pointer to the object representing physical device
 /// \param [in] LogicalDevice - shared pointer to a VulkanUtilities::VulkanLogicalDevice object
 /// \param [in] pCommandQueue - pointer to the implementation of command queue
+/// \param [in] pComputeQueue - pointer to the queue from a dedicated compute family, may be null
+/// \param [in] pTransferQueue - pointer to the queue from a dedicated transfer family, may be null
 /// \param [in] EngineAttribs - Engine creation attributes.
 /// \param [out] ppDevice - Address of the memory location where pointer to 
 ///                         the created device will be written
@@ -231,6 +299,8 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
                                                std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice,
                                                std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice,
                                                ICommandQueueVk*       pCommandQueue,
+                                               ICommandQueueVk*       pComputeQueue,
+                                               ICommandQueueVk*       pTransferQueue,
                                                const EngineVkAttribs& EngineAttribs, 
                                                IRenderDevice**        ppDevice, 
                                                IDeviceContext**       ppContexts,
@@ -246,12 +316,12 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
     try
     {
         auto &RawMemAllocator = GetRawAllocator();
-        RenderDeviceVkImpl *pRenderDeviceVk( NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(RawMemAllocator, EngineAttribs, pCommandQueue, Instance, std::move(PhysicalDevice), LogicalDevice, NumDeferredContexts ) );
+        RenderDeviceVkImpl *pRenderDeviceVk( NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(RawMemAllocator, EngineAttribs, pCommandQueue, pComputeQueue, pTransferQueue, Instance, std::move(PhysicalDevice), LogicalDevice, NumDeferredContexts ) );
         pRenderDeviceVk->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice) );
 
         std::shared_ptr<GenerateMipsVkHelper> GenerateMipsHelper(new GenerateMipsVkHelper(*pRenderDeviceVk));
 
-        RefCntAutoPtr<DeviceContextVkImpl> pImmediateCtxVk( NEW_RC_OBJ(RawMemAllocator, "DeviceContextVkImpl instance", DeviceContextVkImpl)(pRenderDeviceVk, false, EngineAttribs, 0, GenerateMipsHelper) );
+        RefCntAutoPtr<DeviceContextVkImpl> pImmediateCtxVk( NEW_RC_OBJ(RawMemAllocator, "DeviceContextVkImpl instance", DeviceContextVkImpl)(pRenderDeviceVk, false, EngineAttribs, 0, COMMAND_QUEUE_TYPE_GRAPHICS, GenerateMipsHelper) );
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceVk will
         // keep a weak reference to the context
         pImmediateCtxVk->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts) );
@@ -259,7 +329,11 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
 
         for (Uint32 DeferredCtx = 0; DeferredCtx < NumDeferredContexts; ++DeferredCtx)
         {
-            RefCntAutoPtr<DeviceContextVkImpl> pDeferredCtxVk( NEW_RC_OBJ(RawMemAllocator, "DeviceContextVkImpl instance", DeviceContextVkImpl)(pRenderDeviceVk, true, EngineAttribs, 1+DeferredCtx, GenerateMipsHelper) );
+            auto QueueType = EngineAttribs.pDeferredContextQueues != nullptr ? EngineAttribs.pDeferredContextQueues[DeferredCtx] : COMMAND_QUEUE_TYPE_GRAPHICS;
+            VERIFY(QueueType < COMMAND_QUEUE_TYPE_NUM_TYPES, "Invalid queue type");
+            if (!pRenderDeviceVk->HasDedicatedQueue(QueueType))
+                QueueType = COMMAND_QUEUE_TYPE_GRAPHICS;
+            RefCntAutoPtr<DeviceContextVkImpl> pDeferredCtxVk( NEW_RC_OBJ(RawMemAllocator, "DeviceContextVkImpl instance", DeviceContextVkImpl)(pRenderDeviceVk, true, EngineAttribs, 1+DeferredCtx, QueueType, GenerateMipsHelper) );
             // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceVk will
             // keep a weak reference to the context
             pDeferredCtxVk->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx) );
@@ -312,9 +386,15 @@ void EngineFactoryVkImpl::CreateSwapChainVk( IRenderDevice*       pDevice,
 
     *ppSwapChain = nullptr;
 
+    auto *pDeviceVk = ValidatedCast<RenderDeviceVkImpl>( pDevice );
+    if (pDeviceVk->GetEngineAttribs().Headless)
+    {
+        LOG_ERROR_MESSAGE("Swap chain cannot be created for a headless device");
+        return;
+    }
+
     try
     {
-        auto *pDeviceVk = ValidatedCast<RenderDeviceVkImpl>( pDevice );
         auto *pDeviceContextVk = ValidatedCast<DeviceContextVkImpl>(pImmediateContext);
         auto &RawMemAllocator = GetRawAllocator();
         auto *pSwapChainVk = NEW_RC_OBJ(RawMemAllocator, "SwapChainVkImpl instance", SwapChainVkImpl)(SCDesc, pDeviceVk, pDeviceContextVk, pNativeWndHandle);
@@ -371,6 +451,7 @@ void LoadGraphicsEngineVk(GetEngineFactoryVkType &GetFactoryFunc)
 #endif
 
 
+API_QUALIFIER
 IEngineFactoryVk* GetEngineFactoryVk()
 {
     return EngineFactoryVkImpl::GetInstance();
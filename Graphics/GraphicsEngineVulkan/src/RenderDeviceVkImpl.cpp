@@ -34,14 +34,51 @@
 #include "DeviceContextVkImpl.h"
 #include "FenceVkImpl.h"
 #include "EngineMemory.h"
+#include "DataBlobImpl.h"
 
 namespace Diligent
 {
 
+// Checks that the pipeline cache data was produced by the same device and driver.
+// Drivers are required to validate the data too, but some of them are known to crash
+// on incompatible data, so the check is done before passing the data to Vulkan.
+static bool IsPipelineCacheDataCompatible(const void* pData, size_t DataSize, const VkPhysicalDeviceProperties& DeviceProps)
+{
+    // Pipeline cache header layout (see VkPipelineCacheHeaderVersion):
+    //
+    //  | header size (uint32) | header version (uint32) | vendor ID (uint32) | device ID (uint32) | pipeline cache UUID (VK_UUID_SIZE bytes) |
+    //
+    static constexpr size_t HeaderSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    if (DataSize < HeaderSize)
+        return false;
+
+    uint32_t Header[4];
+    memcpy(Header, pData, sizeof(Header));
+    const auto* pCacheUUID = reinterpret_cast<const Uint8*>(pData) + sizeof(Header);
+    return Header[0] >= HeaderSize && Header[0] <= DataSize &&
+           Header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           Header[2] == DeviceProps.vendorID &&
+           Header[3] == DeviceProps.deviceID &&
+           memcmp(pCacheUUID, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+static std::vector<uint32_t> GetUniqueQueueFamilyIndices(ICommandQueueVk* pCmdQueue, ICommandQueueVk* pComputeQueue, ICommandQueueVk* pTransferQueue)
+{
+    std::vector<uint32_t> QueueFamilyIndices;
+    for (auto* pQueue : {pCmdQueue, pComputeQueue, pTransferQueue})
+    {
+        if (pQueue != nullptr && std::find(QueueFamilyIndices.begin(), QueueFamilyIndices.end(), pQueue->GetQueueFamilyIndex()) == QueueFamilyIndices.end())
+            QueueFamilyIndices.push_back(pQueue->GetQueueFamilyIndex());
+    }
+    return QueueFamilyIndices;
+}
+
 RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*                                     pRefCounters, 
                                          IMemoryAllocator&                                       RawMemAllocator, 
                                          const EngineVkAttribs&                                  CreationAttribs, 
                                          ICommandQueueVk*                                        pCmdQueue,
+                                         ICommandQueueVk*                                        pComputeQueue,
+                                         ICommandQueueVk*                                        pTransferQueue,
                                          std::shared_ptr<VulkanUtilities::VulkanInstance>        Instance,
                                          std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice>  PhysicalDevice,
                                          std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>   LogicalDevice,
@@ -65,6 +102,7 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
     m_PhysicalDevice(std::move(PhysicalDevice)),
     m_LogicalVkDevice(std::move(LogicalDevice)),
     m_pCommandQueue(pCmdQueue),
+    m_QueueFamilyIndices(GetUniqueQueueFamilyIndices(pCmdQueue, pComputeQueue, pTransferQueue)),
     m_EngineAttribs(CreationAttribs),
 	m_FrameNumber(0),
     m_NextCmdBuffNumber(0),
@@ -89,13 +127,20 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
         CreationAttribs.MainDescriptorPoolSize.MaxDescriptorSets
     },
     m_TransientCmdPoolMgr(*m_LogicalVkDevice, pCmdQueue->GetQueueFamilyIndex(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT),
-    m_MemoryMgr("Global resource memory manager", *m_LogicalVkDevice, *m_PhysicalDevice, GetRawAllocator(), CreationAttribs.DeviceLocalMemoryPageSize, CreationAttribs.HostVisibleMemoryPageSize, CreationAttribs.DeviceLocalMemoryReserveSize, CreationAttribs.HostVisibleMemoryReserveSize),
+    m_MemoryMgr("Global resource memory manager", *m_LogicalVkDevice, *m_PhysicalDevice, GetRawAllocator(), CreationAttribs.DeviceLocalMemoryPageSize, CreationAttribs.HostVisibleMemoryPageSize, CreationAttribs.DeviceLocalMemoryReserveSize, CreationAttribs.HostVisibleMemoryReserveSize, CreationAttribs.UseTLSFMemoryAllocator),
     m_ReleaseQueue(GetRawAllocator()),
     m_DynamicHeapRingBuffer
     {
         GetRawAllocator(),
         *this,
         CreationAttribs.DynamicHeapSize
+    },
+    m_UploadBatcher
+    {
+        GetRawAllocator(),
+        *this,
+        CreationAttribs.UploadRingBufferSize,
+        CreationAttribs.UploadBatchSize
     }
 {
     m_DeviceCaps.DevType = DeviceType::Vulkan;
@@ -105,6 +150,31 @@ RenderDeviceVkImpl :: RenderDeviceVkImpl(IReferenceCounters*
     m_DeviceCaps.bMultithreadedResourceCreationSupported = True;
     for(int fmt = 1; fmt < m_TextureFormatsInfo.size(); ++fmt)
         m_TextureFormatsInfo[fmt].Supported = true; // We will test every format on a specific hardware device
+
+    VkPipelineCacheCreateInfo PipelineCacheCI = {};
+    PipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.pNext = nullptr;
+    PipelineCacheCI.flags = 0; // reserved for future use
+    if (CreationAttribs.pPipelineCacheData != nullptr && CreationAttribs.PipelineCacheDataSize != 0)
+    {
+        if (IsPipelineCacheDataCompatible(CreationAttribs.pPipelineCacheData, CreationAttribs.PipelineCacheDataSize, m_PhysicalDevice->GetProperties()))
+        {
+            PipelineCacheCI.initialDataSize = CreationAttribs.PipelineCacheDataSize;
+            PipelineCacheCI.pInitialData    = CreationAttribs.pPipelineCacheData;
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Pipeline cache data is not compatible with the device or the driver and will be ignored");
+        }
+    }
+    m_PipelineCache = m_LogicalVkDevice->CreatePipelineCache(PipelineCacheCI, "Device pipeline cache");
+
+    m_pDedicatedQueues[COMMAND_QUEUE_TYPE_COMPUTE]  = pComputeQueue;
+    m_pDedicatedQueues[COMMAND_QUEUE_TYPE_TRANSFER] = pTransferQueue;
+    // The data is only required during initialization
+    m_EngineAttribs.pPipelineCacheData    = nullptr;
+    m_EngineAttribs.PipelineCacheDataSize = 0;
+    m_EngineAttribs.pDeferredContextQueues = nullptr;
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
@@ -115,6 +185,8 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
     // will move all stale resources to the release queues. The resources will not be
     // release until the next call to FinishFrame()
     FinishFrame(false);
+    // FinishFrame() has submitted pending uploads, so the upload ring buffer can now be released
+    m_UploadBatcher.Destroy();
     // Wait for the GPU to complete all its operations
     IdleGPU(true);
     // Call FinishFrame() again to destroy resources in
@@ -203,6 +275,32 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(VkCommandBuffer vkCmd
     m_TransientCmdPoolMgr.DisposeCommandPool(std::move(CmdPool), SubmittedFenceValue);
 }
 
+void RenderDeviceVkImpl::DisposeTransientCmdPool(VulkanUtilities::CommandPoolWrapper&& CmdPool, Uint64 FenceValue)
+{
+    m_TransientCmdPoolMgr.DisposeCommandPool(std::move(CmdPool), FenceValue);
+}
+
+Uint32 RenderDeviceVkImpl::GetQueueFamilyIndices(Uint32 CommandQueueFlags, uint32_t* pFamilyIndices)
+{
+    Uint32 NumFamilies = 0;
+    for (Uint32 QueueType = 0; QueueType < COMMAND_QUEUE_TYPE_NUM_TYPES; ++QueueType)
+    {
+        if ((CommandQueueFlags & (1 << QueueType)) == 0)
+            continue;
+        auto FamilyIndex = GetCmdQueue(static_cast<COMMAND_QUEUE_TYPE>(QueueType))->GetQueueFamilyIndex();
+        if (std::find(pFamilyIndices, pFamilyIndices + NumFamilies, FamilyIndex) == pFamilyIndices + NumFamilies)
+            pFamilyIndices[NumFamilies++] = FamilyIndex;
+    }
+    return NumFamilies;
+}
+
+void RenderDeviceVkImpl::FlushUploadBatch()
+{
+    std::lock_guard<std::mutex> LockGuard(m_CmdQueueMutex);
+    auto BatchLock = m_UploadBatcher.LockBatch();
+    m_UploadBatcher.SubmitPendingBatch(*m_pCommandQueue, BatchLock);
+}
+
 void RenderDeviceVkImpl::SubmitCommandBuffer(const VkSubmitInfo& SubmitInfo, 
                                              Uint64&             SubmittedCmdBuffNumber,                      // Number of the submitted command buffer 
                                              Uint64&             SubmittedFenceValue,                         // Fence value associated with the submitted command buffer
@@ -210,6 +308,12 @@ void RenderDeviceVkImpl::SubmitCommandBuffer(const VkSubmitInfo& SubmitInfo,
                                              )
 {
 	std::lock_guard<std::mutex> LockGuard(m_CmdQueueMutex);
+    // Resources created since the last submission may be used by the command buffer, so their
+    // initial data must be uploaded first. The batch stays locked until the command buffer number
+    // is incremented (see ResourceUploadBatcher::LockBatch())
+    auto UploadBatchLock = m_UploadBatcher.LockBatch();
+    m_UploadBatcher.SubmitPendingBatch(*m_pCommandQueue, UploadBatchLock);
+
     auto NextFenceValue = m_pCommandQueue->GetNextFenceValue();
 	// Submit the command list to the queue
     SubmittedFenceValue = m_pCommandQueue->ExecuteCommandBuffer(SubmitInfo);
@@ -259,6 +363,35 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(const VkSubmitInfo& SubmitInfo,
 }
 
 
+Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(COMMAND_QUEUE_TYPE QueueType, const VkSubmitInfo& SubmitInfo, DeviceContextVkImpl* pImmediateCtx)
+{
+    VERIFY(!pImmediateCtx->IsDeferred(), "Command buffers must be submitted from immediate context only");
+    VERIFY(HasDedicatedQueue(QueueType), "The device has no dedicated queue of this type");
+
+    Uint64 SubmittedFenceValue = 0;
+    Uint64 SubmittedCmdBuffNumber = 0;
+    {
+        std::lock_guard<std::mutex> LockGuard(m_CmdQueueMutex);
+        auto QueueFenceValue = m_pDedicatedQueues[QueueType]->ExecuteCommandBuffer(SubmitInfo);
+        // Resources used by the command buffer are released along with the resources used by 
+        // the next command buffer submitted to the graphics queue. GetCompletedFenceValue() does not
+        // report this fence value as completed until the dedicated queue completes the command buffer.
+        SubmittedFenceValue = m_pCommandQueue->GetNextFenceValue();
+        {
+            std::lock_guard<std::mutex> SubmissionsLock(m_DedicatedQueueSubmissionsMtx);
+            m_DedicatedQueueSubmissions.push_back(DedicatedQueueSubmission{SubmittedFenceValue, QueueType, QueueFenceValue});
+        }
+        SubmittedCmdBuffNumber = m_NextCmdBuffNumber;
+        Atomics::AtomicIncrement(m_NextCmdBuffNumber);
+    }
+
+    auto CompletedFenceValue = GetCompletedFenceValue();
+    ProcessStaleResources(SubmittedCmdBuffNumber, SubmittedFenceValue, CompletedFenceValue);
+
+    return SubmittedFenceValue;
+}
+
+
 Uint64 RenderDeviceVkImpl::IdleGPU(bool ReleaseStaleObjects) 
 { 
     Uint64 SubmittedFenceValue = 0;
@@ -267,9 +400,17 @@ Uint64 RenderDeviceVkImpl::IdleGPU(bool ReleaseStaleObjects)
     {
         // Lock the command queue to avoid other threads interfering with the GPU
         std::lock_guard<std::mutex> LockGuard(m_CmdQueueMutex);
+        auto UploadBatchLock = m_UploadBatcher.LockBatch();
+        m_UploadBatcher.SubmitPendingBatch(*m_pCommandQueue, UploadBatchLock);
+
         SubmittedFenceValue = m_pCommandQueue->GetNextFenceValue();
         // CommandQueueVkImpl::IdleGPU increments next fence value
         m_pCommandQueue->IdleGPU();
+        for (auto& pQueue : m_pDedicatedQueues)
+        {
+            if (pQueue)
+                pQueue->IdleGPU();
+        }
 
         m_LogicalVkDevice->WaitIdle();
 
@@ -303,7 +444,23 @@ Bool RenderDeviceVkImpl::IsFenceSignaled(Uint64 FenceValue)
 
 Uint64 RenderDeviceVkImpl::GetCompletedFenceValue()
 {
-    return m_pCommandQueue->GetCompletedFenceValue();
+    auto CompletedFenceValue = m_pCommandQueue->GetCompletedFenceValue();
+
+    std::lock_guard<std::mutex> SubmissionsLock(m_DedicatedQueueSubmissionsMtx);
+    while (!m_DedicatedQueueSubmissions.empty())
+    {
+        const auto& Submission = m_DedicatedQueueSubmissions.front();
+        if (m_pDedicatedQueues[Submission.QueueType]->GetCompletedFenceValue() < Submission.QueueFenceValue)
+        {
+            // Submissions are ordered by the graphics queue fence value, so the first
+            // incomplete submission limits the completed value
+            CompletedFenceValue = std::min(CompletedFenceValue, Submission.FenceValue - 1);
+            break;
+        }
+        m_DedicatedQueueSubmissions.pop_front();
+    }
+
+    return CompletedFenceValue;
 }
 
 
@@ -345,6 +502,7 @@ void RenderDeviceVkImpl::FinishFrame(bool ReleaseAllResources)
     ProcessStaleResources(SubmittedCmdBuffNumber, SubmittedFenceValue, CompletedFenceValue);
 
     m_DynamicHeapRingBuffer.FinishFrame(SubmittedFenceValue, CompletedFenceValue);
+    m_UploadBatcher.ReleaseCompletedBatches(CompletedFenceValue);
 
     Atomics::AtomicIncrement(m_FrameNumber);
 }
@@ -451,6 +609,32 @@ void RenderDeviceVkImpl::TestTextureFormat( TEXTURE_FORMAT TexFormat )
 
 IMPLEMENT_QUERY_INTERFACE( RenderDeviceVkImpl, IID_RenderDeviceVk, TRenderDeviceBase )
 
+void RenderDeviceVkImpl::GetPipelineCacheData(IDataBlob** ppData)
+{
+    VERIFY(ppData != nullptr && *ppData == nullptr, "Null pointer provided or overwriting reference to existing object may cause memory leaks");
+
+    size_t DataSize = 0;
+    auto err = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, nullptr);
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to get pipeline cache data size");
+        return;
+    }
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob( MakeNewRCObj<DataBlobImpl>()(DataSize) );
+    // The cache may have grown since the previous call if other threads are creating pipelines.
+    // In this case VK_INCOMPLETE is returned and as much data as fits is written, which is still
+    // a valid pipeline cache.
+    err = m_LogicalVkDevice->GetPipelineCacheData(m_PipelineCache, &DataSize, pDataBlob->GetDataPtr());
+    if (err != VK_SUCCESS && err != VK_INCOMPLETE)
+    {
+        LOG_ERROR_MESSAGE("Failed to get pipeline cache data");
+        return;
+    }
+    pDataBlob->Resize(DataSize);
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
 void RenderDeviceVkImpl::CreatePipelineState(const PipelineStateDesc &PipelineDesc, IPipelineState **ppPipelineState)
 {
     CreateDeviceObject("Pipeline State", PipelineDesc, ppPipelineState, 
@@ -50,12 +50,32 @@ VkRenderPass RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
         std::array<VkAttachmentReference,   MaxRenderTargets+1> AttachmentReferences;
         VkSubpassDescription                                    Subpass;
         auto RenderPassCI = PipelineStateVkImpl::GetRenderPassCreateInfo(Key.NumRenderTargets, Key.RTVFormats, Key.DSVFormat,
-                                                                         Key.SampleCount, Attachments, AttachmentReferences, Subpass);
+                                                                         Key.SampleCount, Attachments, AttachmentReferences, Subpass,
+                                                                         Key.RTVLoadOps, Key.RTVStoreOps,
+                                                                         Key.DSVLoadOp, Key.DSVStoreOp,
+                                                                         Key.StencilLoadOp, Key.StencilStoreOp);
+        auto LoadOpToChar = [](VkAttachmentLoadOp LoadOp)
+        {
+            return LoadOp == VK_ATTACHMENT_LOAD_OP_CLEAR ? 'C' : (LoadOp == VK_ATTACHMENT_LOAD_OP_DONT_CARE ? 'X' : 'L');
+        };
+        auto StoreOpToChar = [](VkAttachmentStoreOp StoreOp)
+        {
+            return StoreOp == VK_ATTACHMENT_STORE_OP_DONT_CARE ? 'X' : 'S';
+        };
         std::stringstream PassNameSS;
-        PassNameSS << "Render pass: rt count: " << Key.NumRenderTargets << "; sample count: "<< Key.SampleCount 
-                   << "; DSV Format: " << GetTextureFormatAttribs(Key.DSVFormat).Name << "; RTV Formats: ";
+        PassNameSS << "Render pass: rt count: " << Uint32{Key.NumRenderTargets} << "; sample count: "<< Uint32{Key.SampleCount} 
+                   << "; DSV Format: " << GetTextureFormatAttribs(Key.DSVFormat).Name;
+        if (Key.DSVFormat != TEX_FORMAT_UNKNOWN)
+        {
+            PassNameSS << " (" << LoadOpToChar(Key.DSVLoadOp) << StoreOpToChar(Key.DSVStoreOp) << '/'
+                       << LoadOpToChar(Key.StencilLoadOp) << StoreOpToChar(Key.StencilStoreOp) << ')';
+        }
+        PassNameSS << "; RTV Formats: ";
         for(Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
-            PassNameSS << (rt > 0 ? ", " : "") << GetTextureFormatAttribs(Key.RTVFormats[rt]).Name;
+        {
+            PassNameSS << (rt > 0 ? ", " : "") << GetTextureFormatAttribs(Key.RTVFormats[rt]).Name
+                       << " (" << LoadOpToChar(Key.RTVLoadOps[rt]) << StoreOpToChar(Key.RTVStoreOps[rt]) << ')';
+        }
         auto RenderPass = m_DeviceVkImpl.GetLogicalDevice().CreateRenderPass(RenderPassCI, PassNameSS.str().c_str());
         VERIFY_EXPR(RenderPass != VK_NULL_HANDLE);
         it = m_Cache.emplace(Key, std::move(RenderPass)).first;
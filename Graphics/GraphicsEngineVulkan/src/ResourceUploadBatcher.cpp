@@ -0,0 +1,331 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ResourceUploadBatcher.h"
+#include "RenderDeviceVkImpl.h"
+
+namespace Diligent
+{
+
+static VkDeviceSize GetStagingAlignment(const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice)
+{
+    // bufferOffset of a buffer-image copy must be a multiple of 4 and of the texel block size (18.4),
+    // which never exceeds 16 bytes for formats that can be initialized
+    const auto& Limits = PhysicalDevice.GetProperties().limits;
+    return std::max(Limits.optimalBufferCopyOffsetAlignment, VkDeviceSize{16});
+}
+
+ResourceUploadBatcher::ResourceUploadBatcher(IMemoryAllocator&   Allocator, 
+                                             RenderDeviceVkImpl& DeviceVk, 
+                                             Uint32              RingBufferSize,
+                                             Uint32              MaxBatchSize) :
+    m_DeviceVk    (DeviceVk),
+    m_RingBuffer  (RingBufferSize, Allocator),
+    m_Alignment   (GetStagingAlignment(DeviceVk.GetPhysicalDevice())),
+    m_MaxBatchSize(MaxBatchSize)
+{
+    VERIFY( (m_Alignment & (m_Alignment-1)) == 0, "Alignment must be a power of two");
+    if (RingBufferSize == 0)
+    {
+        LOG_INFO_MESSAGE("Upload ring buffer size is zero. Initial data of all resources will be staged in dedicated buffers");
+        return;
+    }
+    VERIFY( (RingBufferSize & (m_Alignment-1)) == 0, "Upload ring buffer size (", RingBufferSize, ") is not a multiple of the staging alignment (", m_Alignment, ")");
+
+    VkBufferCreateInfo VkBuffCI = {};
+    VkBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext = nullptr;
+    VkBuffCI.flags = 0;
+    VkBuffCI.size = RingBufferSize;
+    VkBuffCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    VkBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffCI.queueFamilyIndexCount = 0;
+    VkBuffCI.pQueueFamilyIndices = nullptr;
+
+    const auto& LogicalDevice = DeviceVk.GetLogicalDevice();
+    m_VkBuffer = LogicalDevice.CreateBuffer(VkBuffCI, "Upload ring buffer");
+    VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VkBuffer);
+
+    VkMemoryAllocateInfo MemAlloc = {};
+    MemAlloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    MemAlloc.pNext = nullptr;
+    MemAlloc.allocationSize = MemReqs.size;
+    // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges 
+    // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device (10.2)
+    MemAlloc.memoryTypeIndex = DeviceVk.GetPhysicalDevice().GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    VERIFY(MemAlloc.memoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex,
+           "Vulkan spec requires that for a VkBuffer not created with the "
+           "VK_BUFFER_CREATE_SPARSE_BINDING_BIT bit set, the memoryTypeBits member always contains at least one bit set "
+           "corresponding to a VkMemoryType with a propertyFlags that has both the VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT bit "
+           "and the VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit set(11.6)");
+    m_BufferMemory = LogicalDevice.AllocateDeviceMemory(MemAlloc, "Host-visible memory for upload ring buffer");
+
+    void* Data = nullptr;
+    auto err = LogicalDevice.MapMemory(m_BufferMemory,
+        0, // offset
+        MemAlloc.allocationSize,
+        0, // flags, reserved for future use
+        &Data);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to map upload ring buffer memory");
+    m_CPUAddress = reinterpret_cast<Uint8*>(Data);
+
+    err = LogicalDevice.BindBufferMemory(m_VkBuffer, m_BufferMemory, 0 /*offset*/);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind upload ring buffer memory");
+
+    LOG_INFO_MESSAGE("Upload ring buffer created. Total buffer size: ", FormatMemorySize(RingBufferSize, 2), ", max batch size: ", FormatMemorySize(MaxBatchSize, 2));
+}
+
+ResourceUploadBatcher::~ResourceUploadBatcher()
+{
+    VERIFY(m_VkBuffer == VK_NULL_HANDLE && m_BufferMemory == VK_NULL_HANDLE, "Vulkan resources must be explcitly released with Destroy()");
+    VERIFY(m_vkCmdBuff == VK_NULL_HANDLE, "Upload batch has not been submitted");
+    LOG_INFO_MESSAGE("Resource upload batcher stats: ", m_TotalUploads, " uploads in ", m_TotalBatches, " batches, ", 
+                     m_DedicatedStagingBuffers, " uploads required dedicated staging buffers");
+}
+
+void ResourceUploadBatcher::Destroy()
+{
+    std::lock_guard<std::mutex> Lock(m_BatchMtx);
+    VERIFY(m_vkCmdBuff == VK_NULL_HANDLE, "Upload batch must be submitted before the batcher is destroyed");
+    if (m_VkBuffer)
+    {
+        m_DeviceVk.GetLogicalDevice().UnmapMemory(m_BufferMemory);
+        m_DeviceVk.SafeReleaseVkObject(std::move(m_VkBuffer));
+        m_DeviceVk.SafeReleaseVkObject(std::move(m_BufferMemory));
+    }
+    m_CPUAddress = nullptr;
+    // Resources are released through the release queue, so the space can be reclaimed now
+    m_RingBuffer.ReleaseCompletedFrames(std::numeric_limits<Uint64>::max());
+}
+
+void ResourceUploadBatcher::EnsureCommandBuffer()
+{
+    if (m_vkCmdBuff == VK_NULL_HANDLE)
+    {
+        m_DeviceVk.AllocateTransientCmdPool(m_CmdPool, m_vkCmdBuff, "Transient command pool for resource upload batch");
+    }
+}
+
+bool ResourceUploadBatcher::AllocateStagingSpace(size_t Size, Upload& NewUpload)
+{
+    if (m_CPUAddress == nullptr || Size > m_RingBuffer.GetMaxSize())
+        return false;
+
+    auto Offset = m_RingBuffer.Allocate(Size);
+    if (Offset == RingBuffer::InvalidOffset)
+        return false;
+
+    NewUpload.m_vkStagingBuffer = m_VkBuffer;
+    NewUpload.m_StagingOffset   = Offset;
+    NewUpload.m_pStagingData    = m_CPUAddress + Offset;
+    return true;
+}
+
+void ResourceUploadBatcher::AllocateDedicatedStagingBuffer(size_t Size, const char* DebugName, Upload& NewUpload)
+{
+    const auto& LogicalDevice = m_DeviceVk.GetLogicalDevice();
+
+    VkBufferCreateInfo VkStaginBuffCI = {};
+    VkStaginBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkStaginBuffCI.pNext = nullptr;
+    VkStaginBuffCI.flags = 0;
+    VkStaginBuffCI.size = Size;
+    VkStaginBuffCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    VkStaginBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkStaginBuffCI.queueFamilyIndexCount = 0;
+    VkStaginBuffCI.pQueueFamilyIndices = nullptr;
+
+    std::string StagingBufferName = "Staging buffer for '";
+    StagingBufferName += DebugName != nullptr ? DebugName : "";
+    StagingBufferName += '\'';
+    NewUpload.m_DedicatedStagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
+
+    VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(NewUpload.m_DedicatedStagingBuffer);
+    NewUpload.m_DedicatedStagingMemory = m_DeviceVk.AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (NewUpload.m_DedicatedStagingMemory.Page == nullptr)
+        LOG_ERROR_AND_THROW("Failed to allocate staging memory for '", DebugName, '\'');
+    auto StagingBufferMemory = NewUpload.m_DedicatedStagingMemory.Page->GetVkMemory();
+    auto AlignedStagingMemOffset = NewUpload.m_DedicatedStagingMemory.Offset;
+    VERIFY_EXPR(AlignedStagingMemOffset % StagingBufferMemReqs.alignment == 0);
+
+    auto* StagingData = reinterpret_cast<Uint8*>(NewUpload.m_DedicatedStagingMemory.Page->GetCPUMemory());
+    if (StagingData == nullptr)
+        LOG_ERROR_AND_THROW("Failed to allocate staging data for '", DebugName, '\'');
+
+    auto err = LogicalDevice.BindBufferMemory(NewUpload.m_DedicatedStagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
+
+    NewUpload.m_vkStagingBuffer = NewUpload.m_DedicatedStagingBuffer;
+    NewUpload.m_StagingOffset   = 0;
+    NewUpload.m_pStagingData    = StagingData + AlignedStagingMemOffset;
+}
+
+ResourceUploadBatcher::Upload ResourceUploadBatcher::BeginUpload(size_t StagingDataSize, const char* DebugName)
+{
+    Upload NewUpload(*this);
+    bool UseDedicatedStagingBuffer = false;
+    {
+        // Only reserve the staging space and the command buffer under the lock
+        std::unique_lock<std::mutex> Lock(m_BatchMtx);
+        if (StagingDataSize != 0)
+        {
+            auto AlignedSize = (StagingDataSize + (m_Alignment-1)) & ~(m_Alignment-1);
+            if (!AllocateStagingSpace(AlignedSize, NewUpload) && m_CPUAddress != nullptr && AlignedSize <= m_RingBuffer.GetMaxSize())
+            {
+                // The ring buffer is full. Submit the pending batch that holds part of the space, release
+                // space of the completed batches and try again. The batch mutex must be released as the 
+                // command queue mutex must always be acquired first.
+                Lock.unlock();
+                m_DeviceVk.FlushUploadBatch();
+                Lock.lock();
+                m_RingBuffer.ReleaseCompletedFrames(m_DeviceVk.GetCompletedFenceValue());
+                AllocateStagingSpace(AlignedSize, NewUpload);
+            }
+
+            // If there is still not enough space in the ring buffer, do not wait for the GPU and use dedicated staging buffer
+            UseDedicatedStagingBuffer = NewUpload.m_pStagingData == nullptr;
+            if (UseDedicatedStagingBuffer)
+                ++m_DedicatedStagingBuffers;
+
+            m_CurrBatchSize += AlignedSize;
+        }
+
+        EnsureCommandBuffer();
+        NewUpload.m_vkCmdBuff = m_vkCmdBuff;
+        NewUpload.m_pBatcher  = this;
+        ++m_NumActiveUploads;
+        ++m_CurrBatchUploads;
+        ++m_TotalUploads;
+    }
+
+    // The batch cannot be submitted until the upload is finished, so the 
+    // dedicated buffer can be created without holding the lock
+    if (UseDedicatedStagingBuffer)
+        AllocateDedicatedStagingBuffer(StagingDataSize, DebugName, NewUpload);
+
+    return NewUpload;
+}
+
+void ResourceUploadBatcher::EndUpload(Upload& FinishedUpload)
+{
+    // The upload may be destroyed without recording any commands if an exception was thrown
+    if (!FinishedUpload.m_Lock.owns_lock())
+        FinishedUpload.m_Lock = std::unique_lock<std::mutex>{m_BatchMtx};
+
+    if (FinishedUpload.m_DedicatedStagingBuffer != VK_NULL_HANDLE)
+    {
+        // The batch is always submitted before the command buffer with the current number (see LockBatch()), 
+        // so the resources will not be released until the copy commands are complete
+        m_DeviceVk.SafeReleaseVkObject(std::move(FinishedUpload.m_DedicatedStagingBuffer));
+        m_DeviceVk.SafeReleaseVkObject(std::move(FinishedUpload.m_DedicatedStagingMemory));
+    }
+
+    VERIFY_EXPR(m_NumActiveUploads > 0);
+    --m_NumActiveUploads;
+    bool SubmitBatch = m_CurrBatchSize >= m_MaxBatchSize;
+    FinishedUpload.m_Lock.unlock();
+    m_UploadsFinishedCV.notify_all();
+
+    if (SubmitBatch)
+        m_DeviceVk.FlushUploadBatch();
+}
+
+Uint64 ResourceUploadBatcher::SubmitPendingBatch(ICommandQueueVk& CmdQueue, std::unique_lock<std::mutex>& BatchLock)
+{
+    VERIFY(BatchLock.owns_lock() && BatchLock.mutex() == &m_BatchMtx, "The batch must be locked by the caller");
+    // Uploads that have reserved staging space in the batch must record their commands before it is submitted.
+    // Otherwise their staging space would be released with the fence value of this batch
+    m_UploadsFinishedCV.wait(BatchLock, [this]{return m_NumActiveUploads == 0;});
+    if (m_vkCmdBuff == VK_NULL_HANDLE)
+        return 0;
+
+    auto err = vkEndCommandBuffer(m_vkCmdBuff);
+    VERIFY(err == VK_SUCCESS, "Failed to end command buffer");
+
+    VkSubmitInfo SubmitInfo = {};
+    SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    SubmitInfo.commandBufferCount = 1;
+    SubmitInfo.pCommandBuffers = &m_vkCmdBuff;
+
+    // Host writes to the staging memory are made visible to the device by the 
+    // submission itself, so no additional barrier is required (6.9)
+    auto NextFenceValue = CmdQueue.GetNextFenceValue();
+    auto SubmittedFenceValue = CmdQueue.ExecuteCommandBuffer(SubmitInfo);
+    VERIFY(SubmittedFenceValue >= NextFenceValue, "Fence value of the executed command buffer is less than the next fence value previously queried through GetNextFenceValue()");
+    SubmittedFenceValue = std::max(SubmittedFenceValue, NextFenceValue);
+
+    // Staging space of the batch can be reused once the fence value is reached
+    m_RingBuffer.FinishCurrentFrame(SubmittedFenceValue);
+    m_DeviceVk.DisposeTransientCmdPool(std::move(m_CmdPool), SubmittedFenceValue);
+    m_vkCmdBuff        = VK_NULL_HANDLE;
+    m_CurrBatchSize    = 0;
+    m_CurrBatchUploads = 0;
+    ++m_TotalBatches;
+
+    return SubmittedFenceValue;
+}
+
+void ResourceUploadBatcher::ReleaseCompletedBatches(Uint64 CompletedFenceValue)
+{
+    std::lock_guard<std::mutex> Lock(m_BatchMtx);
+    m_RingBuffer.ReleaseCompletedFrames(CompletedFenceValue);
+}
+
+
+ResourceUploadBatcher::Upload::Upload(ResourceUploadBatcher& Batcher) :
+    m_Lock(Batcher.m_BatchMtx, std::defer_lock)
+{
+}
+
+VkCommandBuffer ResourceUploadBatcher::Upload::LockCmdBuffer()
+{
+    VERIFY(!m_Lock.owns_lock(), "The command buffer is already locked");
+    m_Lock.lock();
+    return m_vkCmdBuff;
+}
+
+ResourceUploadBatcher::Upload::Upload(Upload&& rhs)noexcept :
+    m_pBatcher              (rhs.m_pBatcher),
+    m_Lock                  (std::move(rhs.m_Lock)),
+    m_vkCmdBuff             (rhs.m_vkCmdBuff),
+    m_vkStagingBuffer       (rhs.m_vkStagingBuffer),
+    m_StagingOffset         (rhs.m_StagingOffset),
+    m_pStagingData          (rhs.m_pStagingData),
+    m_DedicatedStagingBuffer(std::move(rhs.m_DedicatedStagingBuffer)),
+    m_DedicatedStagingMemory(std::move(rhs.m_DedicatedStagingMemory))
+{
+    rhs.m_pBatcher        = nullptr;
+    rhs.m_vkCmdBuff       = VK_NULL_HANDLE;
+    rhs.m_vkStagingBuffer = VK_NULL_HANDLE;
+    rhs.m_StagingOffset   = 0;
+    rhs.m_pStagingData    = nullptr;
+}
+
+ResourceUploadBatcher::Upload::~Upload()
+{
+    if (m_pBatcher != nullptr)
+        m_pBatcher->EndUpload(*this);
+}
+
+}
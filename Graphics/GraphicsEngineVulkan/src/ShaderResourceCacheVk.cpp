@@ -330,6 +330,51 @@ VkDescriptorImageInfo ShaderResourceCacheVk::Resource::GetSamplerDescriptorWrite
     return DescrImgInfo;
 }
 
+void ShaderResourceCacheVk::Resource::GetDescriptorObjectIds(std::vector<UniqueIdentifier>& Ids)const
+{
+    if (!pObject)
+    {
+        // Unique identifiers start from 1
+        Ids.push_back(0);
+        return;
+    }
+
+    switch(Type)
+    {
+        case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+            Ids.push_back(pObject.RawPtr<const BufferVkImpl>()->GetUniqueID());
+        break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::StorageBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+        case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+            Ids.push_back(pObject.RawPtr<const BufferViewVkImpl>()->GetUniqueID());
+        break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+        {
+            // Sampler is taken from the texture view and may be changed independently
+            auto* pTexViewVk = pObject.RawPtr<const TextureViewVkImpl>();
+            Ids.push_back(pTexViewVk->GetUniqueID());
+            auto* pSamplerVk = ValidatedCast<const SamplerVkImpl>(pTexViewVk->GetSampler());
+            Ids.push_back(pSamplerVk != nullptr ? pSamplerVk->GetUniqueID() : 0);
+        }
+        break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+        case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+            Ids.push_back(pObject.RawPtr<const TextureViewVkImpl>()->GetUniqueID());
+        break;
+
+        case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+            Ids.push_back(pObject.RawPtr<const SamplerVkImpl>()->GetUniqueID());
+        break;
+
+        default:
+            Ids.push_back(0);
+    }
+}
+
 Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(Uint32 CtxId, std::vector<uint32_t>& Offsets)const
 {
     // If any of the sets being bound include dynamic uniform or storage buffers, then 
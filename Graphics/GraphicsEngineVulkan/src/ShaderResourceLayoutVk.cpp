@@ -731,6 +731,78 @@ void ShaderResourceLayoutVk::InitializeResourceMemoryInCache(ShaderResourceCache
     }
 }
 
+void ShaderResourceLayoutVk::GetDynamicResourceObjectIds(const ShaderResourceCacheVk&   ResourceCache,
+                                                         std::vector<UniqueIdentifier>& Ids)const
+{
+    Uint32 NumDynamicResources = m_NumResources[SHADER_VARIABLE_TYPE_DYNAMIC];
+    for(Uint32 r = 0; r < NumDynamicResources; ++r)
+    {
+        const auto& Res = GetResource(SHADER_VARIABLE_TYPE_DYNAMIC, r);
+        const auto& SetResources = ResourceCache.GetDescriptorSet(Res.DescriptorSet);
+        for(Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+            SetResources.GetResource(Res.CacheOffset + ArrElem).GetDescriptorObjectIds(Ids);
+    }
+}
+
+void ShaderResourceLayoutVk::GetDynamicDescriptorData(const ShaderResourceCacheVk&           ResourceCache,
+                                                      ShaderResourceCacheVk::DescriptorData* pDescriptorData)const
+{
+    Uint32 NumDynamicResources = m_NumResources[SHADER_VARIABLE_TYPE_DYNAMIC];
+    VERIFY(NumDynamicResources != 0, "This shader resource layout does not contain dynamic resources");
+    VERIFY_EXPR(pDescriptorData != nullptr);
+
+    for(Uint32 r = 0; r < NumDynamicResources; ++r)
+    {
+        const auto& Res = GetResource(SHADER_VARIABLE_TYPE_DYNAMIC, r);
+        VERIFY_EXPR(Res.SpirvAttribs.VarType == SHADER_VARIABLE_TYPE_DYNAMIC);
+        const auto& SetResources = ResourceCache.GetDescriptorSet(Res.DescriptorSet);
+        VERIFY(SetResources.GetVkDescriptorSet() == VK_NULL_HANDLE, "Dynamic descriptor set must not be assigned to the resource cache");
+        auto* pResData = pDescriptorData + Res.CacheOffset;
+        switch(Res.SpirvAttribs.Type)
+        {
+            case SPIRVShaderResourceAttribs::ResourceType::UniformBuffer:
+                for(Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+                    pResData[ArrElem].BufferInfo = SetResources.GetResource(Res.CacheOffset + ArrElem).GetUniformBufferDescriptorWriteInfo();
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::StorageBuffer:
+                for(Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+                    pResData[ArrElem].BufferInfo = SetResources.GetResource(Res.CacheOffset + ArrElem).GetStorageBufferDescriptorWriteInfo();
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer:
+            case SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer:
+                for(Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+                    pResData[ArrElem].TexelBufferView = SetResources.GetResource(Res.CacheOffset + ArrElem).GetBufferViewWriteInfo();
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SeparateImage:
+            case SPIRVShaderResourceAttribs::ResourceType::StorageImage:
+            case SPIRVShaderResourceAttribs::ResourceType::SampledImage:
+                for(Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+                    pResData[ArrElem].ImageInfo = SetResources.GetResource(Res.CacheOffset + ArrElem).GetImageDescriptorWriteInfo(Res.SpirvAttribs.StaticSamplerInd >= 0);
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::AtomicCounter:
+                // Do nothing
+            break;
+
+            case SPIRVShaderResourceAttribs::ResourceType::SeparateSampler:
+                // Immutable samplers are not written to the descriptor set, and the update 
+                // template contains no entries for them
+                if(Res.SpirvAttribs.StaticSamplerInd < 0)
+                {
+                    for(Uint32 ArrElem = 0; ArrElem < Res.SpirvAttribs.ArraySize; ++ArrElem)
+                        pResData[ArrElem].ImageInfo = SetResources.GetResource(Res.CacheOffset + ArrElem).GetSamplerDescriptorWriteInfo();
+                }
+            break;
+
+            default:
+                UNEXPECTED("Unexpected resource type");
+        }
+    }
+}
+
 void ShaderResourceLayoutVk::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache, 
                                                     VkDescriptorSet              vkDynamicDescriptorSet)const
 {
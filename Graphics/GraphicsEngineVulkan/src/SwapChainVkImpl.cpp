@@ -80,6 +80,10 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*    pRefCounters,
     surfaceCreateInfo.connection = connection;
     surfaceCreateInfo.window = window;
     auto err = vkCreateXcbSurfaceKHR(instance, &surfaceCreateInfo, nullptr, &m_VkSurface);
+#else
+    // No window system integration is enabled on this platform. Use headless mode 
+    // (EngineVkAttribs::Headless) to render into textures instead
+    VkResult err = VK_ERROR_EXTENSION_NOT_PRESENT;
 #endif
 
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create OS-specific surface");
@@ -25,6 +25,7 @@
 #include "TextureVkImpl.h"
 #include "RenderDeviceVkImpl.h"
 #include "DeviceContextVkImpl.h"
+#include "BufferVkImpl.h"
 #include "VulkanTypeConversions.h"
 #include "TextureViewVkImpl.h"
 #include "VulkanTypeConversions.h"
@@ -129,6 +130,17 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
     ImageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     ImageCI.queueFamilyIndexCount = 0;
     ImageCI.pQueueFamilyIndices = nullptr;
+    // Initial data is uploaded by the graphics queue
+    uint32_t QueueFamilyIndices[COMMAND_QUEUE_TYPE_NUM_TYPES];
+    auto NumQueueFamilies = pRenderDeviceVk->GetQueueFamilyIndices(m_Desc.CommandQueueFlags | COMMAND_QUEUE_FLAG_GRAPHICS, QueueFamilyIndices);
+    if (NumQueueFamilies > 1)
+    {
+        // The engine does not transfer queue family ownership, so images 
+        // accessed by several queue families must be shared between them
+        ImageCI.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        ImageCI.queueFamilyIndexCount = NumQueueFamilies;
+        ImageCI.pQueueFamilyIndices = QueueFamilyIndices;
+    }
 
     // initialLayout must be either VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED (11.4)
     // If it is VK_IMAGE_LAYOUT_PREINITIALIZED, then the image data can be preinitialized by the host 
@@ -151,19 +163,15 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
         ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
     m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
-    auto AlignedOffset = (m_MemoryAllocation.UnalignedOffset + (MemReqs.alignment-1)) & ~(MemReqs.alignment-1);
+    if (m_MemoryAllocation.Page == nullptr)
+        LOG_ERROR_AND_THROW("Failed to allocate memory for texture '", m_Desc.Name, '\'');
+    auto AlignedOffset = m_MemoryAllocation.Offset;
+    VERIFY_EXPR(AlignedOffset % MemReqs.alignment == 0);
     auto Memory = m_MemoryAllocation.Page->GetVkMemory();
     auto err = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
 
     
-    // Vulkan validation layers do not like uninitialized memory, so if no initial data
-    // is provided, we will clear the memory
-
-    VulkanUtilities::CommandPoolWrapper CmdPool;
-    VkCommandBuffer vkCmdBuff;
-    pRenderDeviceVk->AllocateTransientCmdPool(CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
     VkImageAspectFlags aspectMask = 0;
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
         aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -179,26 +187,18 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
     else
         aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 
-    // For either clear or copy command, dst layout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-    VkImageSubresourceRange SubresRange;
-    SubresRange.aspectMask = aspectMask;
-    SubresRange.baseArrayLayer = 0;
-    SubresRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
-    SubresRange.baseMipLevel = 0;
-    SubresRange.levelCount = VK_REMAINING_MIP_LEVELS;
-    VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, m_CurrentLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange);
-    m_CurrentLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
+    std::vector<VkBufferImageCopy> Regions;
+    Uint64 uploadBufferSize = 0;
+    // For block-compression formats, this is the size of the compressed block
+    auto TexelSize = GetTexelBlockSize(FmtAttribs);
     if(bInitializeTexture)
     {
         Uint32 ExpectedNumSubresources = ImageCI.mipLevels * ImageCI.arrayLayers;
         if( InitData.NumSubresources != ExpectedNumSubresources )
             LOG_ERROR_AND_THROW("Incorrect number of subresources in init data. ", ExpectedNumSubresources, " expected, while ", InitData.NumSubresources, " provided");
 
-        std::vector<VkBufferImageCopy> Regions(InitData.NumSubresources);
+        Regions.resize(InitData.NumSubresources);
 
-        UINT64 uploadBufferSize = 0;
-        auto TexelSize = FmtAttribs.ComponentSize * FmtAttribs.NumComponents;
         Uint32 subres = 0;
         for(Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
         {
@@ -211,7 +211,7 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
                 auto MipHeight = std::max(m_Desc.Height >> mip, 1u);
                 auto MipDepth  = (m_Desc.Type == RESOURCE_DIM_TEX_3D) ? std::max(m_Desc.Depth >> mip, 1u) : 1u;
                 
-                CopyRegion.bufferOffset = uploadBufferSize; // offset in bytes from the start of the buffer object
+                CopyRegion.bufferOffset = uploadBufferSize; // offset in bytes from the start of the staging space
                 // bufferRowLength and bufferImageHeight specify the data in buffer memory as a subregion 
                 // of a larger two- or three-dimensional image, and control the addressing calculations of 
                 // data in buffer memory. If either of these values is zero, that aspect of the buffer memory 
@@ -246,122 +246,112 @@ TextureVkImpl :: TextureVkImpl(IReferenceCounters*          pRefCounters,
             }
         }
         VERIFY_EXPR(subres == InitData.NumSubresources);
+    }
 
-        VkBufferCreateInfo VkStaginBuffCI = {};
-        VkStaginBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        VkStaginBuffCI.pNext = nullptr;
-        VkStaginBuffCI.flags = 0;
-        VkStaginBuffCI.size = uploadBufferSize;
-        VkStaginBuffCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        VkStaginBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        VkStaginBuffCI.queueFamilyIndexCount = 0;
-        VkStaginBuffCI.pQueueFamilyIndices = nullptr;
-
-        std::string StagingBufferName = "Staging buffer for '";
-        StagingBufferName += m_Desc.Name;
-        StagingBufferName += '\'';
-        VulkanUtilities::BufferWrapper StagingBuffer = LogicalDevice.CreateBuffer(VkStaginBuffCI, StagingBufferName.c_str());
-
-        VkMemoryRequirements StagingBufferMemReqs = LogicalDevice.GetBufferMemoryRequirements(StagingBuffer);
-        // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges 
-        // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
-        // to the host (10.2)
-        auto StagingMemoryAllocation = pRenderDeviceVk->AllocateMemory(StagingBufferMemReqs, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-        auto StagingBufferMemory = StagingMemoryAllocation.Page->GetVkMemory();
-        auto AlignedStagingMemOffset = (StagingMemoryAllocation.UnalignedOffset + (StagingBufferMemReqs.alignment-1)) & ~(StagingBufferMemReqs.alignment-1);
-
-        auto *StagingData = reinterpret_cast<uint8_t*>(StagingMemoryAllocation.Page->GetCPUMemory());
-        VERIFY_EXPR(StagingData != nullptr);
-        StagingData += AlignedStagingMemOffset;
-
-        subres = 0;
-        for(Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
+    {
+        // Vulkan validation layers do not like uninitialized memory, so if no initial data
+        // is provided, we will clear the memory.
+        // All commands are recorded into the shared upload batch that is submitted before 
+        // the next command buffer, so that creating many resources does not require as many submits
+        auto Upload = pRenderDeviceVk->GetUploadBatcher().BeginUpload(static_cast<size_t>(uploadBufferSize), m_Desc.Name);
+
+        if(bInitializeTexture)
         {
-            for(Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
-            {
-                const auto &SubResData = InitData.pSubResources[subres];
-                const auto &CopyRegion = Regions[subres];
+            auto* StagingData = Upload.GetStagingData();
+            VERIFY_EXPR(StagingData != nullptr);
 
-                auto MipWidth  = CopyRegion.imageExtent.width;
-                auto MipHeight = CopyRegion.imageExtent.height;
-                auto MipDepth  = CopyRegion.imageExtent.depth;
-                if(FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+            Uint32 subres = 0;
+            for(Uint32 layer = 0; layer < ImageCI.arrayLayers; ++layer)
+            {
+                for(Uint32 mip = 0; mip < ImageCI.mipLevels; ++mip)
                 {
-                    VERIFY_EXPR(FmtAttribs.BlockWidth > 1 && FmtAttribs.BlockHeight > 1);
-                    MipWidth = (MipWidth + FmtAttribs.BlockWidth-1) / FmtAttribs.BlockWidth;
-                    MipHeight = (MipHeight + FmtAttribs.BlockHeight-1) / FmtAttribs.BlockHeight;
-                }
-                VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipWidth * TexelSize, "Stride is too small");
-                VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= MipWidth * MipHeight * TexelSize, "Depth stride is too small");
+                    const auto &SubResData = InitData.pSubResources[subres];
+                    auto &CopyRegion = Regions[subres];
 
-                for(Uint32 z=0; z < MipDepth; ++z)
-                {
-                    for(Uint32 y=0; y < MipHeight; ++y)
+                    auto MipWidth  = CopyRegion.imageExtent.width;
+                    auto MipHeight = CopyRegion.imageExtent.height;
+                    auto MipDepth  = CopyRegion.imageExtent.depth;
+                    if(FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+                    {
+                        VERIFY_EXPR(FmtAttribs.BlockWidth > 1 && FmtAttribs.BlockHeight > 1);
+                        MipWidth = (MipWidth + FmtAttribs.BlockWidth-1) / FmtAttribs.BlockWidth;
+                        MipHeight = (MipHeight + FmtAttribs.BlockHeight-1) / FmtAttribs.BlockHeight;
+                    }
+                    VERIFY(SubResData.Stride == 0 || SubResData.Stride >= MipWidth * TexelSize, "Stride is too small");
+                    VERIFY(SubResData.DepthStride == 0 || SubResData.DepthStride >= MipWidth * MipHeight * TexelSize, "Depth stride is too small");
+
+                    for(Uint32 z=0; z < MipDepth; ++z)
                     {
-                        memcpy(StagingData + CopyRegion.bufferOffset + (y + z * MipHeight) * MipWidth * TexelSize,
-                               reinterpret_cast<const uint8_t*>(SubResData.pData) + y * SubResData.Stride + z * SubResData.DepthStride,
-                               MipWidth * TexelSize);
+                        for(Uint32 y=0; y < MipHeight; ++y)
+                        {
+                            memcpy(StagingData + CopyRegion.bufferOffset + (y + z * MipHeight) * MipWidth * TexelSize,
+                                   reinterpret_cast<const uint8_t*>(SubResData.pData) + y * SubResData.Stride + z * SubResData.DepthStride,
+                                   MipWidth * TexelSize);
+                        }
                     }
+
+                    // Region offsets were computed relative to the start of the staging space
+                    CopyRegion.bufferOffset += Upload.GetStagingOffset();
+                    ++subres;
                 }
-               
-                ++subres;
             }
+            VERIFY_EXPR(subres == InitData.NumSubresources);
         }
-        VERIFY_EXPR(subres == InitData.NumSubresources);
-
-        err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging bufer memory");
-
-        VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT);
 
-        // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-        // as copy will be the only command in the cmd buffer
-        vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
-            m_CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-            static_cast<uint32_t>(Regions.size()), Regions.data());
+        // Commands are recorded into the command buffer shared by all uploads, which
+        // requires exclusive access to the batch
+        auto vkCmdBuff = Upload.LockCmdBuffer();
 
-	    pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(vkCmdBuff, std::move(CmdPool));
+        // For either clear or copy command, dst layout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+        VkImageSubresourceRange SubresRange;
+        SubresRange.aspectMask = aspectMask;
+        SubresRange.baseArrayLayer = 0;
+        SubresRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        SubresRange.baseMipLevel = 0;
+        SubresRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, m_CurrentLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange);
+        m_CurrentLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 
-        // After command buffer is submitted, safe-release resources. This strategy
-        // is little overconservative as the resources will be released after the first
-        // command buffer submitted through the immediate context will be completed
-        pRenderDeviceVk->SafeReleaseVkObject(std::move(StagingBuffer));
-        pRenderDeviceVk->SafeReleaseVkObject(std::move(StagingMemoryAllocation));
-    }
-    else
-    {
-        VkImageSubresourceRange Subresource;
-        Subresource.aspectMask     = aspectMask;
-        Subresource.baseMipLevel   = 0;
-        Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
-        Subresource.baseArrayLayer = 0;
-        Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
-        if(aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
-        {
-            if(FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
-            {
-                VkClearColorValue ClearColor = {};
-                vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
-                                m_CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                                &ClearColor, 1, &Subresource);
-            }
-        }
-        else if(aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT || 
-                aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
+        if(bInitializeTexture)
         {
-            VkClearDepthStencilValue ClearValue = {};
-            vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
-                            m_CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
-                            &ClearValue, 1, &Subresource);
+            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+            // as the upload batch never contains render passes
+            vkCmdCopyBufferToImage(vkCmdBuff, Upload.GetStagingBuffer(), m_VulkanImage,
+                m_CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                static_cast<uint32_t>(Regions.size()), Regions.data());
         }
         else
         {
-            UNEXPECTED("Unexpected aspect mask");
+            VkImageSubresourceRange Subresource;
+            Subresource.aspectMask     = aspectMask;
+            Subresource.baseMipLevel   = 0;
+            Subresource.levelCount     = VK_REMAINING_MIP_LEVELS;
+            Subresource.baseArrayLayer = 0;
+            Subresource.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+            if(aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+            {
+                if(FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+                {
+                    VkClearColorValue ClearColor = {};
+                    vkCmdClearColorImage(vkCmdBuff, m_VulkanImage,
+                                    m_CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                    &ClearColor, 1, &Subresource);
+                }
+            }
+            else if(aspectMask == VK_IMAGE_ASPECT_DEPTH_BIT || 
+                    aspectMask == (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) )
+            {
+                VkClearDepthStencilValue ClearValue = {};
+                vkCmdClearDepthStencilImage(vkCmdBuff, m_VulkanImage,
+                                m_CurrentLayout, // must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+                                &ClearValue, 1, &Subresource);
+            }
+            else
+            {
+                UNEXPECTED("Unexpected aspect mask");
+            }
         }
-        pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(vkCmdBuff, std::move(CmdPool));
     }
-
-
     if(m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS)
     {
         if (m_Desc.Type != RESOURCE_DIM_TEX_2D && m_Desc.Type != RESOURCE_DIM_TEX_2D_ARRAY)
@@ -480,13 +470,9 @@ void TextureVkImpl::UpdateData( IDeviceContext *pContext, Uint32 MipLevel, Uint3
 
     VERIFY( m_Desc.Usage == USAGE_DEFAULT, "Only default usage resources can be updated with UpdateData()" );
 
-#if 0
     auto *pCtxVk = ValidatedCast<DeviceContextVkImpl>(pContext);
-
-    auto DstSubResIndex = VkCalcSubresource(MipLevel, Slice, 0, m_Desc.MipLevels, m_Desc.ArraySize);
- 
-    pCtxVk->CopyTextureRegion(SubresData.pSrcBuffer, SubresData.Stride, SubresData.DepthStride, this, DstSubResIndex, DstBox);
-#endif
+    auto *pSrcBufferVk = ValidatedCast<BufferVkImpl>(SubresData.pSrcBuffer);
+    pCtxVk->CopyTextureRegion(pSrcBufferVk, SubresData.Stride, SubresData.DepthStride, this, MipLevel, Slice, DstBox);
 }
 
 void TextureVkImpl ::  CopyData(IDeviceContext* pContext, 
@@ -30,6 +30,14 @@
 namespace Diligent
 {
 
+template<typename T>
+static void UpdatePeakValue(std::atomic<T>& Peak, T Value)
+{
+    auto CurrPeak = Peak.load(std::memory_order_relaxed);
+    while (CurrPeak < Value && !Peak.compare_exchange_weak(CurrPeak, Value, std::memory_order_relaxed))
+        ;
+}
+
 static VkDeviceSize GetDefaultAlignment(const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice)
 {
     const auto& Props = PhysicalDevice.GetProperties();
@@ -57,9 +65,11 @@ VulkanRingBuffer::VulkanRingBuffer(IMemoryAllocator&    Allocator,
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT    | 
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT   | 
         VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
-    VkBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    VkBuffCI.queueFamilyIndexCount = 0;
-    VkBuffCI.pQueueFamilyIndices = nullptr;
+    // The heap is shared by all contexts, which may use dedicated compute and transfer queues
+    const auto& QueueFamilyIndices = DeviceVk.GetQueueFamilyIndices();
+    VkBuffCI.sharingMode = QueueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffCI.queueFamilyIndexCount = QueueFamilyIndices.size() > 1 ? static_cast<uint32_t>(QueueFamilyIndices.size()) : 0;
+    VkBuffCI.pQueueFamilyIndices = QueueFamilyIndices.size() > 1 ? QueueFamilyIndices.data() : nullptr;
 
     const auto& LogicalDevice = DeviceVk.GetLogicalDevice();
     m_VkBuffer = LogicalDevice.CreateBuffer(VkBuffCI, "Dynamic heap buffer");
@@ -116,25 +126,25 @@ VulkanRingBuffer::~VulkanRingBuffer()
     VERIFY(m_BufferMemory == VK_NULL_HANDLE && m_VkBuffer == VK_NULL_HANDLE, "Vulkan resources must be explcitly released with Destroy()");
     LOG_INFO_MESSAGE("Dynamic heap ring buffer usage stats:\n"
                      "    Total size: ", FormatMemorySize(m_RingBuffer.GetMaxSize(), 2),
-                     ". Peak allocated size: ", FormatMemorySize(m_TotalPeakSize, 2, m_RingBuffer.GetMaxSize()),
-                     ". Peak frame size: ", FormatMemorySize(m_FramePeakSize, 2, m_RingBuffer.GetMaxSize()),
-                     ". Peak utilization: ", std::fixed, std::setprecision(1), static_cast<double>(m_TotalPeakSize) / static_cast<double>(std::max(m_RingBuffer.GetMaxSize(), size_t{1})) * 100.0, '%' );
+                     ". Peak allocated size: ", FormatMemorySize(m_TotalPeakSize.load(), 2, m_RingBuffer.GetMaxSize()),
+                     ". Peak frame size: ", FormatMemorySize(m_FramePeakSize.load(), 2, m_RingBuffer.GetMaxSize()),
+                     ". Peak utilization: ", std::fixed, std::setprecision(1), static_cast<double>(m_TotalPeakSize.load()) / static_cast<double>(std::max(m_RingBuffer.GetMaxSize(), size_t{1})) * 100.0, '%' );
 }
 
-RingBuffer::OffsetType VulkanRingBuffer::Allocate(size_t SizeInBytes)
+ConcurrentRingBuffer::OffsetType VulkanRingBuffer::Allocate(size_t SizeInBytes)
 {
     VERIFY( (SizeInBytes & (MinAlignment-1)) == 0, "Allocation size is not minimally aligned" );
     
     if (SizeInBytes > m_RingBuffer.GetMaxSize())
     {
         LOG_ERROR("Requested dynamic allocation size ", SizeInBytes, " exceeds maximum ring buffer size ", m_RingBuffer.GetMaxSize(), ". The app should increase dynamic heap size.");
-        return RingBuffer::InvalidOffset;
+        return ConcurrentRingBuffer::InvalidOffset;
     }
     
-    std::lock_guard<std::mutex> Lock(m_RingBuffMtx);
-    RingBuffer::OffsetType Offset = m_RingBuffer.Allocate(SizeInBytes);
-    if(Offset == RingBuffer::InvalidOffset)
+    ConcurrentRingBuffer::OffsetType Offset = m_RingBuffer.Allocate(SizeInBytes);
+    if(Offset == ConcurrentRingBuffer::InvalidOffset)
     {
+        std::lock_guard<std::mutex> Lock(m_FramesMtx);
         // Failed to allocate space in the ring buffer. Try to wait for GPU to finish pening frames
         // to release some space
         auto StartIdleTime = std::chrono::high_resolution_clock::now();
@@ -142,13 +152,13 @@ RingBuffer::OffsetType VulkanRingBuffer::Allocate(size_t SizeInBytes)
         static constexpr const auto MaxIdleDuration = std::chrono::duration<double>{60.0 / 1000.0}; // 60 ms
         std::chrono::duration<double> IdleDuration;
         Uint32 SleepIterations = 0;
-        while(Offset == RingBuffer::InvalidOffset && IdleDuration < MaxIdleDuration)
+        while(Offset == ConcurrentRingBuffer::InvalidOffset && IdleDuration < MaxIdleDuration)
         {
             auto LastCompletedFenceValue = m_DeviceVk.GetCompletedFenceValue();
             m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
 
             Offset = m_RingBuffer.Allocate(SizeInBytes);
-            if (Offset == RingBuffer::InvalidOffset)
+            if (Offset == ConcurrentRingBuffer::InvalidOffset)
             {
                 std::this_thread::sleep_for(SleepPeriod);
                 ++SleepIterations;
@@ -158,7 +168,7 @@ RingBuffer::OffsetType VulkanRingBuffer::Allocate(size_t SizeInBytes)
             IdleDuration = std::chrono::duration_cast<std::chrono::duration<double>>(CurrTime - StartIdleTime);
         }
 
-        if(Offset == RingBuffer::InvalidOffset)
+        if(Offset == ConcurrentRingBuffer::InvalidOffset)
         {
             LOG_ERROR_MESSAGE("Space in dynamic heap is exausted! After idling for ", std::fixed, std::setprecision(1), IdleDuration.count()*1000.0, " ms still no space is available. Increase the size of the ring buffer by setting EngineVkAttribs::DynamicHeapSize to a greater value or optimize dynamic resource usage");
         }
@@ -175,11 +185,11 @@ RingBuffer::OffsetType VulkanRingBuffer::Allocate(size_t SizeInBytes)
         }
     }
 
-    if (Offset != RingBuffer::InvalidOffset)
+    if (Offset != ConcurrentRingBuffer::InvalidOffset)
     {
-        m_CurrentFrameSize += SizeInBytes;
-        m_FramePeakSize = std::max(m_FramePeakSize, m_CurrentFrameSize);
-        m_TotalPeakSize = std::max(m_TotalPeakSize, m_RingBuffer.GetUsedSize());
+        auto CurrentFrameSize = m_CurrentFrameSize.fetch_add(SizeInBytes, std::memory_order_relaxed) + SizeInBytes;
+        UpdatePeakValue(m_FramePeakSize, CurrentFrameSize);
+        UpdatePeakValue(m_TotalPeakSize, m_RingBuffer.GetUsedSize());
     }
     return Offset;
 }
@@ -190,7 +200,7 @@ void VulkanRingBuffer::FinishFrame(Uint64 FenceValue, Uint64 LastCompletedFenceV
     //      Deferred contexts must not map dynamic buffers across several frames!
     //
 
-    std::lock_guard<std::mutex> Lock(m_RingBuffMtx);
+    std::lock_guard<std::mutex> Lock(m_FramesMtx);
     m_RingBuffer.FinishCurrentFrame(FenceValue);
     m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
     m_CurrentFrameSize = 0;
@@ -211,7 +221,7 @@ VulkanDynamicAllocation VulkanDynamicHeap::Allocate(Uint32 SizeInBytes, Uint32 A
     //
     //      Deferred contexts must not map dynamic buffers across several frames!
     //
-    auto Offset = RingBuffer::InvalidOffset;
+    auto Offset = ConcurrentRingBuffer::InvalidOffset;
     if(AlignedSize > m_PagSize)
     {
         // Allocate directly from the ring buffer
@@ -219,12 +229,12 @@ VulkanDynamicAllocation VulkanDynamicHeap::Allocate(Uint32 SizeInBytes, Uint32 A
     }
     else
     {
-        if(m_CurrOffset == RingBuffer::InvalidOffset || AlignedSize > m_AvailableSize)
+        if(m_CurrOffset == ConcurrentRingBuffer::InvalidOffset || AlignedSize > m_AvailableSize)
         {
             m_CurrOffset = m_ParentRingBuffer.Allocate(m_PagSize);
             m_AvailableSize = m_PagSize;
         }
-        if(m_CurrOffset != RingBuffer::InvalidOffset)
+        if(m_CurrOffset != ConcurrentRingBuffer::InvalidOffset)
         {
             Offset = m_CurrOffset;
             m_AvailableSize -= AlignedSize;
@@ -233,7 +243,7 @@ VulkanDynamicAllocation VulkanDynamicHeap::Allocate(Uint32 SizeInBytes, Uint32 A
     }
 
     // Every device context uses its own dynamic heap, so there is no need to lock
-    if(Offset != RingBuffer::InvalidOffset)
+    if(Offset != ConcurrentRingBuffer::InvalidOffset)
     {
         m_CurrAllocatedSize += AlignedSize;
         m_CurrUsedSize      += SizeInBytes;
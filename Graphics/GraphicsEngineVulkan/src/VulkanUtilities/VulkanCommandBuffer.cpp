@@ -143,17 +143,44 @@ static VkPipelineStageFlags PipelineStageFromAccessFlags(VkAccessFlags AccessFla
     return Stages;
 }
 
-void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
-                                                VkImage                        Image,
-                                                VkImageLayout                  OldLayout,
-                                                VkImageLayout                  NewLayout,
-                                                const VkImageSubresourceRange& SubresRange,
-                                                VkPipelineStageFlags           SrcStages, 
-                                                VkPipelineStageFlags           DestStages)
+// Queues from dedicated compute and transfer families do not support graphics pipeline stages. 
+// Accesses performed by such stages happen on other queues and are synchronized with semaphores, 
+// which make all memory accesses available and visible, so they are removed from the barrier.
+static void RemoveUnsupportedStages(VkPipelineStageFlags  SupportedStages,
+                                    VkPipelineStageFlags  FallbackStage,
+                                    VkPipelineStageFlags& Stages,
+                                    VkAccessFlags&        AccessMask)
 {
-    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+    if ((Stages & ~SupportedStages) == 0)
+        return;
 
-    VkImageMemoryBarrier ImgBarrier = {};
+    VkAccessFlags SupportedAccess = 0;
+    for (VkAccessFlags AccessFlags = AccessMask; AccessFlags != 0; )
+    {
+        VkAccessFlags AccessFlag = AccessFlags & (~(AccessFlags-1));
+        AccessFlags &= ~AccessFlag;
+        auto AccessStages = PipelineStageFromAccessFlags(AccessFlag);
+        // Memory read and write accesses are not tied to any particular stage
+        if (AccessStages == 0 || (AccessStages & SupportedStages) != 0)
+            SupportedAccess |= AccessFlag;
+    }
+    AccessMask = SupportedAccess;
+
+    Stages &= SupportedStages;
+    if (Stages == 0)
+        Stages = FallbackStage;
+}
+
+static void InitImageBarrier(VkImage                        Image,
+                             VkImageLayout                  OldLayout,
+                             VkImageLayout                  NewLayout,
+                             const VkImageSubresourceRange& SubresRange,
+                             VkPipelineStageFlags&          SrcStages, 
+                             VkPipelineStageFlags&          DestStages,
+                             VkPipelineStageFlags           SupportedStages,
+                             VkImageMemoryBarrier&          ImgBarrier)
+{
+    ImgBarrier = {};
     ImgBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     ImgBarrier.pNext = nullptr;
     ImgBarrier.srcAccessMask = 0;
@@ -333,6 +360,64 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
         }
     }
 
+    RemoveUnsupportedStages(SupportedStages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,    SrcStages,  ImgBarrier.srcAccessMask);
+    RemoveUnsupportedStages(SupportedStages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, DestStages, ImgBarrier.dstAccessMask);
+}
+
+static void InitBufferBarrier(VkBuffer               Buffer, 
+                              VkAccessFlags          srcAccessMask,
+                              VkAccessFlags          dstAccessMask,
+                              VkPipelineStageFlags&  SrcStages, 
+                              VkPipelineStageFlags&  DestStages,
+                              VkPipelineStageFlags   SupportedStages,
+                              VkBufferMemoryBarrier& BuffBarrier)
+{
+    BuffBarrier = {};
+    BuffBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    BuffBarrier.pNext = nullptr;
+    BuffBarrier.srcAccessMask = srcAccessMask;
+    BuffBarrier.dstAccessMask = dstAccessMask;
+    BuffBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.buffer = Buffer;
+    BuffBarrier.offset = 0;
+    BuffBarrier.size   = VK_WHOLE_SIZE;
+    if (SrcStages == 0)
+    {
+        if (BuffBarrier.srcAccessMask != 0)
+            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask);
+        else
+        {
+            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage 
+            // mask will effectively not wait for any prior commands to complete. (6.1.2)
+            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+    }
+
+    if (DestStages == 0)
+    {
+        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
+        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask);
+    }
+
+    RemoveUnsupportedStages(SupportedStages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,    SrcStages,  BuffBarrier.srcAccessMask);
+    RemoveUnsupportedStages(SupportedStages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, DestStages, BuffBarrier.dstAccessMask);
+}
+
+void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
+                                                VkImage                        Image,
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           SrcStages, 
+                                                VkPipelineStageFlags           DestStages,
+                                                VkPipelineStageFlags           SupportedStages)
+{
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+
+    VkImageMemoryBarrier ImgBarrier;
+    InitImageBarrier(Image, OldLayout, NewLayout, SubresRange, SrcStages, DestStages, SupportedStages, ImgBarrier);
+
     // Including a particular pipeline stage in the first synchronization scope of a command implicitly 
     // includes logically earlier pipeline stages in the synchronization scope. Similarly, the second 
     // synchronization scope includes logically later pipeline stages.
@@ -363,35 +448,13 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
                                               VkAccessFlags        srcAccessMask,
                                               VkAccessFlags        dstAccessMask,
                                               VkPipelineStageFlags SrcStages, 
-                                              VkPipelineStageFlags DestStages)
+                                              VkPipelineStageFlags DestStages,
+                                              VkPipelineStageFlags SupportedStages)
 {
-    VkBufferMemoryBarrier BuffBarrier = {};
-    BuffBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-    BuffBarrier.pNext = nullptr;
-    BuffBarrier.srcAccessMask = srcAccessMask;
-    BuffBarrier.dstAccessMask = dstAccessMask;
-    BuffBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.buffer = Buffer;
-    BuffBarrier.offset = 0;
-    BuffBarrier.size   = VK_WHOLE_SIZE;
-    if (SrcStages == 0)
-    {
-        if (BuffBarrier.srcAccessMask != 0)
-            SrcStages = PipelineStageFromAccessFlags(BuffBarrier.srcAccessMask);
-        else
-        {
-            // An execution dependency with only VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT in the source stage 
-            // mask will effectively not wait for any prior commands to complete. (6.1.2)
-            SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        }
-    }
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
 
-    if (DestStages == 0)
-    {
-        VERIFY(BuffBarrier.dstAccessMask != 0, "Dst access mask must not be zero");
-        DestStages = PipelineStageFromAccessFlags(BuffBarrier.dstAccessMask);
-    }
+    VkBufferMemoryBarrier BuffBarrier;
+    InitBufferBarrier(Buffer, srcAccessMask, dstAccessMask, SrcStages, DestStages, SupportedStages, BuffBarrier);
 
     vkCmdPipelineBarrier(CmdBuffer,
         SrcStages,    // must not be 0
@@ -405,9 +468,95 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
         nullptr);
 }
 
+void VulkanCommandBuffer::TransitionImageLayout(VkImage                        Image, 
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           SrcStages, 
+                                                VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    if (m_State.RenderPass  != VK_NULL_HANDLE)
+    {
+        // Image layout transitions within a render pass execute
+        // dependencies between attachments
+        EndRenderPass();
+    }
+
+    // Barriers recorded by the same vkCmdPipelineBarrier() call are not ordered with respect to each
+    // other, so a pending barrier for the same image must be recorded first
+    for (const auto& PendingBarrier : m_ImageBarriers)
+    {
+        if (PendingBarrier.image == Image)
+        {
+            FlushBarriers();
+            break;
+        }
+    }
+
+    VkImageMemoryBarrier ImgBarrier;
+    InitImageBarrier(Image, OldLayout, NewLayout, SubresRange, SrcStages, DestStages, m_SupportedStages, ImgBarrier);
+    m_ImageBarriers.push_back(ImgBarrier);
+    m_PendingSrcStages  |= SrcStages;
+    m_PendingDestStages |= DestStages;
+}
+
+void VulkanCommandBuffer::BufferMemoryBarrier(VkBuffer             Buffer, 
+                                              VkAccessFlags        srcAccessMask,
+                                              VkAccessFlags        dstAccessMask,
+                                              VkPipelineStageFlags SrcStages,
+                                              VkPipelineStageFlags DestStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    if (m_State.RenderPass  != VK_NULL_HANDLE)
+    {
+        // Pipeline barriers within a render pass require
+        // a subpass self-dependency
+        EndRenderPass();
+    }
+
+    for (const auto& PendingBarrier : m_BufferBarriers)
+    {
+        if (PendingBarrier.buffer == Buffer)
+        {
+            FlushBarriers();
+            break;
+        }
+    }
+
+    VkBufferMemoryBarrier BuffBarrier;
+    InitBufferBarrier(Buffer, srcAccessMask, dstAccessMask, SrcStages, DestStages, m_SupportedStages, BuffBarrier);
+    m_BufferBarriers.push_back(BuffBarrier);
+    m_PendingSrcStages  |= SrcStages;
+    m_PendingDestStages |= DestStages;
+}
+
 void VulkanCommandBuffer::FlushBarriers()
 {
+    if (m_ImageBarriers.empty() && m_BufferBarriers.empty())
+        return;
 
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Barriers must be flushed outside of render pass");
+
+    // Every stage and access flag of every barrier is included in the merged stage masks,
+    // so the access masks of all barriers remain valid (6.6)
+    vkCmdPipelineBarrier(m_VkCmdBuffer,
+        m_PendingSrcStages,
+        m_PendingDestStages,
+        0,
+        0,
+        nullptr,
+        static_cast<uint32_t>(m_BufferBarriers.size()),
+        m_BufferBarriers.empty() ? nullptr : m_BufferBarriers.data(),
+        static_cast<uint32_t>(m_ImageBarriers.size()),
+        m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+    ++m_NumPipelineBarriers;
+
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+    m_PendingSrcStages  = 0;
+    m_PendingDestStages = 0;
 }
 
 }
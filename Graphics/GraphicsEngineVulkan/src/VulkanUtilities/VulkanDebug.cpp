@@ -33,6 +33,8 @@ namespace VulkanUtilities
 
         // Ignore the following warning:
         // 64: vkCmdClearAttachments() issued on command buffer object 0x... prior to any Draw Cmds. It is recommended you use RenderPass LOAD_OP_CLEAR on Attachments prior to any Draw.
+        // The device context performs clears requested before the render pass is begun through LOAD_OP_CLEAR.
+        // The warning is only issued for clears recorded after the render pass has been begun by other commands.
         if ( (flags & VK_DEBUG_REPORT_PERFORMANCE_WARNING_BIT_EXT) && msgCode == 64 )
             return VK_FALSE;
             
@@ -291,6 +293,16 @@ namespace VulkanUtilities
         SetObjectName(device, (uint64_t)_event, VK_DEBUG_REPORT_OBJECT_TYPE_EVENT_EXT, name);
     }
 
+    void SetPipelineCacheName(VkDevice device, VkPipelineCache pipelineCache, const char * name)
+    {
+        SetObjectName(device, (uint64_t)pipelineCache, VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_CACHE_EXT, name);
+    }
+
+    void SetDescriptorUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name)
+    {
+        SetObjectName(device, (uint64_t)descriptorUpdateTemplate, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_KHR_EXT, name);
+    }
+
 
 
 
@@ -393,6 +405,16 @@ namespace VulkanUtilities
     {
         SetEventName(device, _event, name);
     }
+
+    void SetVulkanObjectName(VkDevice device, VkPipelineCache pipelineCache, const char * name)
+    {
+        SetPipelineCacheName(device, pipelineCache, name);
+    }
+
+    void SetVulkanObjectName(VkDevice device, VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate, const char * name)
+    {
+        SetDescriptorUpdateTemplateName(device, descriptorUpdateTemplate, name);
+    }
     
 
 
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include <cstring>
+#include "PlatformDefinitions.h"
 #include "VulkanErrors.h"
 #include "VulkanUtilities/VulkanInstance.h"
 #include "VulkanUtilities/VulkanDebug.h"
@@ -49,15 +50,17 @@ namespace VulkanUtilities
     }
 
     std::shared_ptr<VulkanInstance> VulkanInstance::Create(bool                   EnableValidation,
+                                                           bool                   EnableSurface,
                                                            uint32_t               GlobalExtensionCount, 
                                                            const char* const*     ppGlobalExtensionNames,
                                                            VkAllocationCallbacks* pVkAllocator)
     {
-        auto Instance = new VulkanInstance(EnableValidation, GlobalExtensionCount, ppGlobalExtensionNames, pVkAllocator);
+        auto Instance = new VulkanInstance(EnableValidation, EnableSurface, GlobalExtensionCount, ppGlobalExtensionNames, pVkAllocator);
         return std::shared_ptr<VulkanInstance>(Instance);
     }
 
     VulkanInstance::VulkanInstance(bool                   EnableValidation, 
+                                   bool                   EnableSurface,
                                    uint32_t               GlobalExtensionCount, 
                                    const char* const*     ppGlobalExtensionNames,
                                    VkAllocationCallbacks* pVkAllocator) : 
@@ -85,25 +88,30 @@ namespace VulkanUtilities
             VERIFY_EXPR(ExtensionCount == m_Extensions.size());
         }
 
-        std::vector<const char*> GlobalExtensions = 
-        { 
-            VK_KHR_SURFACE_EXTENSION_NAME,
+        std::vector<const char*> GlobalExtensions;
+        // Headless instances do not need any window system integration
+        if (EnableSurface)
+        {
+            GlobalExtensions = 
+            { 
+                VK_KHR_SURFACE_EXTENSION_NAME,
 
-            // Enable surface extensions depending on OS
+                // Enable surface extensions depending on OS
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
-            VK_KHR_WIN32_SURFACE_EXTENSION_NAME
+                VK_KHR_WIN32_SURFACE_EXTENSION_NAME
 #elif defined(VK_USE_PLATFORM_ANDROID_KHR)
-            VK_KHR_ANDROID_SURFACE_EXTENSION_NAME
+                VK_KHR_ANDROID_SURFACE_EXTENSION_NAME
 #elif defined(VK_USE_PLATFORM_WAYLAND_KHR)
-            VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME
+                VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
-            VK_KHR_XCB_SURFACE_EXTENSION_NAME
+                VK_KHR_XCB_SURFACE_EXTENSION_NAME
 #elif defined(VK_USE_PLATFORM_IOS_MVK)
-            VK_MVK_IOS_SURFACE_EXTENSION_NAME
+                VK_MVK_IOS_SURFACE_EXTENSION_NAME
 #elif defined(VK_USE_PLATFORM_MACOS_MVK)
-            VK_MVK_MACOS_SURFACE_EXTENSION_NAME
+                VK_MVK_MACOS_SURFACE_EXTENSION_NAME
 #endif
-        };
+            };
+        }
 
         if (EnableValidation)
         {
@@ -22,6 +22,7 @@
 */
 
 #include <limits>
+#include <cstring>
 #include "VulkanErrors.h"
 #include "VulkanUtilities/VulkanLogicalDevice.h"
 #include "VulkanUtilities/VulkanDebug.h"
@@ -55,6 +56,24 @@ namespace VulkanUtilities
         {
             SetupDebugMarkers(m_VkDevice);
         }
+
+        for (uint32_t ext = 0; ext < DeviceCI.enabledExtensionCount; ++ext)
+        {
+            if (strcmp(DeviceCI.ppEnabledExtensionNames[ext], VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME) == 0)
+            {
+                m_vkCreateDescriptorUpdateTemplate  = (PFN_vkCreateDescriptorUpdateTemplateKHR) vkGetDeviceProcAddr(m_VkDevice, "vkCreateDescriptorUpdateTemplateKHR");
+                m_vkDestroyDescriptorUpdateTemplate = (PFN_vkDestroyDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_VkDevice, "vkDestroyDescriptorUpdateTemplateKHR");
+                m_vkUpdateDescriptorSetWithTemplate = (PFN_vkUpdateDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(m_VkDevice, "vkUpdateDescriptorSetWithTemplateKHR");
+                if (m_vkCreateDescriptorUpdateTemplate == nullptr || m_vkDestroyDescriptorUpdateTemplate == nullptr || m_vkUpdateDescriptorSetWithTemplate == nullptr)
+                {
+                    LOG_WARNING_MESSAGE("Failed to load ", VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME, " extension functions");
+                    m_vkCreateDescriptorUpdateTemplate  = nullptr;
+                    m_vkDestroyDescriptorUpdateTemplate = nullptr;
+                    m_vkUpdateDescriptorSetWithTemplate = nullptr;
+                }
+                break;
+            }
+        }
     }
 
     VkQueue VulkanLogicalDevice::GetQueue(uint32_t queueFamilyIndex, uint32_t queueIndex)
@@ -239,6 +258,19 @@ namespace VulkanUtilities
         return CreateVulkanObject<VkSemaphore>(vkCreateSemaphore, SemaphoreCI, DebugName, "semaphore");
     }
 
+    PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCacheCreateInfo &PipelineCacheCI, const char* DebugName)const
+    {
+        VERIFY_EXPR(PipelineCacheCI.sType == VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+        return CreateVulkanObject<VkPipelineCache>(vkCreatePipelineCache, PipelineCacheCI, DebugName, "pipeline cache");
+    }
+
+    DescriptorUpdateTemplateWrapper VulkanLogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfoKHR &TemplateCI, const char* DebugName)const
+    {
+        VERIFY_EXPR(TemplateCI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR);
+        VERIFY(IsDescriptorUpdateTemplateSupported(), "Descriptor update templates are not supported by the device");
+        return CreateVulkanObject<VkDescriptorUpdateTemplateKHR>(m_vkCreateDescriptorUpdateTemplate, TemplateCI, DebugName, "descriptor update template");
+    }
+
     VkCommandBuffer VulkanLogicalDevice::AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName)const
     {
         VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
@@ -371,6 +403,19 @@ namespace VulkanUtilities
         Semaphore.m_VkObject = VK_NULL_HANDLE;
     }
 
+    void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache)const
+    {
+        vkDestroyPipelineCache(m_VkDevice, PipelineCache.m_VkObject, m_VkAllocator);
+        PipelineCache.m_VkObject = VK_NULL_HANDLE;
+    }
+
+    void VulkanLogicalDevice::ReleaseVulkanObject(DescriptorUpdateTemplateWrapper&& DescriptorUpdateTemplate)const
+    {
+        VERIFY_EXPR(m_vkDestroyDescriptorUpdateTemplate != nullptr);
+        m_vkDestroyDescriptorUpdateTemplate(m_VkDevice, DescriptorUpdateTemplate.m_VkObject, m_VkAllocator);
+        DescriptorUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+    }
+
 
     void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set)const
     {
@@ -435,6 +480,14 @@ namespace VulkanUtilities
         vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
     }
 
+    void VulkanLogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet               descriptorSet,
+                                                              VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate,
+                                                              const void*                   pData)const
+    {
+        VERIFY_EXPR(m_vkUpdateDescriptorSetWithTemplate != nullptr);
+        m_vkUpdateDescriptorSetWithTemplate(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+    }
+
     VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool            vkCmdPool,
                                                    VkCommandPoolResetFlags  flags)const
     {
@@ -442,4 +495,9 @@ namespace VulkanUtilities
         VERIFY(err == VK_SUCCESS, "Failed to reset command pool");
         return err;
     }
+
+    VkResult VulkanLogicalDevice::GetPipelineCacheData(VkPipelineCache pipelineCache, size_t* pDataSize, void* pData)const
+    {
+        return vkGetPipelineCacheData(m_VkDevice, pipelineCache, pDataSize, pData);
+    }
 }
@@ -36,12 +36,25 @@ VulkanMemoryAllocation::~VulkanMemoryAllocation()
     }
 }
 
+template<typename AllocationsManagerType>
+static std::unique_ptr<AllocationsManagerType, Diligent::STDDeleterRawMem<AllocationsManagerType>> CreateAllocationsManager(bool Create, VkDeviceSize PageSize, Diligent::IMemoryAllocator& Allocator)
+{
+    AllocationsManagerType* pMgr = nullptr;
+    if (Create)
+    {
+        auto* pRawMem = Allocator.Allocate(sizeof(AllocationsManagerType), "Memory for Vulkan memory page allocations manager", __FILE__, __LINE__);
+        pMgr = new (pRawMem) AllocationsManagerType(PageSize, Allocator);
+    }
+    return std::unique_ptr<AllocationsManagerType, Diligent::STDDeleterRawMem<AllocationsManagerType>>(pMgr, Diligent::STDDeleterRawMem<AllocationsManagerType>(Allocator));
+}
+
 VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager& ParentMemoryMgr,
                                    VkDeviceSize         PageSize, 
                                    uint32_t             MemoryTypeIndex,
                                    bool                 IsHostVisible)noexcept : 
-    m_ParentMemoryMgr(ParentMemoryMgr),
-    m_AllocationMgr(PageSize, ParentMemoryMgr.m_Allocator)
+    m_ParentMemoryMgr  (ParentMemoryMgr),
+    m_AllocationMgr    (CreateAllocationsManager<Diligent::VariableSizeAllocationsManager>(!ParentMemoryMgr.m_UseTLSFAllocator, PageSize, ParentMemoryMgr.m_Allocator)),
+    m_TLSFAllocationMgr(CreateAllocationsManager<Diligent::TLSFAllocationsManager>         ( ParentMemoryMgr.m_UseTLSFAllocator, PageSize, ParentMemoryMgr.m_Allocator))
 {
     VkMemoryAllocateInfo MemAlloc = {};
     MemAlloc.pNext = nullptr;
@@ -72,13 +85,16 @@ VulkanMemoryPage::~VulkanMemoryPage()
         m_ParentMemoryMgr.m_LogicalDevice.UnmapMemory(m_VkMemory);
     }
 
-    VERIFY(IsEmpty(), "Destroying a page with not all allocations released");
+    // Moved-from pages have no allocations manager
+    if (m_AllocationMgr || m_TLSFAllocationMgr)
+        VERIFY(IsEmpty(), "Destroying a page with not all allocations released");
 }
 
-VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size)
+VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSize alignment)
 {
     std::lock_guard<std::mutex> Lock(m_Mutex);
-    auto Offset = m_AllocationMgr.Allocate(size);
+    auto Offset = m_TLSFAllocationMgr ? m_TLSFAllocationMgr->Allocate(size, alignment) : m_AllocationMgr->Allocate(size, alignment);
+    static_assert(Diligent::VariableSizeAllocationsManager::InvalidOffset == Diligent::TLSFAllocationsManager::InvalidOffset, "Invalid offsets are expected to be equal");
     if (Offset != Diligent::VariableSizeAllocationsManager::InvalidOffset)
     {
         return VulkanMemoryAllocation{this, Offset, size};
@@ -93,7 +109,10 @@ void VulkanMemoryPage::Free(VulkanMemoryAllocation& Allocation)
 {
     m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
     std::lock_guard<std::mutex> Lock(m_Mutex);
-    m_AllocationMgr.Free(Allocation.UnalignedOffset, Allocation.Size);
+    if (m_TLSFAllocationMgr)
+        m_TLSFAllocationMgr->Free(Allocation.Offset, Allocation.Size);
+    else
+        m_AllocationMgr->Free(Allocation.Offset, Allocation.Size);
 }
 
 VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps)
@@ -130,14 +149,17 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
 
 VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible)
 {
-    Size += Alignment;
+    // Pages allocate blocks at aligned offsets, so there is no need to reserve extra space for alignment
+    if (Alignment == 0)
+        Alignment = 1;
+    VERIFY( (Alignment & (Alignment-1)) == 0, "Alignment is not power of 2!");
     VulkanMemoryAllocation Allocation;
 
     std::lock_guard<std::mutex> Lock(m_PagesMtx);
     auto range = m_Pages.equal_range(MemoryTypeIndex);
     for(auto page_it = range.first; page_it != range.second; ++page_it)
     {
-        Allocation = page_it->second.Allocate(Size);
+        Allocation = page_it->second.Allocate(Size, Alignment);
         if (Allocation.Page != nullptr)
             break;
     }
@@ -157,8 +179,13 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
                          " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex, 
                          "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
         OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size);
-        VERIFY(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        Allocation = it->second.Allocate(Size, Alignment);
+        if (Allocation.Page == nullptr)
+        {
+            LOG_ERROR_MESSAGE("VulkanMemoryManager '", m_MgrName, "': failed to allocate ", Size, " bytes with alignment ", Alignment, " from a new ", 
+                              Diligent::FormatMemorySize(PageSize, 2), " page");
+            return Allocation;
+        }
     }
 
     m_CurrUsedSize[stat_ind].fetch_add(Size);
@@ -127,6 +127,17 @@ namespace VulkanUtilities
         return FamilyInd;
     }
 
+    uint32_t VulkanPhysicalDevice::FindDedicatedQueueFamily(VkQueueFlags QueueFlags, VkQueueFlags ExcludedFlags)const
+    {
+        for (uint32_t i = 0; i < m_QueueFamilyProperties.size(); ++i)
+        {
+            const auto &Props = m_QueueFamilyProperties[i];
+            if ((Props.queueFlags & QueueFlags) == QueueFlags && (Props.queueFlags & ExcludedFlags) == 0 && Props.queueCount > 0)
+                return i;
+        }
+        return InvalidQueueFamilyIndex;
+    }
+
     bool VulkanPhysicalDevice::IsExtensionSupported(const char *ExtensionName)const
     {
         for(const auto& Extension : m_SupportedExtensions)
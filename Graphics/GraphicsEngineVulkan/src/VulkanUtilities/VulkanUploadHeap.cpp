@@ -71,6 +71,8 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(size_t SizeInBytes)
 {
     VulkanUploadAllocation Allocation;
     Allocation.MemAllocation = VulkanMemoryManager::Allocate(SizeInBytes, 0, m_StagingBufferMemoryTypeIndex, true);
+    if (Allocation.MemAllocation.Page == nullptr)
+        LOG_ERROR_AND_THROW("Failed to allocate ", SizeInBytes, " bytes in the upload heap");
 
     std::lock_guard<std::mutex> Lock(m_BuffersMtx);
     auto BuffIt = m_Buffers.find(Allocation.MemAllocation.Page);
@@ -0,0 +1,145 @@
+/*     Copyright 2015-2018 Egor Yusov
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Compares the CPU cost of submitting command lists recorded by several deferred contexts
+// with one ExecuteCommandList() call per list, which submits every list separately, and with
+// a single IDeviceContextVk::ExecuteCommandLists() call, which submits all lists at once.
+// Every deferred context records a buffer update every frame. The test requires a Vulkan
+// device and is skipped when none is available.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "vulkan.h"
+#include "RenderDeviceFactoryVk.h"
+#include "RenderDeviceVk.h"
+#include "DeviceContextVk.h"
+#include "RefCntAutoPtr.h"
+#include "Timer.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr Uint32 MaxCommandLists = 8;
+static constexpr Uint32 NumFrames       = 500;
+static constexpr Uint32 BufferSize      = 256;
+
+class SubmitBenchmark
+{
+public:
+    SubmitBenchmark(IRenderDevice* pDevice, IDeviceContext** ppContexts) :
+        m_pDevice(pDevice, IID_RenderDeviceVk),
+        m_pImmediateCtx(ppContexts[0], IID_DeviceContextVk)
+    {
+        for (Uint32 ctx = 0; ctx < MaxCommandLists; ++ctx)
+            m_pDeferredCtx[ctx] = ppContexts[1 + ctx];
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Submit benchmark buffer";
+        BuffDesc.uiSizeInBytes = BufferSize;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        for (auto& pBuffer : m_pBuffers)
+            pDevice->CreateBuffer(BuffDesc, BufferData{}, &pBuffer);
+    }
+
+    // Returns the average time it takes to submit all command lists of one frame, in microseconds
+    double Run(Uint32 NumCommandLists, bool SubmitTogether)
+    {
+        Uint8 Data[BufferSize] = {};
+        double TotalTime = 0;
+        for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            ICommandList* pCommandLists[MaxCommandLists] = {};
+            for (Uint32 ctx = 0; ctx < NumCommandLists; ++ctx)
+            {
+                Data[0] = static_cast<Uint8>(Frame);
+                m_pBuffers[ctx]->UpdateData(m_pDeferredCtx[ctx], 0, BufferSize, Data);
+                m_pDeferredCtx[ctx]->FinishCommandList(&pCommandLists[ctx]);
+            }
+
+            Timer timer;
+            if (SubmitTogether)
+            {
+                m_pImmediateCtx->ExecuteCommandLists(NumCommandLists, pCommandLists);
+            }
+            else
+            {
+                for (Uint32 ctx = 0; ctx < NumCommandLists; ++ctx)
+                    m_pImmediateCtx->ExecuteCommandList(pCommandLists[ctx]);
+            }
+            TotalTime += timer.GetElapsedTime();
+
+            for (Uint32 ctx = 0; ctx < NumCommandLists; ++ctx)
+                pCommandLists[ctx]->Release();
+            // Headless devices must finish every frame explicitly
+            m_pDevice->FinishFrame();
+        }
+        return TotalTime / NumFrames * 1e+6;
+    }
+
+private:
+    RefCntAutoPtr<IRenderDeviceVk>  m_pDevice;
+    RefCntAutoPtr<IDeviceContextVk> m_pImmediateCtx;
+    IDeviceContext*                 m_pDeferredCtx[MaxCommandLists] = {};
+    RefCntAutoPtr<IBuffer>          m_pBuffers[MaxCommandLists];
+};
+
+}
+
+int main()
+{
+    EngineVkAttribs Attribs;
+    Attribs.Headless = true;
+
+    RefCntAutoPtr<IRenderDevice> pDevice;
+    IDeviceContext* ppContexts[1 + MaxCommandLists] = {};
+    GetEngineFactoryVk()->CreateDeviceAndContextsVk(Attribs, &pDevice, ppContexts, MaxCommandLists);
+    if (!pDevice)
+    {
+        std::cout << "Vulkan device is not available, skipping the test\n";
+        return SKIP_RETURN_CODE;
+    }
+
+    {
+        SubmitBenchmark Benchmark(pDevice, ppContexts);
+        std::cout << "Command list submission time, us per frame\n"
+                  << "Command lists    Separate    Together\n";
+        for (Uint32 NumCommandLists = 1; NumCommandLists <= MaxCommandLists; NumCommandLists *= 2)
+        {
+            auto SeparateTime = Benchmark.Run(NumCommandLists, false);
+            auto TogetherTime = Benchmark.Run(NumCommandLists, true);
+            std::cout << std::setw(13) << NumCommandLists << std::fixed << std::setprecision(1)
+                      << std::setw(12) << SeparateTime << std::setw(12) << TogetherTime << '\n';
+        }
+    }
+
+    for (auto* pCtx : ppContexts)
+    {
+        if (pCtx != nullptr)
+            pCtx->Release();
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Compares the CPU cost of writing a dynamic descriptor set with an array of VkWriteDescriptorSet
+// structures, which is what ShaderResourceLayoutVk::CommitDynamicResources() does, and with a
+// single vkUpdateDescriptorSetWithTemplateKHR call, which is what the pipeline layout's update
+// template is used for. The descriptor data is regathered for every set as the engine does it
+// at commit time. The test requires a Vulkan device and is skipped when none is available.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <exception>
+#include "VulkanUtilities/VulkanInstance.h"
+#include "VulkanUtilities/VulkanPhysicalDevice.h"
+#include "VulkanUtilities/VulkanLogicalDevice.h"
+#include "Timer.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr uint32_t     NumIterations   = 100000;
+static constexpr VkDeviceSize UniformDataSize = 256;
+
+class DescriptorUpdateBenchmark
+{
+public:
+    DescriptorUpdateBenchmark(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, 
+                              const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice,
+                              uint32_t                                     NumDescriptors) :
+        m_LogicalDevice (LogicalDevice),
+        m_NumDescriptors(NumDescriptors)
+    {
+        std::vector<VkDescriptorSetLayoutBinding> Bindings(NumDescriptors);
+        for (uint32_t b=0; b < NumDescriptors; ++b)
+        {
+            auto& Binding = Bindings[b];
+            Binding.binding            = b;
+            Binding.descriptorType     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            Binding.descriptorCount    = 1;
+            Binding.stageFlags         = VK_SHADER_STAGE_ALL;
+            Binding.pImmutableSamplers = nullptr;
+        }
+        VkDescriptorSetLayoutCreateInfo LayoutCI = {};
+        LayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        LayoutCI.bindingCount = NumDescriptors;
+        LayoutCI.pBindings    = Bindings.data();
+        m_SetLayout = LogicalDevice.CreateDescriptorSetLayout(LayoutCI);
+
+        VkDescriptorPoolSize PoolSize = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, NumDescriptors};
+        VkDescriptorPoolCreateInfo PoolCI = {};
+        PoolCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        PoolCI.maxSets       = 1;
+        PoolCI.poolSizeCount = 1;
+        PoolCI.pPoolSizes    = &PoolSize;
+        m_Pool = LogicalDevice.CreateDescriptorPool(PoolCI);
+
+        VkDescriptorSetLayout vkSetLayout = m_SetLayout;
+        VkDescriptorSetAllocateInfo AllocInfo = {};
+        AllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        AllocInfo.descriptorPool     = m_Pool;
+        AllocInfo.descriptorSetCount = 1;
+        AllocInfo.pSetLayouts        = &vkSetLayout;
+        // The set is freed when the pool is destroyed
+        m_Set = LogicalDevice.AllocateVkDescriptorSet(AllocInfo);
+
+        // Every binding references its own range of a single buffer. Two ranges per
+        // binding are used so that consecutive updates write different descriptors
+        VkBufferCreateInfo BufferCI = {};
+        BufferCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        BufferCI.size        = UniformDataSize * NumDescriptors * 2;
+        BufferCI.usage       = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        BufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        m_Buffer = LogicalDevice.CreateBuffer(BufferCI);
+
+        auto MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_Buffer);
+        VkMemoryAllocateInfo MemAllocInfo = {};
+        MemAllocInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        MemAllocInfo.allocationSize  = MemReqs.size;
+        MemAllocInfo.memoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (MemAllocInfo.memoryTypeIndex == VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+            MemAllocInfo.memoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, 0);
+        m_Memory = LogicalDevice.AllocateDeviceMemory(MemAllocInfo);
+        LogicalDevice.BindBufferMemory(m_Buffer, m_Memory, 0);
+
+        if (LogicalDevice.IsDescriptorUpdateTemplateSupported())
+        {
+            // Same layout as PipelineLayout::CreateDynamicDescriptorUpdateTemplate(): one entry per binding
+            std::vector<VkDescriptorUpdateTemplateEntryKHR> Entries(NumDescriptors);
+            for (uint32_t b=0; b < NumDescriptors; ++b)
+            {
+                auto& Entry = Entries[b];
+                Entry.dstBinding      = b;
+                Entry.dstArrayElement = 0;
+                Entry.descriptorCount = 1;
+                Entry.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                Entry.offset          = b * sizeof(VkDescriptorBufferInfo);
+                Entry.stride          = sizeof(VkDescriptorBufferInfo);
+            }
+            VkDescriptorUpdateTemplateCreateInfoKHR TemplateCI = {};
+            TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+            TemplateCI.descriptorUpdateEntryCount = NumDescriptors;
+            TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+            TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+            TemplateCI.descriptorSetLayout        = m_SetLayout;
+            m_UpdateTemplate = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI);
+        }
+
+        m_BufferInfos.resize(NumDescriptors);
+        m_Writes.resize(NumDescriptors);
+    }
+
+    void GatherBufferInfos(uint32_t Iteration)
+    {
+        for (uint32_t b=0; b < m_NumDescriptors; ++b)
+        {
+            auto& BufferInfo = m_BufferInfos[b];
+            BufferInfo.buffer = m_Buffer;
+            BufferInfo.offset = (b * 2 + (Iteration & 0x01)) * UniformDataSize;
+            BufferInfo.range  = UniformDataSize;
+        }
+    }
+
+    // Returns the average time of one set update, in nanoseconds
+    double RunWriteDescriptorSets()
+    {
+        Timer timer;
+        for (uint32_t i=0; i < NumIterations; ++i)
+        {
+            GatherBufferInfos(i);
+            for (uint32_t b=0; b < m_NumDescriptors; ++b)
+            {
+                auto& Write = m_Writes[b];
+                Write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                Write.pNext            = nullptr;
+                Write.dstSet           = m_Set;
+                Write.dstBinding       = b;
+                Write.dstArrayElement  = 0;
+                Write.descriptorCount  = 1;
+                Write.descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                Write.pImageInfo       = nullptr;
+                Write.pBufferInfo      = &m_BufferInfos[b];
+                Write.pTexelBufferView = nullptr;
+            }
+            m_LogicalDevice.UpdateDescriptorSets(m_NumDescriptors, m_Writes.data(), 0, nullptr);
+        }
+        return timer.GetElapsedTime() / NumIterations * 1e+9;
+    }
+
+    double RunUpdateTemplate()
+    {
+        Timer timer;
+        for (uint32_t i=0; i < NumIterations; ++i)
+        {
+            GatherBufferInfos(i);
+            m_LogicalDevice.UpdateDescriptorSetWithTemplate(m_Set, m_UpdateTemplate, m_BufferInfos.data());
+        }
+        return timer.GetElapsedTime() / NumIterations * 1e+9;
+    }
+
+private:
+    const VulkanUtilities::VulkanLogicalDevice& m_LogicalDevice;
+    const uint32_t                              m_NumDescriptors;
+
+    VulkanUtilities::DescriptorSetLayoutWrapper      m_SetLayout;
+    VulkanUtilities::DescriptorPoolWrapper           m_Pool;
+    VkDescriptorSet                                  m_Set = VK_NULL_HANDLE;
+    VulkanUtilities::BufferWrapper                   m_Buffer;
+    VulkanUtilities::DeviceMemoryWrapper             m_Memory;
+    VulkanUtilities::DescriptorUpdateTemplateWrapper m_UpdateTemplate;
+
+    std::vector<VkDescriptorBufferInfo> m_BufferInfos;
+    std::vector<VkWriteDescriptorSet>   m_Writes;
+};
+
+}
+
+int main()
+{
+    std::shared_ptr<VulkanUtilities::VulkanInstance>       Instance;
+    std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice;
+    std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice;
+    try
+    {
+        Instance = VulkanUtilities::VulkanInstance::Create(false, false, 0, nullptr, nullptr);
+        PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create(Instance->SelectPhysicalDevice());
+
+        VkDeviceQueueCreateInfo QueueInfo = {};
+        QueueInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        QueueInfo.queueFamilyIndex = PhysicalDevice->FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        QueueInfo.queueCount       = 1;
+        const float QueuePriority  = 1.0f;
+        QueueInfo.pQueuePriorities = &QueuePriority;
+
+        std::vector<const char*> DeviceExtensions;
+        if (PhysicalDevice->IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+            DeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+
+        VkDeviceCreateInfo DeviceCI = {};
+        DeviceCI.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        DeviceCI.queueCreateInfoCount    = 1;
+        DeviceCI.pQueueCreateInfos       = &QueueInfo;
+        DeviceCI.enabledExtensionCount   = static_cast<uint32_t>(DeviceExtensions.size());
+        DeviceCI.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
+        LogicalDevice = VulkanUtilities::VulkanLogicalDevice::Create(PhysicalDevice->GetVkDeviceHandle(), DeviceCI, nullptr, false);
+    }
+    catch (const std::exception&)
+    {
+        std::cout << "Vulkan device is not available, skipping the test\n";
+        return SKIP_RETURN_CODE;
+    }
+
+    const bool TemplatesSupported = LogicalDevice->IsDescriptorUpdateTemplateSupported();
+    if (!TemplatesSupported)
+        std::cout << VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME << " is not supported, only descriptor writes are measured\n";
+
+    std::cout << "Dynamic descriptor set update time, ns per set\n"
+              << "Descriptors     Writes     Template\n";
+    for (uint32_t NumDescriptors = 1; NumDescriptors <= 16; NumDescriptors *= 2)
+    {
+        DescriptorUpdateBenchmark Benchmark(*LogicalDevice, *PhysicalDevice, NumDescriptors);
+        auto WritesTime = Benchmark.RunWriteDescriptorSets();
+        std::cout << std::setw(11) << NumDescriptors << std::fixed << std::setprecision(1) << std::setw(11) << WritesTime;
+        if (TemplatesSupported)
+            std::cout << std::setw(13) << Benchmark.RunUpdateTemplate();
+        std::cout << '\n';
+    }
+
+    return 0;
+}
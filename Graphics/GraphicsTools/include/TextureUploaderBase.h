@@ -24,6 +24,7 @@
 #pragma once
 
 #include "TextureUploader.h"
+#include "GraphicsAccessories.h"
 #include "../../../Common/interface/ObjectBase.h"
 #include "../../../Common/interface/HashUtils.h"
 #include "../../../Common/interface/RefCntAutoPtr.h"
@@ -42,6 +43,32 @@ namespace std
 
 namespace Diligent
 {
+    /// Layout of tightly packed upload buffer data
+    struct UploadBufferLayout
+    {
+        Uint32 RowStride   = 0; ///< Size of one row of texels (or of compressed blocks) in bytes
+        Uint32 DepthStride = 0; ///< Size of one depth slice in bytes; zero for 2D textures
+        Uint32 Size        = 0; ///< Total size of the data in bytes
+    };
+
+    /// Computes the layout of tightly packed data for the upload buffer. For block-compressed
+    /// formats, rows are rows of compressed blocks.
+    inline UploadBufferLayout GetTightlyPackedUploadBufferLayout(const UploadBufferDesc &Desc, const TextureFormatAttribs &FmtAttribs)
+    {
+        Uint32 Width  = Desc.Width;
+        Uint32 Height = Desc.Height;
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+        {
+            Width  = (Width  + FmtAttribs.BlockWidth  - 1) / FmtAttribs.BlockWidth;
+            Height = (Height + FmtAttribs.BlockHeight - 1) / FmtAttribs.BlockHeight;
+        }
+        UploadBufferLayout Layout;
+        Layout.RowStride   = Width * GetTexelBlockSize(FmtAttribs);
+        Layout.DepthStride = Desc.Depth > 1 ? Height * Layout.RowStride : 0;
+        Layout.Size        = Desc.Depth * Height * Layout.RowStride;
+        return Layout;
+    }
+
     class UploadBufferBase : public ObjectBase<IUploadBuffer>
     {
     public:
@@ -25,6 +25,7 @@
 #include "TextureUploaderD3D11.h"
 #include "TextureUploaderD3D12.h"
 #include "TextureUploaderGL.h"
+#include "TextureUploaderVk.h"
 
 namespace Diligent
 {
@@ -45,6 +46,12 @@ namespace Diligent
             case DeviceType::OpenGL:
                 *ppUploader = MakeNewRCObj<TextureUploaderGL>()( pDevice, Desc );
                 break;
+
+#if VULKAN_SUPPORTED
+            case DeviceType::Vulkan:
+                *ppUploader = MakeNewRCObj<TextureUploaderVk>()( pDevice, Desc );
+                break;
+#endif
             
             default:
                 UNEXPECTED("Unexpected device type");
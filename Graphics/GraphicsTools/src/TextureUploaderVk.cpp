@@ -0,0 +1,296 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include "vulkan.h"
+
+#include "TextureUploaderVk.h"
+#include "RenderDeviceVk.h"
+#include "TextureVk.h"
+
+namespace Diligent
+{
+
+    class UploadBufferVk : public UploadBufferBase
+    {
+    public:
+        UploadBufferVk(IReferenceCounters *pRefCounters, 
+                       IRenderDeviceVk *pRenderDeviceVk,
+                       const UploadBufferDesc &Desc, 
+                       IBuffer *pStagingBuffer,
+                       void *pData, 
+                       size_t RowStride, 
+                       size_t DepthStride) :
+            UploadBufferBase(pRefCounters, Desc),
+            m_pStagingBuffer(pStagingBuffer),
+            m_pDeviceVk(pRenderDeviceVk)
+        {
+            m_pData = pData;
+            m_RowStride = RowStride;
+            m_DepthStride = DepthStride;
+        }
+
+        ~UploadBufferVk()
+        {
+            m_pStagingBuffer->Unmap(nullptr, MAP_WRITE, 0);
+            LOG_INFO_MESSAGE("Releasing staging buffer of size ", m_pStagingBuffer->GetDesc().uiSizeInBytes);
+        }
+
+        void SignalCopyScheduled(Uint64 CopyFenceValue)
+        {
+            m_CopyFenceValue = CopyFenceValue;
+            m_CopyScheduledSignal.Trigger();
+        }
+
+        void Reset()
+        {
+            m_CopyScheduledSignal.Reset();
+        }
+
+        virtual void WaitForCopyScheduled()override final
+        {
+            m_CopyScheduledSignal.Wait();
+        }
+
+        IBuffer* GetStagingBuffer() { return m_pStagingBuffer; }
+
+        // Fence value that will be signaled when the GPU finishes copying from the staging buffer
+        Uint64 GetCopyFenceValue()const { return m_CopyFenceValue; }
+
+        bool DbgIsCopyScheduled()const { return m_CopyScheduledSignal.IsTriggered(); }
+    private:
+
+        ThreadingTools::Signal m_CopyScheduledSignal;
+        Uint64 m_CopyFenceValue = 0;
+
+        RefCntAutoPtr<IBuffer> m_pStagingBuffer;
+        RefCntAutoPtr<IRenderDeviceVk> m_pDeviceVk;
+    };
+
+    struct TextureUploaderVk::InternalData
+    {
+        InternalData(IRenderDevice *pDevice) :
+            m_pDeviceVk(pDevice, IID_RenderDeviceVk)
+        {
+        }
+
+        RefCntAutoPtr<IRenderDeviceVk> m_pDeviceVk;
+
+        void SwapMapQueues()
+        {
+            std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
+            m_PendingOperations.swap(m_InWorkOperations);
+        }
+
+        void EnqueCopy(UploadBufferVk *pUploadBuffer, ITextureVk *pDstTex, Uint32 dstSlice, Uint32 dstMip)
+        {
+            std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
+            m_PendingOperations.emplace_back(PendingBufferOperation::Operation::Copy, pUploadBuffer, pDstTex, dstSlice, dstMip);
+        }
+
+        std::mutex m_PendingOperationsMtx;
+        struct PendingBufferOperation
+        {
+            enum Operation
+            {
+                Copy
+            }operation;
+            RefCntAutoPtr<UploadBufferVk> pUploadBuffer;
+            RefCntAutoPtr<ITextureVk> pDstTexture;
+            Uint32 DstSlice = 0;
+            Uint32 DstMip = 0;
+
+            PendingBufferOperation(Operation op, UploadBufferVk* pBuff) :
+                operation(op),
+                pUploadBuffer(pBuff)
+            {}
+            PendingBufferOperation(Operation op, UploadBufferVk* pBuff, ITextureVk *pDstTex, Uint32 dstSlice, Uint32 dstMip) :
+                operation(op),
+                pUploadBuffer(pBuff),
+                pDstTexture(pDstTex),
+                DstSlice(dstSlice),
+                DstMip(dstMip)
+            {}
+        };
+        std::vector< PendingBufferOperation > m_PendingOperations;
+        std::vector< PendingBufferOperation > m_InWorkOperations;
+
+        std::mutex m_UploadBuffCacheMtx;
+        std::unordered_map< UploadBufferDesc, std::deque< RefCntAutoPtr<UploadBufferVk> > > m_UploadBufferCache;
+    };
+
+    TextureUploaderVk::TextureUploaderVk(IReferenceCounters *pRefCounters, IRenderDevice *pDevice, const TextureUploaderDesc Desc) :
+        TextureUploaderBase(pRefCounters, pDevice, Desc),
+        m_pInternalData(new InternalData(pDevice))
+    {
+    }
+
+    TextureUploaderVk::~TextureUploaderVk()
+    {
+        for (auto BuffQueueIt : m_pInternalData->m_UploadBufferCache)
+        {
+            if (BuffQueueIt.second.size())
+            {
+                const auto &desc = BuffQueueIt.first;
+                auto &FmtInfo = m_pDevice->GetTextureFormatInfo(desc.Format);
+                LOG_INFO_MESSAGE("TextureUploaderVk: releasing ", BuffQueueIt.second.size(), ' ', desc.Width, 'x', desc.Height, 'x', desc.Depth, ' ', FmtInfo.Name, " upload buffer(s) ");
+            }
+        }
+    }
+
+    void TextureUploaderVk::RenderThreadUpdate(IDeviceContext *pContext)
+    {
+        m_pInternalData->SwapMapQueues();
+        if (!m_pInternalData->m_InWorkOperations.empty())
+        {
+            // All copy commands are recorded into the context's command buffer first
+            for (auto &OperationInfo : m_pInternalData->m_InWorkOperations)
+            {
+                auto &pBuffer = OperationInfo.pUploadBuffer;
+
+                switch (OperationInfo.operation)
+                {
+                    case InternalData::PendingBufferOperation::Copy:
+                    {
+                        TextureSubResData SubResData(pBuffer->GetStagingBuffer(), static_cast<Uint32>(pBuffer->GetRowStride()), static_cast<Uint32>(pBuffer->GetDepthStride()));
+                        const auto &BuffDesc = pBuffer->GetDesc();
+                        Box DstBox;
+                        DstBox.MaxX = BuffDesc.Width;
+                        DstBox.MaxY = BuffDesc.Height;
+                        DstBox.MaxZ = BuffDesc.Depth;
+                        OperationInfo.pDstTexture->UpdateData(pContext, OperationInfo.DstMip, OperationInfo.DstSlice, DstBox, SubResData);
+                    }
+                    break;
+                }
+            }
+
+            // The batch is then submitted at once. Other threads may submit command buffers 
+            // concurrently, so the fence value for the batch is only known after the submission: 
+            // all command buffers submitted so far are signaled by the last used fence value
+            pContext->Flush();
+            auto CopyFenceValue = m_pInternalData->m_pDeviceVk->GetNextFenceValue() - 1;
+            for (auto &OperationInfo : m_pInternalData->m_InWorkOperations)
+            {
+                OperationInfo.pUploadBuffer->SignalCopyScheduled(CopyFenceValue);
+            }
+
+            m_pInternalData->m_InWorkOperations.clear();
+        }
+    }
+
+    void TextureUploaderVk::AllocateUploadBuffer(const UploadBufferDesc& Desc, bool IsRenderThread, IUploadBuffer **ppBuffer)
+    {
+        *ppBuffer = nullptr;
+
+        {
+            std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
+            auto &Cache = m_pInternalData->m_UploadBufferCache;
+            if (!Cache.empty())
+            {
+                auto DequeIt = Cache.find(Desc);
+                if (DequeIt != Cache.end())
+                {
+                    auto &Deque = DequeIt->second;
+                    // Buffers are normally recycled in the order their copies were submitted,
+                    // so only the oldest one is checked
+                    if (!Deque.empty())
+                    {
+                        auto &FrontBuff = Deque.front();
+                        if (m_pInternalData->m_pDeviceVk->IsFenceSignaled(FrontBuff->GetCopyFenceValue()))
+                        {
+                            *ppBuffer = FrontBuff.Detach();
+                            Deque.pop_front();
+                        }
+                    }
+                }
+            }
+        }
+
+        // No available buffer found in the cache
+        if(*ppBuffer == nullptr)
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name = "Staging buffer for UploadBufferVk";
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+            BuffDesc.Usage = USAGE_CPU_ACCESSIBLE;
+
+            // Rows are tightly packed: Vulkan only requires the row length to be a whole 
+            // number of texels (or compressed blocks)
+            const auto &TexFmtInfo = m_pDevice->GetTextureFormatInfo(Desc.Format);
+            auto Layout = GetTightlyPackedUploadBufferLayout(Desc, TexFmtInfo);
+            Uint32 RowStride = Layout.RowStride;
+            Uint32 DepthStride = Layout.DepthStride;
+
+            BuffDesc.uiSizeInBytes = Layout.Size;
+            RefCntAutoPtr<IBuffer> pStagingBuffer;
+            m_pDevice->CreateBuffer(BuffDesc, BufferData(), &pStagingBuffer);
+            if (!pStagingBuffer)
+            {
+                LOG_ERROR_MESSAGE("Failed to create staging buffer");
+                return;
+            }
+
+            // The buffer stays mapped until it is released, so that it can be filled by 
+            // any thread every time it is reused
+            PVoid CpuVirtualAddress = nullptr;
+            pStagingBuffer->Map(nullptr, MAP_WRITE, 0, CpuVirtualAddress);
+            if (CpuVirtualAddress == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Failed to map upload buffer");
+                return;
+            }
+
+            LOG_INFO_MESSAGE("Created staging buffer of size ", BuffDesc.uiSizeInBytes);
+
+            RefCntAutoPtr<UploadBufferVk> pUploadBuffer(MakeNewRCObj<UploadBufferVk>()(m_pInternalData->m_pDeviceVk, Desc, pStagingBuffer, CpuVirtualAddress, RowStride, DepthStride));
+            *ppBuffer = pUploadBuffer.Detach();
+        }
+    }
+
+    void TextureUploaderVk::ScheduleGPUCopy(ITexture *pDstTexture,
+        Uint32 ArraySlice,
+        Uint32 MipLevel,
+        IUploadBuffer *pUploadBuffer)
+    {
+        auto *pUploadBufferVk = ValidatedCast<UploadBufferVk>(pUploadBuffer);
+        RefCntAutoPtr<ITextureVk> pDstTexVk(pDstTexture, IID_TextureVk);
+        m_pInternalData->EnqueCopy(pUploadBufferVk, pDstTexVk, ArraySlice, MipLevel);
+    }
+
+    void TextureUploaderVk::RecycleBuffer(IUploadBuffer *pUploadBuffer)
+    {
+        auto *pUploadBufferVk = ValidatedCast<UploadBufferVk>(pUploadBuffer);
+        VERIFY(pUploadBufferVk->DbgIsCopyScheduled(), "Upload buffer must be recycled only after copy operation has been scheduled on the GPU");
+        pUploadBufferVk->Reset();
+
+        std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
+        auto &Cache = m_pInternalData->m_UploadBufferCache;
+        auto &Deque = Cache[pUploadBufferVk->GetDesc()];
+        Deque.emplace_back( pUploadBufferVk );
+    }
+}
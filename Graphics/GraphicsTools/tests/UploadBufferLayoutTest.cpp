@@ -0,0 +1,89 @@
+/*     Copyright 2015-2018 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT OF ANY PROPRIETARY RIGHTS.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Verifies the layout of upload buffers used by the texture uploaders for regular and
+// block-compressed formats. The test does not require a graphics device.
+
+#include <iostream>
+#include "TextureUploaderBase.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+int NumFailures = 0;
+
+void CheckLayout(TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height, Uint32 Depth, 
+                 Uint32 RefRowStride, Uint32 RefDepthStride, Uint32 RefSize)
+{
+    UploadBufferDesc Desc;
+    Desc.Width  = Width;
+    Desc.Height = Height;
+    Desc.Depth  = Depth;
+    Desc.Format = Format;
+    const auto &FmtAttribs = GetTextureFormatAttribs(Format);
+    auto Layout = GetTightlyPackedUploadBufferLayout(Desc, FmtAttribs);
+    if (Layout.RowStride != RefRowStride || Layout.DepthStride != RefDepthStride || Layout.Size != RefSize)
+    {
+        std::cerr << FmtAttribs.Name << ' ' << Width << 'x' << Height << 'x' << Depth << ": "
+                  << "row stride " << Layout.RowStride << " (expected " << RefRowStride << "), "
+                  << "depth stride " << Layout.DepthStride << " (expected " << RefDepthStride << "), "
+                  << "size " << Layout.Size << " (expected " << RefSize << ")\n";
+        ++NumFailures;
+    }
+
+    // Vulkan reads buffer rows as bufferRowLength texels, see DeviceContextVkImpl::CopyTextureRegion()
+    Uint32 BlockWidth = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? FmtAttribs.BlockWidth : 1;
+    Uint32 BufferRowLength = Layout.RowStride / GetTexelBlockSize(FmtAttribs) * BlockWidth;
+    Uint32 RefRowLength = (Width + BlockWidth - 1) / BlockWidth * BlockWidth;
+    if (BufferRowLength != RefRowLength)
+    {
+        std::cerr << FmtAttribs.Name << ' ' << Width << 'x' << Height << ": buffer row length " << BufferRowLength
+                  << " (expected " << RefRowLength << ")\n";
+        ++NumFailures;
+    }
+}
+
+}
+
+int main()
+{
+    // BC1: 4x4 blocks of 8 bytes
+    CheckLayout(TEX_FORMAT_BC1_UNORM, 256, 128, 1, 64 * 8,  0, 32 * 64 * 8);
+    CheckLayout(TEX_FORMAT_BC1_UNORM,  10,   6, 1,  3 * 8,  0,  2 *  3 * 8);
+    // BC3: 4x4 blocks of 16 bytes
+    CheckLayout(TEX_FORMAT_BC3_UNORM, 256, 128, 1, 64 * 16, 0, 32 * 64 * 16);
+    CheckLayout(TEX_FORMAT_BC3_UNORM,   1,   1, 1,      16, 0,           16);
+    // Uncompressed formats
+    CheckLayout(TEX_FORMAT_RGBA8_UNORM, 100, 50, 1, 400,      0, 50 * 400);
+    CheckLayout(TEX_FORMAT_RGBA8_UNORM,  16, 16, 4,  64, 16 * 64, 4 * 16 * 64);
+
+    if (NumFailures != 0)
+    {
+        std::cerr << NumFailures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All upload buffer layout checks passed\n";
+    return 0;
+}
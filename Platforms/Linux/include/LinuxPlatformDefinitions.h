@@ -28,3 +28,7 @@
 template <typename _CountofType, std::size_t _SizeOfArray>
 char (*__countof_helper(_CountofType (&_Array)[_SizeOfArray]))[_SizeOfArray];
 #define _countof(_Array) (sizeof(*__countof_helper(_Array)) + 0)
+
+#ifndef __forceinline
+#   define __forceinline inline __attribute__((always_inline))
+#endif